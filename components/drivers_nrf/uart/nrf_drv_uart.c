@@ -93,6 +93,7 @@ typedef struct
     uint8_t                  rx_secondary_buffer_length;
     volatile uint8_t         rx_counter;
     bool                     rx_enabled;
+    bool                     rx_stopping;
     nrf_drv_state_t          state;
 #if (defined(UARTE_IN_USE) && defined(UART_IN_USE))
     bool                     use_easy_dma;
@@ -299,6 +300,7 @@ ret_code_t nrf_drv_uart_init(const nrf_drv_uart_t * p_instance, nrf_drv_uart_con
     p_cb->tx_buffer_length = 0;
     p_cb->state = NRF_DRV_STATE_INITIALIZED;
     p_cb->rx_enabled = false;
+    p_cb->rx_stopping = false;
     return err_code;
 }
 
@@ -547,16 +549,24 @@ __STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uart(const nrf_drv_uart_t * p_ins
 __STATIC_INLINE ret_code_t nrf_drv_uart_rx_for_uarte(const nrf_drv_uart_t * p_instance, uint8_t * p_data, uint8_t length, bool second_buffer)
 {
     ret_code_t err_code = NRF_SUCCESS;
-    nrf_uarte_event_clear(p_instance->reg.p_uarte, NRF_UARTE_EVENT_ENDRX);
-    nrf_uarte_event_clear(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXTO);
     nrf_uarte_rx_buffer_set(p_instance->reg.p_uarte, p_data, length);
     if (!second_buffer)
     {
+        nrf_uarte_event_clear(p_instance->reg.p_uarte, NRF_UARTE_EVENT_ENDRX);
+        nrf_uarte_event_clear(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXTO);
         nrf_uarte_task_trigger(p_instance->reg.p_uarte, NRF_UARTE_TASK_STARTRX);
     }
     else
     {
+        // The current transfer may already have ended, e.g. a short one. Its ENDRX event must
+        // be kept, and if the short came too late, the second buffer is started here.
+        nrf_uarte_event_clear(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXSTARTED);
         nrf_uarte_shorts_enable(p_instance->reg.p_uarte, NRF_UARTE_SHORT_ENDRX_STARTRX);
+        if (nrf_uarte_event_check(p_instance->reg.p_uarte, NRF_UARTE_EVENT_ENDRX) &&
+            !nrf_uarte_event_check(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXSTARTED))
+        {
+            nrf_uarte_task_trigger(p_instance->reg.p_uarte, NRF_UARTE_TASK_STARTRX);
+        }
     }
 
     if (m_cb[p_instance->drv_inst_idx].handler == NULL)
@@ -784,6 +794,58 @@ void nrf_drv_uart_tx_abort(const nrf_drv_uart_t * p_instance)
     NRF_LOG_INFO("TX abort Id:%d", nrf_drv_get_IRQn((void *)p_instance->reg.p_reg));
 }
 
+ret_code_t nrf_drv_uart_rx_stop(nrf_drv_uart_t const * p_instance)
+{
+    uart_control_block_t * p_cb = &m_cb[p_instance->drv_inst_idx];
+
+    CODE_FOR_UARTE
+    (
+        // If the current buffer is filled before the short is disabled, the next buffer is
+        // started by the short and the RXSTARTED event is set again.
+        nrf_uarte_event_clear(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXSTARTED);
+        bool filled = nrf_uarte_event_check(p_instance->reg.p_uarte, NRF_UARTE_EVENT_ENDRX);
+        nrf_uarte_shorts_disable(p_instance->reg.p_uarte, NRF_UARTE_SHORT_ENDRX_STARTRX);
+        if (filled || nrf_uarte_event_check(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXSTARTED))
+        {
+            return NRF_ERROR_BUSY;
+        }
+
+        // The current buffer may still be filled before the receiver stops. Its ENDRX event
+        // is then followed by RXTO, and the buffer is reported once, on RXTO.
+        p_cb->rx_secondary_buffer_length = 0;
+        p_cb->rx_stopping                = true;
+        nrf_uarte_task_trigger(p_instance->reg.p_uarte, NRF_UARTE_TASK_STOPRX);
+    )
+    CODE_FOR_UART
+    (
+        p_cb->rx_secondary_buffer_length = 0;
+        nrf_uart_int_disable(p_instance->reg.p_uart, NRF_UART_INT_MASK_RXDRDY | NRF_UART_INT_MASK_ERROR);
+        nrf_uart_task_trigger(p_instance->reg.p_uart, NRF_UART_TASK_STOPRX);
+    )
+    NRF_LOG_INFO("RX stop Id:%d", nrf_drv_get_IRQn((void *)p_instance->reg.p_reg));
+    return NRF_SUCCESS;
+}
+
+bool nrf_drv_uart_rx_activity_check(nrf_drv_uart_t const * p_instance)
+{
+    bool activity = false;
+
+    // In UART mode the RXDRDY event is used by the driver to read each byte.
+    CODE_FOR_UARTE
+    (
+        activity = nrf_uarte_event_check(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXDRDY);
+        if (activity)
+        {
+            nrf_uarte_event_clear(p_instance->reg.p_uarte, NRF_UARTE_EVENT_RXDRDY);
+        }
+    )
+    CODE_FOR_UART
+    (
+        ASSERT(false);
+    )
+    return activity;
+}
+
 void nrf_drv_uart_rx_abort(const nrf_drv_uart_t * p_instance)
 {
     CODE_FOR_UARTE
@@ -905,6 +967,7 @@ __STATIC_INLINE void uarte_irq_handler(NRF_UARTE_Type * p_uarte, uart_control_bl
         //abort transfer
         p_cb->rx_buffer_length = 0;
         p_cb->rx_secondary_buffer_length = 0;
+        p_cb->rx_stopping = false;
 
         p_cb->handler(&event, p_cb->p_context);
     }
@@ -914,7 +977,8 @@ __STATIC_INLINE void uarte_irq_handler(NRF_UARTE_Type * p_uarte, uart_control_bl
         uint8_t amount = nrf_uarte_rx_amount_get(p_uarte);
         // If the transfer was stopped before completion, amount of transfered bytes
         // will not be equal to the buffer length. Interrupted trunsfer is ignored.
-        if (amount == p_cb->rx_buffer_length)
+        // While reception is being stopped, the buffer is reported on RXTO.
+        if ((amount == p_cb->rx_buffer_length) && !p_cb->rx_stopping)
         {
             if (p_cb->rx_secondary_buffer_length)
             {
@@ -936,6 +1000,7 @@ __STATIC_INLINE void uarte_irq_handler(NRF_UARTE_Type * p_uarte, uart_control_bl
     if (nrf_uarte_event_check(p_uarte, NRF_UARTE_EVENT_RXTO))
     {
         nrf_uarte_event_clear(p_uarte, NRF_UARTE_EVENT_RXTO);
+        p_cb->rx_stopping = false;
         if (p_cb->rx_buffer_length)
         {
             p_cb->rx_buffer_length = 0;
@@ -423,6 +423,36 @@ void nrf_drv_uart_rx_disable(nrf_drv_uart_t const * p_instance);
  */
 void nrf_drv_uart_rx_abort(nrf_drv_uart_t const * p_instance);
 
+/**
+ * @brief Function for ending the ongoing reception without starting the next buffer.
+ *
+ * Unlike @ref nrf_drv_uart_rx_abort, the buffer provided for the next transfer is released and
+ * reception does not continue in it. @ref NRF_DRV_UART_EVT_RX_DONE is generated for the current
+ * buffer with the number of bytes received, after the receiver has stopped. New buffers can be
+ * provided once the event has been received. The function must not be interrupted by the UART
+ * interrupt.
+ *
+ * @param[in] p_instance Pointer to the driver instance structure.
+ *
+ * @retval NRF_SUCCESS    If reception is being stopped.
+ * @retval NRF_ERROR_BUSY If the current buffer has just been filled and reception continues in the
+ *                        next buffer. The event for the filled buffer is pending.
+ */
+ret_code_t nrf_drv_uart_rx_stop(nrf_drv_uart_t const * p_instance);
+
+/**
+ * @brief Function for checking if any byte has been received since the previous check.
+ *
+ * The feature is supported only in Easy DMA mode, where it can be used to detect an idle line
+ * while a transfer is in progress. The function asserts if mode is wrong.
+ *
+ * @param[in] p_instance Pointer to the driver instance structure.
+ *
+ * @retval true  If at least one byte has been received.
+ * @retval false If the line has been idle.
+ */
+bool nrf_drv_uart_rx_activity_check(nrf_drv_uart_t const * p_instance);
+
 /**
  * @brief Function for reading error source mask. Mask contains values from @ref nrf_uart_error_mask_t.
  * @note Function should be used in blocking mode only. In case of non-blocking mode, an error event is
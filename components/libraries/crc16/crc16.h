@@ -56,6 +56,20 @@
 extern "C" {
 #endif
 
+/**@defgroup CRC16_METHODS CRC-16 computation methods, selected with CRC16_CONFIG_METHOD.
+ * @{ */
+#define CRC16_METHOD_SHIFT   0  /**< Shift and XOR formula, no table. */
+#define CRC16_METHOD_NIBBLE  1  /**< 4-bit table, 32 bytes. */
+#define CRC16_METHOD_BYTE    2  /**< 8-bit table, 512 bytes. */
+/** @} */
+
+/**@brief Data chunk for @ref crc16_compute_chunks. */
+typedef struct
+{
+    void const * p_data;    /**< Chunk data. */
+    uint32_t     size;      /**< Chunk size in bytes. */
+} crc16_chunk_t;
+
 /**@brief Function for calculating CRC-16 in blocks.
  *
  * Feed each consecutive data block into this function, along with the current value of p_crc as
@@ -70,6 +84,19 @@ extern "C" {
  */
 uint16_t crc16_compute(uint8_t const * p_data, uint32_t size, uint16_t const * p_crc);
 
+/**@brief Function for calculating CRC-16 over several data chunks in one pass.
+ *
+ * The result is the same as feeding the chunks, in order, into @ref crc16_compute. The chunks do
+ * not have to be gathered into one buffer first.
+ *
+ * @param[in] p_chunks The data chunks for computation.
+ * @param[in] count    The number of chunks.
+ * @param[in] p_crc    The previous calculated CRC-16 value or NULL if first call.
+ *
+ * @return The updated CRC-16 value, based on the input supplied.
+ */
+uint16_t crc16_compute_chunks(crc16_chunk_t const * p_chunks, uint32_t count, uint16_t const * p_crc);
+
 
 #ifdef __cplusplus
 }
@@ -55,12 +55,24 @@
 extern "C" {
 #endif
 
+/**@defgroup CRC32_METHODS CRC-32 computation methods, selected with CRC32_CONFIG_METHOD.
+ * @{ */
+#define CRC32_METHOD_BITWISE        0   /**< Bit-serial loop, no table. */
+#define CRC32_METHOD_NIBBLE         1   /**< 4-bit table, 64 bytes. */
+#define CRC32_METHOD_BYTE           2   /**< 8-bit table, 1 kB. */
+#define CRC32_METHOD_SLICING_BY_4   3   /**< Four 8-bit tables, 4 kB. Processes one word per step. */
+#define CRC32_METHOD_SLICING_BY_8   4   /**< Eight 8-bit tables, 8 kB. Processes two words per step. */
+/** @} */
+
 /**@brief Function for calculating CRC-32 in blocks.
  *
  * Feed each consecutive data block into this function, along with the current value of p_crc as
  * returned by the previous call of this function. The first call of this function should pass NULL
  * as the initial value of the crc in p_crc.
  *
+ * The table based methods process whole words once the data pointer is word aligned, so the
+ * result does not depend on how the data is split into blocks.
+ *
  * @param[in] p_data The input data block for computation.
  * @param[in] size   The size of the input data block in bytes.
  * @param[in] p_crc  The previous calculated CRC-32 value or NULL if first call.
@@ -69,9 +69,10 @@ NRF_SECTION_DEF(cli_command, nrf_cli_cmd_entry_t);
 #define CLI_DATA_SECTION_ITEM_GET(i) NRF_SECTION_ITEM_GET(cli_command, nrf_cli_cmd_entry_t, (i))
 #define CLI_DATA_SECTION_ITEM_COUNT  NRF_SECTION_ITEM_COUNT(cli_command, nrf_cli_cmd_entry_t)
 
-NRF_SECTION_DEF(cli_sorted_cmd_ptrs, const char *);
+NRF_SECTION_DEF(cli_sorted_cmd_ptrs, nrf_cli_cmd_entry_t const *);
 /*lint -restore*/
-#define CLI_SORTED_CMD_PTRS_ITEM_GET(i) NRF_SECTION_ITEM_GET(cli_sorted_cmd_ptrs, const char *, (i))
+#define CLI_SORTED_CMD_PTRS_ITEM_GET(i) \
+    (*NRF_SECTION_ITEM_GET(cli_sorted_cmd_ptrs, nrf_cli_cmd_entry_t const *, (i)))
 #define CLI_SORTED_CMD_PTRS_START_ADDR_GET NRF_SECTION_START_ADDR(cli_sorted_cmd_ptrs)
 
 #if defined(NRF_CLI_LOG_BACKEND) && NRF_CLI_LOG_BACKEND
@@ -115,7 +116,8 @@ static char const m_nrf_cli_uknown_parameter[] = " unknown parameter: ";
 static char const m_nrf_cli_command_not_found[] = ": command not found";
 
 static bool cli_log_entry_process(nrf_cli_t const * p_cli, bool skip);
-static void cli_state_execute(nrf_cli_t const * p_cli);
+static ret_code_t cli_state_execute(nrf_cli_t const * p_cli);
+static bool cli_cmd_vt100_only(nrf_cli_static_entry_t const * p_st_cmd);
 
 static inline size_t cli_strlen(char const * str)
 {
@@ -136,13 +138,22 @@ static inline bool full_line_cmd(nrf_cli_t const * p_cli)
             p_cli->p_ctx->vt100_ctx.cons.terminal_wid == 0);
 }
 
-/* function sends data stream to cli instance. Each time before this function is call fprintf
- * IO buffer needs to be flushed to avoid synchronization issues. For that purpose macro:
- * NRF_CLI_IO_BUFFER_FLUSH shall be used */
-static void cli_write(nrf_cli_t const * p_cli,
-                      void const *      p_data,
-                      size_t            length,
-                      size_t *          p_cnt)
+/* function returns true if cli instance is in binary RPC mode */
+static inline bool cli_rpc_active(nrf_cli_t const * p_cli)
+{
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+    return (p_cli->p_ctx->state == NRF_CLI_STATE_RPC);
+#else
+    UNUSED_PARAMETER(p_cli);
+    return false;
+#endif
+}
+
+/* function sends data stream to transport of cli instance */
+static void cli_transport_write(nrf_cli_t const * p_cli,
+                                void const *      p_data,
+                                size_t            length,
+                                size_t *          p_cnt)
 {
     ASSERT(p_cli && p_data);
     ASSERT(p_cli->p_iface->p_api);
@@ -179,6 +190,92 @@ static void cli_write(nrf_cli_t const * p_cli,
     }
 }
 
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+static void rpc_frame_send(nrf_cli_t const * p_cli,
+                           uint8_t           type,
+                           uint8_t           seq,
+                           void const *      p_payload,
+                           uint16_t          len)
+{
+    uint8_t hdr[NRF_CLI_RPC_HDR_SIZE] = {NRF_CLI_RPC_SYNC, type, seq,
+                                         (uint8_t)len, (uint8_t)(len >> 8)};
+
+    cli_transport_write(p_cli, hdr, sizeof(hdr), NULL);
+    if (len > 0)
+    {
+        cli_transport_write(p_cli, p_payload, len, NULL);
+    }
+}
+
+static void rpc_done_send(nrf_cli_t const * p_cli, uint8_t seq, ret_code_t status)
+{
+    uint8_t payload[sizeof(uint32_t)];
+
+    uint32_encode(status, payload);
+    rpc_frame_send(p_cli, NRF_CLI_RPC_RSP_DONE, seq, payload, sizeof(payload));
+}
+
+/* function sends output collected in rpc_out_buff in a single frame */
+static void rpc_output_flush(nrf_cli_t const * p_cli)
+{
+    nrf_cli_ctx_t * p_ctx = p_cli->p_ctx;
+
+    if (p_ctx->rpc_out_cnt > 0)
+    {
+        rpc_frame_send(p_cli, p_ctx->rpc_out_type, p_ctx->rpc_out_seq,
+                       p_ctx->rpc_out_buff, p_ctx->rpc_out_cnt);
+        p_ctx->rpc_out_cnt = 0;
+    }
+}
+
+/* function collects output in rpc_out_buff, as commands may use temp_buff while printing */
+static void rpc_output_add(nrf_cli_t const * p_cli, void const * p_data, size_t length)
+{
+    nrf_cli_ctx_t * p_ctx = p_cli->p_ctx;
+    char const *    p_src = (char const *)p_data;
+
+    while (length > 0)
+    {
+        size_t chunk = sizeof(p_ctx->rpc_out_buff) - p_ctx->rpc_out_cnt;
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+        memcpy(&p_ctx->rpc_out_buff[p_ctx->rpc_out_cnt], p_src, chunk);
+        p_ctx->rpc_out_cnt += chunk;
+        p_src  += chunk;
+        length -= chunk;
+
+        if (p_ctx->rpc_out_cnt == sizeof(p_ctx->rpc_out_buff))
+        {
+            rpc_output_flush(p_cli);
+        }
+    }
+}
+#endif // NRF_MODULE_ENABLED(NRF_CLI_RPC)
+
+/* function sends data stream to cli instance. Each time before this function is call fprintf
+ * IO buffer needs to be flushed to avoid synchronization issues. For that purpose macro:
+ * NRF_CLI_IO_BUFFER_FLUSH shall be used */
+static void cli_write(nrf_cli_t const * p_cli,
+                      void const *      p_data,
+                      size_t            length,
+                      size_t *          p_cnt)
+{
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+    if (cli_rpc_active(p_cli))
+    {
+        rpc_output_add(p_cli, p_data, length);
+        if (p_cnt)
+        {
+            *p_cnt = length;
+        }
+        return;
+    }
+#endif
+    cli_transport_write(p_cli, p_data, length, p_cnt);
+}
+
 /* function sends 1 char to cli instance */
 static inline void cli_putc(nrf_cli_t const * p_cli, char ch)
 {
@@ -219,19 +316,12 @@ static void cmd_get(nrf_cli_cmd_entry_t const *     p_command,
     {
         if (idx < CLI_DATA_SECTION_ITEM_COUNT)
         {
-            nrf_cli_cmd_entry_t const * p_cmd = NULL;
-            char const * * pp_sorted_cmds = (char const * *)CLI_SORTED_CMD_PTRS_START_ADDR_GET;
-            for (size_t i = 0; i < CLI_DATA_SECTION_ITEM_COUNT; i++)
-            {
-                p_cmd = CLI_DATA_SECTION_ITEM_GET(i);
-                if (!strcmp(pp_sorted_cmds[idx], p_cmd->u.p_static->p_syntax))
-                {
-                    *pp_entry = p_cmd->u.p_static;
-                    return;
-                }
-            }
+            *pp_entry = CLI_SORTED_CMD_PTRS_ITEM_GET(idx)->u.p_static;
+        }
+        else
+        {
+            *pp_entry = NULL;
         }
-        *pp_entry = NULL;
         return;
     }
 
@@ -266,6 +356,173 @@ static void cmd_get(nrf_cli_cmd_entry_t const *     p_command,
     }
 }
 
+#if NRF_ASSERT_PRESENT
+/* Function cmd_static_order_check asserts that a static subcommand set is sorted, as binary search
+ * requires (@ref NRF_CLI_CREATE_STATIC_SUBCMD_SET). The last checked set is remembered, so commands
+ * and completions walking the same set again do not repeat the check.
+ *  p_command   - pointer to command with static subcommands
+ *  cnt         - number of subcommands
+ */
+static void cmd_static_order_check(nrf_cli_cmd_entry_t const * p_command, size_t cnt)
+{
+    static nrf_cli_cmd_entry_t const * p_checked = NULL;
+
+    if (p_command == p_checked)
+    {
+        return;
+    }
+
+    for (size_t i = 1; i < cnt; i++)
+    {
+        ASSERT(strcmp(p_command->u.p_static[i - 1].p_syntax,
+                      p_command->u.p_static[i].p_syntax) < 0);
+    }
+    p_checked = p_command;
+}
+#endif
+
+/* Function cmd_cnt_get returns number of commands on given level. Number of dynamic commands is
+ * cached in CLI context until next command is executed.
+ *  p_command   - pointer to command which will be processed (no matter for root command)
+ *  lvl         - level of requested commands
+ */
+static size_t cmd_cnt_get(nrf_cli_t const *           p_cli,
+                          nrf_cli_cmd_entry_t const * p_command,
+                          size_t                      lvl)
+{
+    size_t cnt = 0;
+
+    if (lvl == NRF_CLI_CMD_ROOT_LVL)
+    {
+        return CLI_DATA_SECTION_ITEM_COUNT;
+    }
+
+    if (p_command == NULL)
+    {
+        return 0;
+    }
+
+    if (!p_command->is_dynamic)
+    {
+        while (p_command->u.p_static[cnt].p_syntax != NULL)
+        {
+            cnt++;
+        }
+#if NRF_ASSERT_PRESENT
+        cmd_static_order_check(p_command, cnt);
+#endif
+        return cnt;
+    }
+
+    nrf_cli_dynamic_cnt_t * p_cache = NULL;
+    if (lvl <= NRF_CLI_DYNAMIC_CMD_CACHE_LVLS)
+    {
+        p_cache = &p_cli->p_ctx->dynamic_cnt[lvl - 1];
+        if (p_cache->p_cmd == p_command)
+        {
+            return p_cache->cnt;
+        }
+    }
+
+    nrf_cli_static_entry_t static_entry;
+    while (1)
+    {
+        p_command->u.p_dynamic_get(cnt, &static_entry);
+        if (static_entry.p_syntax == NULL)
+        {
+            break;
+        }
+        cnt++;
+    }
+
+    if (p_cache != NULL)
+    {
+        p_cache->p_cmd = p_command;
+        p_cache->cnt   = cnt;
+    }
+    return cnt;
+}
+
+/* Function cmd_lower_bound returns index of the first command which first len characters are not
+ * smaller than p_str. Commands are sorted alphabetically so binary search is used.
+ *  p_command   - pointer to command which will be processed (no matter for root command)
+ *  lvl         - level of requested command
+ *  cnt         - number of commands on the level (@ref cmd_cnt_get)
+ *  p_str, len  - searched string and number of compared characters
+ *  p_st_entry  - pointer to structure where dynamic entry data can be stored
+ */
+static size_t cmd_lower_bound(nrf_cli_cmd_entry_t const * p_command,
+                              size_t                      lvl,
+                              size_t                      cnt,
+                              char const *                p_str,
+                              size_t                      len,
+                              nrf_cli_static_entry_t *    p_st_entry)
+{
+    size_t low  = 0;
+    size_t high = cnt;
+
+    if (len == 0)
+    {
+        return 0;
+    }
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        nrf_cli_static_entry_t const * p_entry;
+
+        cmd_get(p_command, lvl, mid, &p_entry, p_st_entry);
+        /* Set of dynamic commands may be smaller than the cached count. */
+        if ((p_entry != NULL) && (strncmp(p_entry->p_syntax, p_str, len) < 0))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/* Function cmd_find searches for command with exactly matching syntax. It moves pointer pp_entry
+ * to found command or sets it to NULL if command cannot be found.
+ *  p_command   - pointer to command which will be processed (no matter for root command)
+ *  lvl         - level of requested command
+ *  p_str       - command syntax
+ *  pp_entry    - pointer which will point to found command after function execution
+ *  p_st_entry  - pointer to structure where dynamic entry data can be stored
+ *
+ *  Returns index of the found command.
+ */
+static size_t cmd_find(nrf_cli_t const *               p_cli,
+                       nrf_cli_cmd_entry_t const *     p_command,
+                       size_t                          lvl,
+                       char const *                    p_str,
+                       nrf_cli_static_entry_t const ** pp_entry,
+                       nrf_cli_static_entry_t *        p_st_entry)
+{
+    size_t cnt = cmd_cnt_get(p_cli, p_command, lvl);
+    /* Terminating '\0' is compared as well so only exact match is found. */
+    size_t idx = cmd_lower_bound(p_command, lvl, cnt, p_str, strlen(p_str) + 1, p_st_entry);
+
+    *pp_entry = NULL;
+    if (idx < cnt)
+    {
+        cmd_get(p_command, lvl, idx, pp_entry, p_st_entry);
+        if ((*pp_entry != NULL) && (strcmp((*pp_entry)->p_syntax, p_str) != 0))
+        {
+            *pp_entry = NULL;
+        }
+    }
+    return idx;
+}
+
+static void dynamic_cnt_cache_clear(nrf_cli_t const * p_cli)
+{
+    memset(p_cli->p_ctx->dynamic_cnt, 0, sizeof(p_cli->p_ctx->dynamic_cnt));
+}
+
 /* function multiline_console_data_check checks current cursor position (x, y) on terminal screen
  * basing on: command length, console name length and terminal width.
  * Example 1:
@@ -1066,6 +1323,14 @@ static char make_argv(size_t * p_argc, char ** pp_argv, char * p_cmd, uint8_t ma
 
 static void cli_state_change(nrf_cli_t const * p_cli, nrf_cli_state_t state)
 {
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+    /* output printed before the mode change must not be mixed with RPC frames */
+    NRF_CLI_IO_BUFFER_FLUSH(p_cli);
+    if (p_cli->p_ctx->state == NRF_CLI_STATE_RPC)
+    {
+        rpc_output_flush(p_cli);
+    }
+#endif
     p_cli->p_ctx->state = state;
     switch (state)
     {
@@ -1075,6 +1340,16 @@ static void cli_state_change(nrf_cli_t const * p_cli, nrf_cli_state_t state)
             p_cli->p_ctx->cmd_buff_len = 0;
             nrf_cli_fprintf(p_cli, NRF_CLI_INFO, "%s", p_cli->p_name);
             break;
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+        case NRF_CLI_STATE_RPC:
+            p_cli->p_ctx->rpc_hdr_cnt = 0;
+            p_cli->p_ctx->rpc_esc_cnt = 0;
+            p_cli->p_ctx->rpc_rx_cnt  = 0;
+            p_cli->p_ctx->rpc_out_cnt = 0;
+            /* acknowledge mode change */
+            rpc_done_send(p_cli, 0, NRF_SUCCESS);
+            break;
+#endif
         default:
             break;
     }
@@ -1489,7 +1764,13 @@ static void cli_tab_handle(nrf_cli_t const * p_cli)
                 arg_len = cli_strlen(argv[cmd_lvl]);
             }
 
-            cmd_idx = 0;
+            /* commands are sorted alphabetically, start from the first possible match */
+            cmd_idx = cmd_lower_bound(p_cmd,
+                                      cmd_lvl,
+                                      cmd_cnt_get(p_cli, p_cmd, cmd_lvl),
+                                      argv[cmd_lvl],
+                                      arg_len,
+                                      &static_entry);
 
             while (1)
             {
@@ -1502,11 +1783,7 @@ static void cli_tab_handle(nrf_cli_t const * p_cli)
 
                 if (strncmp(argv[cmd_lvl], p_st_cmd->p_syntax, arg_len) != 0)
                 {
-                    if (p_st_cmd_last != NULL)
-                    { /* no more match will be found as commands are sorted alphabetically */
-                        break;
-                    }
-                    continue;
+                    break; /* no more match will be found */
                 }
                 if (p_st_cmd_last == NULL)
                 {
@@ -1551,28 +1828,14 @@ static void cli_tab_handle(nrf_cli_t const * p_cli)
         }
         else
         {
-            cmd_idx = 0;
+            /* exact match is requested */
+            (void)cmd_find(p_cli, p_cmd, cmd_lvl, argv[cmd_lvl], &p_st_cmd, &static_entry);
 
-            while (1)
+            if (p_st_cmd == NULL)
             {
-                cmd_get(p_cmd, cmd_lvl, cmd_idx++, &p_st_cmd, &static_entry);
-
-                if (cmd_idx == 0)
-                {
-                    return; /* no match found, no more commands available */
-                }
-
-                if (p_st_cmd == NULL)
-                {
-                    return; /* no more commands available */
-                }
-                /* strcmp used because exact match is requested */
-                if (strcmp(argv[cmd_lvl], p_st_cmd->p_syntax) == 0)
-                {
-                    p_cmd = p_st_cmd->p_subcmd;
-                    break;
-                }
+                return; /* no match found */
             }
+            p_cmd = p_st_cmd->p_subcmd;
         }
 
         if ((p_cmd == NULL) || (p_st_cmd == NULL))
@@ -1589,7 +1852,7 @@ static void cli_tab_handle(nrf_cli_t const * p_cli)
 
     if (cmd_first == cmd_last) /* only 1 match found */
     {
-        if (p_cmd->is_dynamic)
+        if ((p_cmd != NULL) && p_cmd->is_dynamic)
         {
             /* In case of dynamic entry, function cmd_get shall be called again for matching
              * command index (cmd_last). It is because static_entry is most likely appended by
@@ -1645,6 +1908,132 @@ static void cli_tab_handle(nrf_cli_t const * p_cli)
     completion_insert(p_cli, p_st_cmd_last->p_syntax + arg_len, compl_len);
 }
 
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+/* function executes request received in RPC mode and sends its status */
+static void rpc_request_process(nrf_cli_t const * p_cli, uint8_t type, uint8_t seq, uint16_t len)
+{
+    nrf_cli_ctx_t * p_ctx = p_cli->p_ctx;
+    ret_code_t      ret;
+
+    switch (type)
+    {
+        case NRF_CLI_RPC_REQ_EXEC:
+            if (len >= sizeof(p_ctx->cmd_buff))
+            {
+                ret = NRF_ERROR_DATA_SIZE;
+                break;
+            }
+            p_ctx->cmd_buff[len] = '\0';
+            p_ctx->cmd_buff_len  = len;
+            p_ctx->cmd_buff_pos  = len;
+            p_ctx->rpc_out_type  = NRF_CLI_RPC_RSP_OUTPUT;
+            p_ctx->rpc_out_seq   = seq;
+
+            ret = cli_state_execute(p_cli);
+            /* executed command may have changed dynamic commands */
+            dynamic_cnt_cache_clear(p_cli);
+            NRF_CLI_IO_BUFFER_FLUSH(p_cli);
+            if (cli_rpc_active(p_cli))
+            {
+                rpc_output_flush(p_cli);
+            }
+            break;
+        case NRF_CLI_RPC_REQ_EXIT:
+            rpc_done_send(p_cli, seq, NRF_SUCCESS);
+            cli_state_change(p_cli, NRF_CLI_STATE_COLLECT);
+            return;
+        default:
+            ret = NRF_ERROR_NOT_SUPPORTED;
+            break;
+    }
+    rpc_done_send(p_cli, seq, ret);
+}
+
+/* function returns to the terminal mode when "exit" and the newline character are received between
+ * frames, as a person who typed rpc in a terminal cannot send the exit request */
+static void rpc_escape_check(nrf_cli_t const * p_cli, char data)
+{
+    static char const escape[] = "exit";
+    nrf_cli_ctx_t *   p_ctx    = p_cli->p_ctx;
+
+    if ((p_ctx->rpc_esc_cnt == sizeof(escape) - 1) && (data == p_cli->newline_char))
+    {
+        cli_state_change(p_cli, NRF_CLI_STATE_COLLECT);
+    }
+    else if (data == escape[p_ctx->rpc_esc_cnt])
+    {
+        p_ctx->rpc_esc_cnt++;
+    }
+    else
+    {
+        p_ctx->rpc_esc_cnt = (data == escape[0]) ? 1 : 0;
+    }
+}
+
+/* function collects request frames in RPC mode. Payload is received in the command buffer.
+ * Bytes are read one at a time, so that a frame broken by lost bytes is dropped when the sync byte
+ * of the next frame arrives in its payload. */
+static void cli_state_rpc_collect(nrf_cli_t const * p_cli)
+{
+    nrf_cli_ctx_t * p_ctx = p_cli->p_ctx;
+    size_t          count;
+    uint8_t         data;
+
+    while (p_ctx->state == NRF_CLI_STATE_RPC)
+    {
+        cli_read(p_cli, &data, sizeof(data), &count);
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (p_ctx->rpc_hdr_cnt < NRF_CLI_RPC_HDR_SIZE)
+        {
+            if (p_ctx->rpc_hdr_cnt == 0)
+            {
+                if (data != NRF_CLI_RPC_SYNC)
+                {
+                    rpc_escape_check(p_cli, (char)data);
+                    continue;
+                }
+                p_ctx->rpc_esc_cnt = 0;
+            }
+            p_ctx->rpc_hdr[p_ctx->rpc_hdr_cnt++] = data;
+        }
+        else if (data == NRF_CLI_RPC_SYNC)
+        {
+            /* payload is cut short by lost bytes, next frame starts */
+            p_ctx->rpc_hdr[0]  = data;
+            p_ctx->rpc_hdr_cnt = 1;
+            p_ctx->rpc_rx_cnt  = 0;
+            continue;
+        }
+        else
+        {
+            /* rest of too long payload is discarded, request completes with NRF_ERROR_DATA_SIZE */
+            if (p_ctx->rpc_rx_cnt < sizeof(p_ctx->cmd_buff))
+            {
+                p_ctx->cmd_buff[p_ctx->rpc_rx_cnt] = (char)data;
+            }
+            p_ctx->rpc_rx_cnt++;
+        }
+
+        uint16_t len = uint16_decode(&p_ctx->rpc_hdr[3]);
+        if ((p_ctx->rpc_hdr_cnt < NRF_CLI_RPC_HDR_SIZE) || (p_ctx->rpc_rx_cnt < len))
+        {
+            continue;
+        }
+
+#if NRF_MODULE_ENABLED(NRF_PWR_MGMT)
+        nrf_pwr_mgmt_feed();
+#endif
+        p_ctx->rpc_hdr_cnt = 0;
+        p_ctx->rpc_rx_cnt  = 0;
+        rpc_request_process(p_cli, p_ctx->rpc_hdr[1], p_ctx->rpc_hdr[2], len);
+    }
+}
+#endif // NRF_MODULE_ENABLED(NRF_CLI_RPC)
+
 #define NRF_CLI_ASCII_MAX_CHAR (127u)
 static inline ret_code_t ascii_filter(char const data)
 {
@@ -1814,8 +2203,9 @@ static void cmd_trim(nrf_cli_t const * p_cli)
 }
 
 /* function is analyzing command buffer to find matching commands. Next it invokes last recognized
- * command which has handler and passes rest of command buffer as arguments. */
-static void cli_state_execute(nrf_cli_t const * p_cli)
+ * command which has handler and passes rest of command buffer as arguments. Returned status is
+ * reported to the host in RPC mode. */
+static ret_code_t cli_state_execute(nrf_cli_t const * p_cli)
 {
     char quote;
     size_t argc;
@@ -1827,10 +2217,20 @@ static void cli_state_execute(nrf_cli_t const * p_cli)
     size_t cmd_handler_idx = 0; /* last command index for witch handler has been found */
 
     nrf_cli_cmd_entry_t const * p_cmd = NULL;
+    nrf_cli_static_entry_t const * p_st_cmd = NULL;
+
+    /* memory reserved for dynamic commands */
+    nrf_cli_static_entry_t static_entry;
+
+    /* dynamic commands may have changed since they were counted during completion */
+    dynamic_cnt_cache_clear(p_cli);
 
     cmd_trim(p_cli);
 #if NRF_MODULE_ENABLED(NRF_CLI_HISTORY)
-    history_save(p_cli);
+    if (!cli_rpc_active(p_cli))
+    {
+        history_save(p_cli);
+    }
 #endif
 
     /* create argument list */
@@ -1841,66 +2241,61 @@ static void cli_state_execute(nrf_cli_t const * p_cli)
 
     if (!argc)
     {
-        cursor_next_line_move(p_cli);
-        return;
+        if (!cli_rpc_active(p_cli))
+        {
+            cursor_next_line_move(p_cli);
+        }
+        return NRF_SUCCESS;
     }
 
     if (quote != 0)
     {
         nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "\r\nnot terminated: %c\r\n", quote);
-        return;
+        return NRF_ERROR_INVALID_DATA;
     }
 
     /*  try match command syntax for root cmd. */
-    for (cmd_idx = 0; cmd_idx <= CLI_DATA_SECTION_ITEM_COUNT; ++cmd_idx)
+    (void)cmd_find(p_cli, NULL, cmd_lvl, argv[cmd_lvl], &p_st_cmd, &static_entry);
+    if (p_st_cmd == NULL)
     {
-        if (cmd_idx >= CLI_DATA_SECTION_ITEM_COUNT)
+        if (cli_rpc_active(p_cli) || cursor_in_empty_line(p_cli))
         {
-            if (cursor_in_empty_line(p_cli))
-            {
-                nrf_cli_fprintf(p_cli,
-                                NRF_CLI_ERROR,
-                                "%s%s\r\n",
-                                argv[0],
-                                m_nrf_cli_command_not_found);
-            }
-            else
-            {
-                nrf_cli_fprintf(p_cli,
-                                NRF_CLI_ERROR,
-                                "\r\n%s%s\r\n",
-                                argv[0],
-                                m_nrf_cli_command_not_found);
-            }
-            return;
+            nrf_cli_fprintf(p_cli,
+                            NRF_CLI_ERROR,
+                            "%s%s\r\n",
+                            argv[0],
+                            m_nrf_cli_command_not_found);
         }
-
-        p_cmd = CLI_DATA_SECTION_ITEM_GET(cmd_idx);
-        if (strcmp(argv[cmd_lvl], p_cmd->u.p_static->p_syntax) != 0)
+        else
         {
-            continue;
+            nrf_cli_fprintf(p_cli,
+                            NRF_CLI_ERROR,
+                            "\r\n%s%s\r\n",
+                            argv[0],
+                            m_nrf_cli_command_not_found);
         }
-        break;
+        return NRF_ERROR_NOT_FOUND;
     }
 
-    /* root command shall be static */
-    ASSERT(p_cmd->is_dynamic == false);
+    /* terminal commands would send escape sequences or wait for a terminal response, which
+     * would consume the following requests */
+    if (cli_rpc_active(p_cli) && cli_cmd_vt100_only(p_st_cmd))
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "%s: not available in RPC mode\r\n", argv[0]);
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
 
     /* pointer to cmd level where handler has been found */
     nrf_cli_cmd_entry_t const * p_cmd_low_level_entry = NULL;
 
-    /* memory reserved for dynamic commands */
-    nrf_cli_static_entry_t static_entry;
-
-    nrf_cli_cmd_handler handler_cmd_lvl_0 = p_cmd->u.p_static->handler;
+    nrf_cli_cmd_handler handler_cmd_lvl_0 = p_st_cmd->handler;
     if (handler_cmd_lvl_0 != NULL)
     {
-        p_cli->p_ctx->p_current_stcmd = p_cmd->u.p_static;
+        p_cli->p_ctx->p_current_stcmd = p_st_cmd;
     }
 
-    p_cmd = p_cmd->u.p_static->p_subcmd;
+    p_cmd = p_st_cmd->p_subcmd;
     cmd_lvl++;
-    cmd_idx = 0;
 
     while (1)
     {
@@ -1916,39 +2311,41 @@ static void cli_state_execute(nrf_cli_t const * p_cli)
             break;
         }
 
-        cmd_get(p_cmd,
-                cmd_lvl,
-                cmd_idx++,
-                &p_cli->p_ctx->p_current_stcmd,
-                &static_entry);
+        cmd_idx = cmd_find(p_cli,
+                           p_cmd,
+                           cmd_lvl,
+                           argv[cmd_lvl],
+                           &p_cli->p_ctx->p_current_stcmd,
+                           &static_entry);
 
-        if ((cmd_idx == 0) || (p_cli->p_ctx->p_current_stcmd == NULL))
+        if (p_cli->p_ctx->p_current_stcmd == NULL)
         {
             break;
         }
 
-        if (strcmp(argv[cmd_lvl], p_cli->p_ctx->p_current_stcmd->p_syntax) == 0)
+        if (p_cli->p_ctx->p_current_stcmd->handler != NULL)
         {
-            if (p_cli->p_ctx->p_current_stcmd->handler != NULL)
-            {
-                /* storing p_st_cmd->handler is not feasable because in case of dynamic
-                 * commands data will be invalid in next loop */
-                cmd_handler_lvl = cmd_lvl;
-                cmd_handler_idx = cmd_idx - 1;
-                p_cmd_low_level_entry = p_cmd;
-            }
-            cmd_lvl++;
-            cmd_idx = 0;
-            p_cmd = p_cli->p_ctx->p_current_stcmd->p_subcmd;
+            /* storing p_st_cmd->handler is not feasable because in case of dynamic
+             * commands data will be invalid in next loop */
+            cmd_handler_lvl = cmd_lvl;
+            cmd_handler_idx = cmd_idx;
+            p_cmd_low_level_entry = p_cmd;
         }
+        cmd_lvl++;
+        p_cmd = p_cli->p_ctx->p_current_stcmd->p_subcmd;
     }
 
-    cursor_end_position_move(p_cli);
-    if (!cursor_in_empty_line(p_cli))
+    if (!cli_rpc_active(p_cli))
     {
-        cursor_next_line_move(p_cli);
+        cursor_end_position_move(p_cli);
+        if (!cursor_in_empty_line(p_cli))
+        {
+            cursor_next_line_move(p_cli);
+        }
     }
 
+    ret_code_t ret = NRF_SUCCESS;
+
     /* Executing deepest found handler */
     if (p_cmd_low_level_entry != NULL)
     {
@@ -1974,20 +2371,22 @@ static void cli_state_execute(nrf_cli_t const * p_cli)
                         NRF_CLI_ERROR,
                         "%s\r\n",
                         "please specify subcommand");
+        ret = NRF_ERROR_INVALID_PARAM;
     }
     NRF_CLI_HELP_FLAG_CLEAR(p_cli);
+    return ret;
 }
 
 /* function required by qsort */
-static int string_cmp(void const * pp_a, void const * pp_b)
+static int cmd_syntax_cmp(void const * pp_a, void const * pp_b)
 {
     ASSERT(pp_a);
     ASSERT(pp_b);
 
-    char const ** pp_str_a = (char const **)pp_a;
-    char const ** pp_str_b = (char const **)pp_b;
+    nrf_cli_cmd_entry_t const ** pp_cmd_a = (nrf_cli_cmd_entry_t const **)pp_a;
+    nrf_cli_cmd_entry_t const ** pp_cmd_b = (nrf_cli_cmd_entry_t const **)pp_b;
 
-    return strcmp(*pp_str_a, *pp_str_b);
+    return strcmp((*pp_cmd_a)->u.p_static->p_syntax, (*pp_cmd_b)->u.p_static->p_syntax);
 }
 
 static void cli_transport_evt_handler(nrf_cli_transport_evt_t evt_type, void * p_context)
@@ -2052,7 +2451,8 @@ static ret_code_t nrf_cli_instance_init(nrf_cli_t const * p_cli,
     p_cli->p_ctx->vt100_ctx.cons.terminal_wid = NRF_CLI_DEFAULT_TERMINAL_WIDTH;
     p_cli->p_ctx->vt100_ctx.cons.terminal_hei = NRF_CLI_DEFAULT_TERMINAL_HEIGHT;
 
-    const char * * pp_sorted_cmds = (const char * *)CLI_SORTED_CMD_PTRS_START_ADDR_GET;
+    nrf_cli_cmd_entry_t const ** pp_sorted_cmds =
+        (nrf_cli_cmd_entry_t const **)CLI_SORTED_CMD_PTRS_START_ADDR_GET;
     for (size_t i = 0; i < CLI_DATA_SECTION_ITEM_COUNT; i++)
     {
         const nrf_cli_cmd_entry_t * cmd;
@@ -2062,15 +2462,15 @@ static ret_code_t nrf_cli_instance_init(nrf_cli_t const * p_cli,
         ASSERT(cmd);
         ASSERT(cmd->u.p_static->p_syntax);
 
-        pp_sorted_cmds[i] = cmd->u.p_static->p_syntax;
+        pp_sorted_cmds[i] = cmd;
     }
 
     if (CLI_DATA_SECTION_ITEM_COUNT > 0)
     {
         qsort(pp_sorted_cmds,
               CLI_DATA_SECTION_ITEM_COUNT,
-              sizeof (char *),
-              string_cmp);
+              sizeof (nrf_cli_cmd_entry_t const *),
+              cmd_syntax_cmp);
     }
 
     return NRF_SUCCESS;
@@ -2232,6 +2632,25 @@ ret_code_t nrf_cli_stop(nrf_cli_t const * p_cli)
     return NRF_SUCCESS;
 }
 
+ret_code_t nrf_cli_rpc_start(nrf_cli_t const * p_cli)
+{
+    ASSERT(p_cli);
+    ASSERT(p_cli->p_ctx && p_cli->p_iface && p_cli->p_name);
+
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+    if ((p_cli->p_ctx->state != NRF_CLI_STATE_COLLECT) &&
+        (p_cli->p_ctx->state != NRF_CLI_STATE_EXECUTE))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    cli_state_change(p_cli, NRF_CLI_STATE_RPC);
+    return NRF_SUCCESS;
+#else
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
 void nrf_cli_process(nrf_cli_t const * p_cli)
 {
     ASSERT(p_cli);
@@ -2256,9 +2675,30 @@ void nrf_cli_process(nrf_cli_t const * p_cli)
             break;
         }
         case NRF_CLI_STATE_EXECUTE:
-            cli_state_execute(p_cli);
-            cli_state_change(p_cli, NRF_CLI_STATE_COLLECT);
+            (void)cli_state_execute(p_cli);
+            /* executed command may have changed dynamic commands */
+            dynamic_cnt_cache_clear(p_cli);
+            /* command may have switched CLI to other mode */
+            if (p_cli->p_ctx->state == NRF_CLI_STATE_EXECUTE)
+            {
+                cli_state_change(p_cli, NRF_CLI_STATE_COLLECT);
+            }
             break;
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+        case NRF_CLI_STATE_RPC:
+            cli_state_rpc_collect(p_cli);
+            if (p_cli->p_ctx->state == NRF_CLI_STATE_RPC)
+            {
+                p_cli->p_ctx->rpc_out_type = NRF_CLI_RPC_RSP_LOG;
+                p_cli->p_ctx->rpc_out_seq  = 0;
+                if (cli_log_entry_process(p_cli, false))
+                {
+                    NRF_CLI_IO_BUFFER_FLUSH(p_cli);
+                    rpc_output_flush(p_cli);
+                }
+            }
+            break;
+#endif
         default:
             break;
     }
@@ -2287,7 +2727,8 @@ void nrf_cli_fprintf(nrf_cli_t const *      p_cli,
     va_start(args, p_fmt);
 
 #if NRF_MODULE_ENABLED(NRF_CLI_VT100_COLORS)
-    if ((p_cli->p_ctx->use_colors) && (color != p_cli->p_ctx->vt100_ctx.col.col))
+    if ((p_cli->p_ctx->use_colors) && (color != p_cli->p_ctx->vt100_ctx.col.col) &&
+        !cli_rpc_active(p_cli))
     {
         nrf_cli_vt100_colors_t col;
 
@@ -2592,6 +3033,7 @@ static bool cli_log_entry_process(nrf_cli_t const * p_cli, bool skip)
         nrf_memobj_put(entry);
         return true;
     }
+    if (!cli_rpc_active(p_cli))
     {
         /* errasing currently displayed command and console name */
         nrf_cli_multiline_cons_t const * cons = multiline_console_data_check(p_cli);
@@ -2939,6 +3381,55 @@ NRF_CLI_CMD_REGISTER(resize,
                      "text display.",
                      nrf_cli_cmd_resize);
 
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+static void nrf_cli_cmd_rpc(nrf_cli_t const * p_cli, size_t argc, char **argv)
+{
+    ASSERT(p_cli);
+    ASSERT(p_cli->p_ctx && p_cli->p_iface && p_cli->p_name);
+
+    if (nrf_cli_help_requested(p_cli))
+    {
+        nrf_cli_help_print(p_cli, NULL, 0);
+        return;
+    }
+
+    if (argc > 1)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "%s:%s", argv[0], m_nrf_cli_bad_param_count);
+        return;
+    }
+
+    if (nrf_cli_rpc_start(p_cli) != NRF_SUCCESS)
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "%s: cannot switch to RPC mode\r\n", argv[0]);
+    }
+}
+
+NRF_CLI_CMD_REGISTER(rpc,
+                     NULL,
+                     "Switch console to binary RPC mode used by test tools. "
+                     "It is left when RPC exit request is received, or when exit is typed.",
+                     nrf_cli_cmd_rpc);
+#endif // NRF_MODULE_ENABLED(NRF_CLI_RPC)
+
+/* function returns true if command only drives the VT100 terminal */
+static bool cli_cmd_vt100_only(nrf_cli_static_entry_t const * p_st_cmd)
+{
+#if NRF_MODULE_ENABLED(NRF_CLI_HISTORY)
+    if (p_st_cmd->handler == nrf_cli_cmd_history)
+    {
+        return true;
+    }
+#endif
+    return ((p_st_cmd->handler == nrf_cli_cmd_clear) ||
+            (p_st_cmd->handler == nrf_cli_cmd_resize));
+}
+#else
+static bool cli_cmd_vt100_only(nrf_cli_static_entry_t const * p_st_cmd)
+{
+    UNUSED_PARAMETER(p_st_cmd);
+    return false;
+}
 #endif // NRF_MODULE_ENABLED(NRF_CLI_BUILD_IN_CMDS)
 
 #endif // NRF_MODULE_ENABLED(NRF_CLI)
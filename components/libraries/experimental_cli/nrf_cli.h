@@ -99,6 +99,8 @@ typedef struct nrf_cli_static_entry nrf_cli_static_entry_t;
  *          alphabetical order. If idx exceed available dynamic subcommands function must write
  *          to p_static->p_syntax NULL value. This will be the indication for CLI module that
  *          there are no more dynamic commands to read.
+ *          Number of available dynamic subcommands is cached by the CLI module between tab
+ *          completions and refreshed when a command is executed.
  **/
 typedef void (*nrf_cli_dynamic_get)(size_t idx, nrf_cli_static_entry_t * p_static);
 
@@ -151,11 +153,15 @@ struct nrf_cli_static_entry
                                 .is_dynamic = false,                    \
                                 .u.p_static = &CONCAT_3(nrf_cli_, p_syntax, _raw) \
     }; \
-    NRF_SECTION_ITEM_REGISTER(cli_sorted_cmd_ptrs, char const * CONCAT_2(p_syntax, _str_ptr))
+    NRF_SECTION_ITEM_REGISTER(cli_sorted_cmd_ptrs,                      \
+                              nrf_cli_cmd_entry_t const * CONCAT_2(p_syntax, _cmd_ptr))
 
 /**
  * @brief Macro for creating a subcommand set. It must be used outside of any function body.
  *
+ * @note Subcommands shall be sorted in alphabetical order. Commands are looked up using binary
+ *       search.
+ *
  * @param[in] name  Name of the subcommand set.
  * */
 #define NRF_CLI_CREATE_STATIC_SUBCMD_SET(name)                  \
@@ -223,9 +229,40 @@ typedef enum
     NRF_CLI_STATE_COLLECT,            //!< State collect.
     NRF_CLI_STATE_EXECUTE,            //!< State execute.
     NRF_CLI_STATE_PANIC_MODE_ACTIVE,  //!< State panic mode activated.
-    NRF_CLI_STATE_PANIC_MODE_INACTIVE //!< State panic mode requested but not supported.
+    NRF_CLI_STATE_PANIC_MODE_INACTIVE,//!< State panic mode requested but not supported.
+    NRF_CLI_STATE_RPC                 //!< State binary RPC mode, see @ref nrf_cli_rpc_start.
 } nrf_cli_state_t;
 
+/**
+ * @brief Size of the binary RPC frame header.
+ * */
+#define NRF_CLI_RPC_HDR_SIZE 5
+
+/**
+ * @brief First byte of every binary RPC frame.
+ *
+ * @details Command lines are ASCII, so this byte cannot occur in the payload of a request. When
+ *          bytes are lost, the CLI discards the rest of the broken request up to the next frame
+ *          start.
+ * */
+#define NRF_CLI_RPC_SYNC 0xA5
+
+/**
+ * @brief Binary RPC frame types.
+ *
+ * @details Each frame consists of a header: @ref NRF_CLI_RPC_SYNC (1 byte), type (1 byte),
+ *          sequence number (1 byte), payload length (2 bytes, little endian), followed by the
+ *          payload.
+ * */
+typedef enum
+{
+    NRF_CLI_RPC_REQ_EXEC   = 0x01, //!< Request: execute command line given in the payload.
+    NRF_CLI_RPC_REQ_EXIT   = 0x02, //!< Request: return to the VT100 terminal mode.
+    NRF_CLI_RPC_RSP_OUTPUT = 0x81, //!< Response: output printed by the command.
+    NRF_CLI_RPC_RSP_DONE   = 0x82, //!< Response: request completed, payload is 32-bit status.
+    NRF_CLI_RPC_RSP_LOG    = 0x83, //!< Output printed by the logger (sequence number 0).
+} nrf_cli_rpc_frame_type_t;
+
 /**
  * @brief Event type from CLI transport.
  * */
@@ -326,6 +363,22 @@ typedef PACKED_STRUCT
     nrf_cli_cmd_len_t cmd_len; //!< command length
 } nrf_cli_memobj_header_t;
 
+/**
+ * @brief Number of command levels for which number of dynamic commands is cached.
+ * */
+#ifndef NRF_CLI_DYNAMIC_CMD_CACHE_LVLS
+#define NRF_CLI_DYNAMIC_CMD_CACHE_LVLS 4
+#endif
+
+/**
+ * @brief Cached number of dynamic commands.
+ * */
+typedef struct
+{
+    nrf_cli_cmd_entry_t const * p_cmd;  //!< Dynamic command which entries were counted.
+    size_t                      cnt;    //!< Number of entries.
+} nrf_cli_dynamic_cnt_t;
+
 /**
  * @brief CLI instance context.
  * */
@@ -349,6 +402,20 @@ typedef struct
     task_id_t     task_id;
 #endif
 
+#if NRF_MODULE_ENABLED(NRF_CLI_RPC)
+    uint8_t  rpc_hdr[NRF_CLI_RPC_HDR_SIZE]; //!< Header of the request being received.
+    uint8_t  rpc_hdr_cnt;                   //!< Number of received header bytes.
+    uint8_t  rpc_esc_cnt;                   //!< Number of matched characters of the typed "exit".
+    uint8_t  rpc_out_type;                  //!< Type of frames carrying printed output.
+    uint8_t  rpc_out_seq;                   //!< Sequence number of frames carrying printed output.
+    uint16_t rpc_rx_cnt;                    //!< Number of received payload bytes.
+    uint16_t rpc_out_cnt;                   //!< Number of output bytes collected in rpc_out_buff.
+    char     rpc_out_buff[NRF_CLI_CMD_BUFF_SIZE]; //!< Output collected for the next frame.
+#endif
+
+    /* Number of dynamic commands on given level, valid until next command is executed. */
+    nrf_cli_dynamic_cnt_t dynamic_cnt[NRF_CLI_DYNAMIC_CMD_CACHE_LVLS];
+
 #if NRF_MODULE_ENABLED(NRF_CLI_HISTORY)
     nrf_memobj_t * p_cmd_list_head;     //!< Pointer to head of history list
     nrf_memobj_t * p_cmd_list_tail;     //!< Pointer to tail of history list
@@ -503,6 +570,31 @@ ret_code_t nrf_cli_start(nrf_cli_t const * p_cli);
  * */
 ret_code_t nrf_cli_stop(nrf_cli_t const * p_cli);
 
+/**
+ * @brief Switch CLI to binary RPC mode.
+ *
+ * @details In RPC mode the CLI does not echo, edit lines or send VT100 escape sequences. It
+ *          receives @ref NRF_CLI_RPC_REQ_EXEC frames with command lines and executes them with the
+ *          same command handlers. Everything printed during execution is sent in
+ *          @ref NRF_CLI_RPC_RSP_OUTPUT frames with the sequence number of the request, followed by
+ *          a @ref NRF_CLI_RPC_RSP_DONE frame with the status. Requests are processed in order, so
+ *          the host may send several requests without waiting for responses. Switching is
+ *          acknowledged with a @ref NRF_CLI_RPC_RSP_DONE frame with sequence number 0.
+ *          Terminal commands (clear, history, resize) are not executed and complete with
+ *          NRF_ERROR_NOT_SUPPORTED. @ref NRF_CLI_RPC_REQ_EXIT returns to the terminal mode.
+ *          The host must not send more requests ahead than fit in the receive buffer of the
+ *          transport. A request broken by lost bytes is discarded without a response.
+ *          "exit" typed between frames, followed by the newline character, also returns to the
+ *          terminal mode, so that a person who entered RPC mode from a terminal can leave it.
+ *
+ * @param p_cli Pointer to CLI instance.
+ *
+ * @retval NRF_SUCCESS             CLI switched to RPC mode.
+ * @retval NRF_ERROR_NOT_SUPPORTED RPC mode is disabled (@ref NRF_CLI_RPC_ENABLED).
+ * @retval NRF_ERROR_INVALID_STATE CLI is not started.
+ * */
+ret_code_t nrf_cli_rpc_start(nrf_cli_t const * p_cli);
+
 #define NRF_CLI_DEFAULT  NRF_CLI_VT100_COLOR_DEFAULT    /**< Turn off character attributes  */
 #define NRF_CLI_NORMAL   NRF_CLI_VT100_COLOR_WHITE      /**< Normal color printf.           */
 #define NRF_CLI_INFO     NRF_CLI_VT100_COLOR_GREEN      /**< Info color printf.             */
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017, Nordic Semiconductor ASA
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form, except as embedded into a Nordic
+#    Semiconductor ASA integrated circuit in a product or a software update for
+#    such product, must reproduce the above copyright notice, this list of
+#    conditions and the following disclaimer in the documentation and/or other
+#    materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# 4. This software, with or without modification, must only be used with a
+#    Nordic Semiconductor ASA integrated circuit.
+#
+# 5. Any software provided in binary form under this license must not be reverse
+#    engineered, decompiled, modified and/or disassembled.
+#
+# THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+# GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+# OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Client for the CLI binary RPC mode (NRF_CLI_RPC_ENABLED).
+
+Switches the CLI into RPC mode, sends command lines as EXEC frames without
+waiting for each other (pipelined), prints their output and status and returns
+the CLI to the terminal mode. Lines starting with # in the input are skipped.
+
+Frame: sync byte 0xA5, type (1 byte), sequence number (1 byte), payload
+length (2 bytes, LE), payload.
+
+Requests are sent ahead only while they fit in the receive buffer of the
+device transport (--window, the RX buffer size given to NRF_CLI_UART_DEF), as
+the transport loses bytes when it is full. If the device does not respond
+within --timeout seconds, the client stops with an error.
+
+Usage:
+    nrf_cli_rpc.py /dev/ttyACM0 "led on" "version"
+    nrf_cli_rpc.py /dev/ttyACM0 -f test_commands.txt
+"""
+
+import argparse
+import os
+import select
+import struct
+import sys
+
+SYNC = 0xA5
+
+REQ_EXEC = 0x01
+REQ_EXIT = 0x02
+RSP_OUTPUT = 0x81
+RSP_DONE = 0x82
+RSP_LOG = 0x83
+
+HDR = struct.Struct('<BBH')
+
+
+class RpcClient(object):
+    def __init__(self, path, baudrate, window=16, timeout=5.0):
+        self._fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self._fd):
+            import termios
+            import tty
+            tty.setraw(self._fd)
+            attr = termios.tcgetattr(self._fd)
+            speed = getattr(termios, 'B%d' % baudrate)
+            attr[4] = attr[5] = speed
+            termios.tcsetattr(self._fd, termios.TCSANOW, attr)
+        self._rx = b''
+        self._window = window
+        self._timeout = timeout
+
+    def _read(self, size):
+        while len(self._rx) < size:
+            if not select.select([self._fd], [], [], self._timeout)[0]:
+                raise TimeoutError('no response from the device in %g s' % self._timeout)
+            data = os.read(self._fd, 4096)
+            if not data:
+                raise EOFError('connection closed')
+            self._rx += data
+        data, self._rx = self._rx[:size], self._rx[size:]
+        return data
+
+    def _write(self, data):
+        while data:
+            data = data[os.write(self._fd, data):]
+
+    @staticmethod
+    def frame(ftype, seq, payload=b''):
+        return bytes([SYNC]) + HDR.pack(ftype, seq, len(payload)) + payload
+
+    def frame_get(self):
+        """Return the next (type, sequence number, payload), skipping bytes up to a frame start."""
+        while True:
+            if self._read(1)[0] != SYNC:
+                continue
+            ftype, seq, length = HDR.unpack(self._read(HDR.size))
+            if ftype in (RSP_OUTPUT, RSP_DONE, RSP_LOG):
+                return ftype, seq, self._read(length)
+
+    def start(self):
+        """Enter RPC mode from the terminal and wait for the acknowledge frame."""
+        self._write(b'\rrpc\r')
+        ack = self.frame(RSP_DONE, 0, struct.pack('<I', 0))
+        received = b''
+        while not received.endswith(ack):
+            received += self._read(1)
+
+    def execute(self, lines, log=sys.stderr):
+        """Send all command lines and return list of (status, output) in order.
+
+        Sequence numbers run from 1 to 255, 0 is used by the device for the
+        mode change and log output.
+        """
+        frames = [self.frame(REQ_EXEC, i % 255 + 1, line.encode('ascii'))
+                  for i, line in enumerate(lines)]
+        results = []
+        output = b''
+        sent = 0
+        in_flight = 0
+        while len(results) < len(frames):
+            while sent < len(frames) and (sent == len(results) or
+                                          in_flight + len(frames[sent]) <= self._window):
+                self._write(frames[sent])
+                in_flight += len(frames[sent])
+                sent += 1
+
+            ftype, seq, payload = self.frame_get()
+            if ftype == RSP_LOG:
+                log.write(payload.decode(errors='replace'))
+            elif seq != len(results) % 255 + 1:
+                raise IOError('response to request %d out of order, bytes were lost' % seq)
+            elif ftype == RSP_OUTPUT:
+                output += payload
+            elif ftype == RSP_DONE:
+                results.append((struct.unpack('<I', payload)[0], output))
+                in_flight -= len(frames[len(results) - 1])
+                output = b''
+        return results
+
+    def stop(self):
+        self._write(self.frame(REQ_EXIT, 0))
+        while self.frame_get()[:2] != (RSP_DONE, 0):
+            pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('port', help='serial device connected to the CLI')
+    parser.add_argument('commands', nargs='*', help='command lines to execute')
+    parser.add_argument('-f', '--file', help='file with command lines')
+    parser.add_argument('-b', '--baudrate', type=int, default=115200)
+    parser.add_argument('-w', '--window', type=int, default=16,
+                        help='size of the device transport RX buffer in bytes')
+    parser.add_argument('-t', '--timeout', type=float, default=5.0,
+                        help='seconds to wait for a response')
+    args = parser.parse_args()
+
+    lines = list(args.commands)
+    if args.file:
+        with open(args.file) as f:
+            lines += [l.strip() for l in f if l.strip() and not l.startswith('#')]
+
+    client = RpcClient(args.port, args.baudrate, args.window, args.timeout)
+    client.start()
+    failed = 0
+    try:
+        for line, (status, output) in zip(lines, client.execute(lines)):
+            sys.stdout.write('> %s\n%s' % (line, output.decode(errors='replace')))
+            if status:
+                sys.stdout.write('[status 0x%X]\n' % status)
+                failed += 1
+    finally:
+        client.stop()
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -117,6 +117,9 @@ __STATIC_INLINE void nrf_log_backend_panic_set(nrf_log_backend_t const * p_backe
 /**
  * @brief Function for flushing backend.
  *
+ * Called by the logger when all buffered entries were processed. Backend which collects output
+ * of multiple entries must then send it.
+ *
  * @param[in] p_backend  Pointer to the backend instance.
  */
 __STATIC_INLINE void nrf_log_backend_flush(nrf_log_backend_t const * p_backend);
@@ -179,7 +182,7 @@ __STATIC_INLINE void nrf_log_backend_panic_set(nrf_log_backend_t const * p_backe
 
 __STATIC_INLINE void nrf_log_backend_flush(nrf_log_backend_t const * p_backend)
 {
-    p_backend->p_api->panic_set(p_backend);
+    p_backend->p_api->flush(p_backend);
 }
 
 __STATIC_INLINE void nrf_log_backend_id_set(nrf_log_backend_t * p_backend, uint8_t id)
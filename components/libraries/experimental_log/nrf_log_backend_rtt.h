@@ -67,7 +67,27 @@ typedef struct {
         .backend = {.p_api = &nrf_log_backend_rtt_api},   \
     }
 
+/**
+ * @brief RTT backend statistics.
+ */
+typedef struct
+{
+    uint32_t writes;         //!< Number of blocks written to RTT.
+    uint32_t skipped_writes; //!< Number of writes which did not fit in the RTT buffer.
+    uint32_t skipped_bytes;  //!< Number of bytes discarded because the RTT buffer was full.
+} nrf_log_backend_rtt_stats_t;
+
 void nrf_log_backend_rtt_init(void);
+
+/**
+ * @brief Function for getting the RTT backend statistics.
+ *
+ * Formatted entries are collected in a block of @ref NRF_LOG_BACKEND_RTT_BLOCK_SIZE bytes
+ * and written to RTT when the block is full or when the logger buffer becomes empty.
+ *
+ * @param[out] p_stats Statistics.
+ */
+void nrf_log_backend_rtt_stats_get(nrf_log_backend_rtt_stats_t * p_stats);
 #endif //NRF_LOG_BACKEND_RTT_H
 
 /** @} */
@@ -195,7 +195,8 @@ uint8_t nrf_log_color_id_get(uint32_t module_id, nrf_log_severity_t severity);
 /**
  * @brief Function for configuring filtering ofs logs in the module.
  *
- * Filtering of logs in modules is independent for each backend.
+ * Filtering of logs in modules is independent for each backend. To limit the number of entries
+ * the module stores in the logger buffer, use @ref nrf_log_module_rate_limit_set.
  *
  * @param backend_id Backend ID which want to chenge its configuration.
  * @param module_id  Module ID which logs will be reconfigured.
@@ -222,6 +223,56 @@ nrf_log_severity_t nrf_log_module_filter_get(uint32_t backend_id,
                                              bool     is_ordered_idx,
                                              bool     dynamic);
 
+/**
+ * @brief Module rate limit configuration and drop statistics.
+ */
+typedef struct
+{
+    uint16_t rate;       //!< Average number of entries per second, 0 if not limited.
+    uint16_t burst;      //!< Maximum number of entries accepted in a burst.
+    uint16_t suppressed; //!< Entries suppressed by the rate limit since the last summary entry.
+    uint16_t dropped;    //!< Entries lost due to lack of space since the last summary entry.
+} nrf_log_module_rate_info_t;
+
+/**
+ * @brief Function for configuring the rate limit of logs in the module.
+ *
+ * Limit is common for all backends and applied before entries are stored in the logger buffer,
+ * using a token bucket refilled based on the timestamp function. Suppressed entries, as well as
+ * entries lost due to the buffer being full, are counted per module and reported with a summary
+ * entry when the module logs again.
+ *
+ * The limit is not part of @ref nrf_log_module_filter_set. That filter is kept per backend and
+ * only selects which entries a backend prints, while all backends share the logger buffer: a
+ * limit set for one backend could not keep a flooding module from filling the buffer for the
+ * others. The limit also needs the timestamp function, so unlike the filter it can fail.
+ *
+ * @param module_id Module ID.
+ * @param rate      Average number of entries per second. 0 disables the limit.
+ * @param burst     Number of entries accepted in a burst.
+ *
+ * @retval NRF_SUCCESS             Rate limit configured.
+ * @retval NRF_ERROR_NOT_SUPPORTED Rate limiting is disabled (@ref NRF_LOG_RATE_LIMIT_ENABLED).
+ * @retval NRF_ERROR_INVALID_STATE Logger was initialized without a timestamp function.
+ * @retval NRF_ERROR_INVALID_PARAM Invalid module ID or burst.
+ */
+ret_code_t nrf_log_module_rate_limit_set(uint32_t module_id, uint16_t rate, uint16_t burst);
+
+/**
+ * @brief Function for getting the rate limit configuration and drop statistics of the module.
+ *
+ * @param[in]  module_id      Module ID.
+ * @param[in]  is_ordered_idx Module ID is given is index in alphabetically sorted list of modules.
+ * @param[out] p_info         Rate limit configuration and statistics.
+ *
+ * @retval NRF_SUCCESS             Information returned.
+ * @retval NRF_ERROR_NOT_SUPPORTED Rate limiting is disabled (@ref NRF_LOG_RATE_LIMIT_ENABLED).
+ * @retval NRF_ERROR_NOT_FOUND     Invalid module ID.
+ */
+ret_code_t nrf_log_module_rate_info_get(uint32_t                     module_id,
+                                        bool                         is_ordered_idx,
+                                        nrf_log_module_rate_info_t * p_info);
+
 #ifdef __cplusplus
 }
 #endif
@@ -46,26 +46,49 @@
 #include <SEGGER_RTT_Conf.h>
 #include <SEGGER_RTT.h>
 
+#ifndef NRF_LOG_BACKEND_RTT_BLOCK_SIZE
+#define NRF_LOG_BACKEND_RTT_BLOCK_SIZE 256
+#endif
+
 #if NRF_LOG_BACKEND_RTT_ENABLED
 #define RTT_BACKEND_BUFFER_SIZE NRF_LOG_BACKEND_RTT_TEMP_BUFFER_SIZE
+#define RTT_BACKEND_BLOCK_SIZE  NRF_LOG_BACKEND_RTT_BLOCK_SIZE
 #else
 #define RTT_BACKEND_BUFFER_SIZE 1
+#define RTT_BACKEND_BLOCK_SIZE  1
+#endif
+
+#ifndef NRF_LOG_BACKEND_RTT_SKIP_IF_FULL
+#define NRF_LOG_BACKEND_RTT_SKIP_IF_FULL 0
 #endif
 
 static uint8_t m_string_buff[RTT_BACKEND_BUFFER_SIZE];
 
+/* Formatted output of consecutive entries is collected in a block which is written to RTT at once. */
+static uint8_t  m_block[RTT_BACKEND_BLOCK_SIZE];
+static uint32_t m_block_cnt;
+static bool     m_panic;
+
+static nrf_log_backend_rtt_stats_t m_stats;
+
 void nrf_log_backend_rtt_init(void)
 {
     SEGGER_RTT_Init();
 }
 
-static void serial_tx(void const * p_context, char const * buffer, size_t len)
+void nrf_log_backend_rtt_stats_get(nrf_log_backend_rtt_stats_t * p_stats)
+{
+    *p_stats = m_stats;
+}
+
+static void rtt_write(char const * buffer, size_t len)
 {
     if (len)
     {
         uint32_t idx    = 0;
         uint32_t processed;
         uint32_t watchdog_counter = 10;
+        m_stats.writes++;
         do
         {
             processed = SEGGER_RTT_WriteNoLock(0, &buffer[idx], len);
@@ -75,28 +98,60 @@ static void serial_tx(void const * p_context, char const * buffer, size_t len)
             {
                 // If RTT is not connected then ensure that logger does not block
                 watchdog_counter--;
-                if (watchdog_counter == 0)
+                if (NRF_LOG_BACKEND_RTT_SKIP_IF_FULL || (watchdog_counter == 0))
                 {
+                    m_stats.skipped_writes++;
+                    m_stats.skipped_bytes += len;
                     break;
                 }
             }
         } while (len);
     }
 }
+
+static void block_commit(void)
+{
+    rtt_write((char const *)m_block, m_block_cnt);
+    m_block_cnt = 0;
+}
+
+static void serial_tx(void const * p_context, char const * buffer, size_t len)
+{
+    if (len > (sizeof(m_block) - m_block_cnt))
+    {
+        block_commit();
+    }
+
+    if (len >= sizeof(m_block))
+    {
+        rtt_write(buffer, len);
+    }
+    else
+    {
+        memcpy(&m_block[m_block_cnt], buffer, len);
+        m_block_cnt += len;
+    }
+}
+
 static void nrf_log_backend_rtt_put(nrf_log_backend_t const * p_backend,
                                nrf_log_entry_t * p_msg)
 {
     nrf_log_backend_serial_put(p_backend, p_msg, m_string_buff, RTT_BACKEND_BUFFER_SIZE, serial_tx);
+    if (m_panic)
+    {
+        block_commit();
+    }
 }
 
 static void nrf_log_backend_rtt_flush(nrf_log_backend_t const * p_backend)
 {
-
+    block_commit();
 }
 
 static void nrf_log_backend_rtt_panic_set(nrf_log_backend_t const * p_backend)
 {
-
+    m_panic = true;
+    block_commit();
 }
 
 const nrf_log_backend_api_t nrf_log_backend_rtt_api = {
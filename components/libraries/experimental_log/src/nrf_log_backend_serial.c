@@ -43,12 +43,150 @@
 #include "nrf_log_str_formatter.h"
 #include "nrf_log_internal.h"
 
+#ifndef NRF_LOG_BACKEND_SERIAL_BINARY
+#define NRF_LOG_BACKEND_SERIAL_BINARY 0
+#endif
+
+#if NRF_LOG_BACKEND_SERIAL_BINARY
+#define SLIP_BYTE_END             0300    /* indicates end of packet */
+#define SLIP_BYTE_ESC             0333    /* indicates byte stuffing */
+#define SLIP_BYTE_ESC_END         0334    /* ESC ESC_END means END data byte */
+#define SLIP_BYTE_ESC_ESC         0335    /* ESC ESC_ESC means ESC data byte */
+
+#define BIN_FLAG_TIMESTAMP        0x01    /* Frame contains timestamp. */
+
+typedef struct
+{
+    uint8_t *          p_buffer;
+    uint32_t           length;
+    uint32_t           cnt;
+    nrf_fprintf_fwrite tx_func;
+} bin_writer_t;
+
+static void bin_raw_put(bin_writer_t * p_wr, uint8_t byte)
+{
+    if (p_wr->cnt == p_wr->length)
+    {
+        p_wr->tx_func(NULL, (char const *)p_wr->p_buffer, p_wr->cnt);
+        p_wr->cnt = 0;
+    }
+    p_wr->p_buffer[p_wr->cnt++] = byte;
+}
+
+static void bin_put(bin_writer_t * p_wr, void const * p_data, uint32_t len)
+{
+    uint8_t const * p_byte = (uint8_t const *)p_data;
+    while (len--)
+    {
+        uint8_t byte = *p_byte++;
+        if (byte == SLIP_BYTE_END)
+        {
+            bin_raw_put(p_wr, SLIP_BYTE_ESC);
+            byte = SLIP_BYTE_ESC_END;
+        }
+        else if (byte == SLIP_BYTE_ESC)
+        {
+            bin_raw_put(p_wr, SLIP_BYTE_ESC);
+            byte = SLIP_BYTE_ESC_ESC;
+        }
+        bin_raw_put(p_wr, byte);
+    }
+}
+
+/**
+ * @brief Function for sending a log entry as a SLIP frame, without formatting it.
+ *
+ * Frame (little endian): flags (1 byte), entry header word (4), module ID (2), timestamp (4, only
+ * if @ref BIN_FLAG_TIMESTAMP is set), followed by arguments (4 bytes each) and a bitmask of
+ * arguments pointing to pushed strings (1 byte) for standard entries, or by the data for hexdump
+ * entries. Pushed strings are appended null-terminated, because their content is not present in
+ * the application image. Constant strings are resolved by the host from the image.
+ */
+static void binary_entry_put(nrf_log_entry_t * p_msg,
+                             uint8_t * p_buffer,
+                             uint32_t  length,
+                             nrf_fprintf_fwrite tx_func)
+{
+    bin_writer_t wr = {
+        .p_buffer = p_buffer,
+        .length   = length,
+        .cnt      = 0,
+        .tx_func  = tx_func
+    };
+
+    nrf_log_header_t header;
+    uint32_t         memobj_offset = HEADER_SIZE*sizeof(uint32_t);
+    nrf_memobj_read(p_msg, &header, HEADER_SIZE*sizeof(uint32_t), 0);
+
+    uint8_t  flags     = NRF_LOG_USES_TIMESTAMP ? BIN_FLAG_TIMESTAMP : 0;
+    uint16_t module_id = (uint16_t)header.module_id;
+
+    bin_raw_put(&wr, SLIP_BYTE_END);
+    bin_put(&wr, &flags, sizeof(flags));
+    bin_put(&wr, &header.base.raw, sizeof(header.base.raw));
+    bin_put(&wr, &module_id, sizeof(module_id));
+    if (NRF_LOG_USES_TIMESTAMP)
+    {
+        bin_put(&wr, &header.timestamp, sizeof(header.timestamp));
+    }
+
+    if (header.base.generic.type == HEADER_TYPE_STD)
+    {
+        uint32_t nargs = header.base.std.nargs;
+        uint32_t args[NRF_LOG_MAX_NUM_OF_ARGS];
+        uint32_t str_len[NRF_LOG_MAX_NUM_OF_ARGS];
+        uint8_t  pushed_mask = 0;
+        uint32_t i;
+
+        nrf_memobj_read(p_msg, args, nargs*sizeof(uint32_t), memobj_offset);
+        bin_put(&wr, args, nargs*sizeof(uint32_t));
+
+        for (i = 0; i < nargs; i++)
+        {
+            if (nrf_log_frontend_pushed_str_get(args[i], &str_len[i]))
+            {
+                pushed_mask |= (uint8_t)(1U << i);
+            }
+        }
+        bin_put(&wr, &pushed_mask, sizeof(pushed_mask));
+
+        for (i = 0; i < nargs; i++)
+        {
+            if (pushed_mask & (1U << i))
+            {
+                bin_put(&wr, (void const *)args[i], str_len[i]);
+                bin_raw_put(&wr, '\0');
+            }
+        }
+    }
+    else if (header.base.generic.type == HEADER_TYPE_HEXDUMP)
+    {
+        nrf_memobj_iter_t  iter;
+        nrf_memobj_iovec_t seg;
+
+        nrf_memobj_iter_init(&iter, p_msg, header.base.hexdump.len, memobj_offset);
+        while (nrf_memobj_iter_next(&iter, &seg))
+        {
+            bin_put(&wr, seg.p_data, seg.len);
+        }
+    }
+
+    bin_raw_put(&wr, SLIP_BYTE_END);
+    tx_func(NULL, (char const *)p_buffer, wr.cnt);
+}
+#endif // NRF_LOG_BACKEND_SERIAL_BINARY
+
 void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
                                nrf_log_entry_t * p_msg,
                                uint8_t * p_buffer,
                                uint32_t  length,
                                nrf_fprintf_fwrite tx_func)
 {
+#if NRF_LOG_BACKEND_SERIAL_BINARY
+    nrf_memobj_get(p_msg);
+    binary_entry_put(p_msg, p_buffer, length, tx_func);
+    nrf_memobj_put(p_msg);
+#else
     nrf_memobj_get(p_msg);
 
     nrf_fprintf_ctx_t fprintf_ctx = {
@@ -112,5 +250,6 @@ void nrf_log_backend_serial_put(nrf_log_backend_t const * p_backend,
     }
     nrf_memobj_put(p_msg);
     /*lint -restore*/
+#endif // NRF_LOG_BACKEND_SERIAL_BINARY
 }
 #endif //NRF_LOG_ENABLED
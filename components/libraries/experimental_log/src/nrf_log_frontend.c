@@ -88,6 +88,9 @@ typedef struct
 
 static log_data_t   m_log_data;
 static const char * m_overflow_info = "Overflow";
+#if NRF_LOG_RATE_LIMIT_ENABLED
+static const char * m_drop_summary_info = "%u entries suppressed, %u dropped";
+#endif
 /*lint -save -esym(526,log_const_data*) -esym(526,log_dynamic_data*)*/
 NRF_SECTION_DEF(log_dynamic_data, nrf_log_module_dynamic_data_t);
 NRF_SECTION_DEF(log_const_data, nrf_log_module_const_data_t);
@@ -118,7 +121,7 @@ ret_code_t nrf_log_init(nrf_log_timestamp_func_t timestamp_func)
     m_log_data.log_skipped  = 0;
     m_log_data.log_skipping = 0;
     m_log_data.panic        = false;
-    if (NRF_LOG_USES_TIMESTAMP)
+    if (NRF_LOG_USES_TIMESTAMP || NRF_LOG_RATE_LIMIT_ENABLED)
     {
         m_log_data.timestamp_func = timestamp_func;
     }
@@ -156,6 +159,11 @@ ret_code_t nrf_log_init(nrf_log_timestamp_func_t timestamp_func)
             p_module_ddata->filter = 0;
             p_module_ddata->module_id = i;
             p_module_ddata->order_idx = idx;
+#if NRF_LOG_RATE_LIMIT_ENABLED
+            p_module_ddata->rate       = 0;
+            p_module_ddata->suppressed = 0;
+            p_module_ddata->dropped    = 0;
+#endif
         }
     }
     else
@@ -164,6 +172,11 @@ ret_code_t nrf_log_init(nrf_log_timestamp_func_t timestamp_func)
         {
             nrf_log_module_dynamic_data_t * p_module_ddata = NRF_LOG_DYNAMIC_SECTION_VARS_GET(i);
             p_module_ddata->module_id = i;
+#if NRF_LOG_RATE_LIMIT_ENABLED
+            p_module_ddata->rate       = 0;
+            p_module_ddata->suppressed = 0;
+            p_module_ddata->dropped    = 0;
+#endif
         }
     }
 
@@ -292,6 +305,118 @@ nrf_log_severity_t nrf_log_module_filter_get(uint32_t backend_id,
     return severity;
 }
 
+#if NRF_LOG_RATE_LIMIT_ENABLED
+ret_code_t nrf_log_module_rate_limit_set(uint32_t module_id, uint16_t rate, uint16_t burst)
+{
+    if (m_log_data.timestamp_func == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if ((module_id >= nrf_log_module_cnt_get()) || ((rate != 0) && (burst == 0)))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    nrf_log_module_dynamic_data_t * p_module = NRF_LOG_DYNAMIC_SECTION_VARS_GET(module_id);
+    CRITICAL_REGION_ENTER();
+    p_module->rate      = rate;
+    p_module->burst     = burst;
+    p_module->tokens    = (uint32_t)burst * NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ;
+    p_module->timestamp = m_log_data.timestamp_func();
+    CRITICAL_REGION_EXIT();
+    return NRF_SUCCESS;
+}
+
+ret_code_t nrf_log_module_rate_info_get(uint32_t                     module_id,
+                                        bool                         is_ordered_idx,
+                                        nrf_log_module_rate_info_t * p_info)
+{
+    if ((module_idx_get(&module_id, is_ordered_idx) != NRF_SUCCESS) ||
+        (module_id >= nrf_log_module_cnt_get()))
+    {
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    nrf_log_module_dynamic_data_t * p_module = NRF_LOG_DYNAMIC_SECTION_VARS_GET(module_id);
+    p_info->rate       = p_module->rate;
+    p_info->burst      = p_module->burst;
+    p_info->suppressed = p_module->suppressed;
+    p_info->dropped    = p_module->dropped;
+    return NRF_SUCCESS;
+}
+
+/**
+ * @brief Adds to a saturating 16 bit counter.
+ */
+static inline void counter_add(uint16_t * p_counter, uint32_t value)
+{
+    uint32_t sum = *p_counter + value;
+    *p_counter   = (uint16_t)MIN(sum, UINT16_MAX);
+}
+
+/**
+ * @brief Records entries of the module lost due to lack of space.
+ */
+static void module_drop_record(uint32_t module_id, uint32_t count)
+{
+    if (module_id < nrf_log_module_cnt_get())
+    {
+        nrf_log_module_dynamic_data_t * p_module = NRF_LOG_DYNAMIC_SECTION_VARS_GET(module_id);
+        CRITICAL_REGION_ENTER();
+        counter_add(&p_module->dropped, count);
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+/**
+ * @brief Takes a token from the bucket of the module.
+ *
+ * @param p_module Module data.
+ *
+ * @return True if the entry can be stored, false if it exceeds the rate limit of the module.
+ */
+static bool module_token_take(nrf_log_module_dynamic_data_t * p_module)
+{
+    bool ret = true;
+
+    CRITICAL_REGION_ENTER();
+    if (p_module->rate != 0)
+    {
+        // Timestamp wrap (e.g. 24 bit RTC) at most refills the bucket.
+        uint32_t now    = m_log_data.timestamp_func();
+        uint64_t tokens = p_module->tokens + (uint64_t)(now - p_module->timestamp) * p_module->rate;
+        uint32_t full   = (uint32_t)p_module->burst * NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ;
+
+        p_module->timestamp = now;
+        p_module->tokens    = (tokens > full) ? full : (uint32_t)tokens;
+        if (p_module->tokens >= NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ)
+        {
+            p_module->tokens -= NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ;
+        }
+        else
+        {
+            counter_add(&p_module->suppressed, 1);
+            ret = false;
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return ret;
+}
+#else
+ret_code_t nrf_log_module_rate_limit_set(uint32_t module_id, uint16_t rate, uint16_t burst)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
+ret_code_t nrf_log_module_rate_info_get(uint32_t                     module_id,
+                                        bool                         is_ordered_idx,
+                                        nrf_log_module_rate_info_t * p_info)
+{
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+#endif // NRF_LOG_RATE_LIMIT_ENABLED
+
 /**
  * @brief Skips the oldest, not pushed logs to make space for new logs.
  * @details This function moves forward read index to prepare space for new logs.
@@ -334,6 +459,9 @@ static void log_skip(void)
     if (log_skipping_tmp)
     {
         m_log_data.rd_idx = rd_idx;
+#if NRF_LOG_RATE_LIMIT_ENABLED
+        module_drop_record(header.module_id, 1);
+#endif
     }
 }
 
@@ -393,15 +521,17 @@ static inline bool buf_prealloc(uint32_t content_len, uint32_t * p_wr_idx)
         {
             if (available_words >= HEADER_SIZE)
             {
-                // Overflow entry is injected
+                // Overflow entry is injected in place of the requested entry.
                 (void)std_header_set(NRF_LOG_LEVEL_WARNING, m_overflow_info, 0, m_log_data.wr_idx, m_log_data.mask);
                 req_len = HEADER_SIZE;
             }
             else
             {
                 // overflow case
-                ret = false;
+                req_len = 0;
             }
+            // Requested entry is dropped.
+            ret = false;
             break;
         }
 
@@ -487,15 +617,34 @@ uint32_t nrf_log_push(char * const p_str)
     return (uint32_t)p_dst_str;
 }
 
-static inline void std_n(uint32_t severity_mid, char const * const p_str, uint32_t const * args, uint32_t nargs)
+bool nrf_log_frontend_pushed_str_get(uint32_t addr, uint32_t * p_len)
 {
-    uint32_t mask   = m_log_data.mask;
-    uint32_t wr_idx;
+    uint32_t start = (uint32_t)m_log_data.buffer;
+    uint32_t end   = start + sizeof(m_log_data.buffer);
 
-    if (m_log_data.panic)
+    if ((NRF_LOG_DEFERRED == 0) || (addr < start) || (addr >= end))
     {
-        return;
+        return false;
+    }
+
+    // Length is limited to the buffer in case addr is a value which only looks like a pointer.
+    char const * p_str = (char const *)addr;
+    uint32_t     len   = 0;
+    while ((addr + len < end) && (p_str[len] != '\0'))
+    {
+        len++;
     }
+    *p_len = len;
+    return true;
+}
+
+static inline bool std_entry_store(uint32_t severity_mid,
+                                   char const * const p_str,
+                                   uint32_t const * args,
+                                   uint32_t nargs)
+{
+    uint32_t mask   = m_log_data.mask;
+    uint32_t wr_idx;
 
     if (buf_prealloc(nargs, &wr_idx))
     {
@@ -507,6 +656,82 @@ static inline void std_n(uint32_t severity_mid, char const * const p_str, uint32
         {
             m_log_data.buffer[wr_idx++ & mask] =args[i];
         }
+        return true;
+    }
+    return false;
+}
+
+#if NRF_LOG_RATE_LIMIT_ENABLED
+/**
+ * @brief Applies the rate limit of the module sending the entry.
+ *
+ * If entries of the module were suppressed or lost, a summary entry is stored first. Summary is
+ * postponed while the buffer is more than half full, as it would only displace more entries.
+ *
+ * @param severity_mid Severity and module ID of the entry.
+ *
+ * @return True if the entry is to be stored, false if it is suppressed.
+ */
+static bool module_entry_admit(uint32_t severity_mid)
+{
+    uint32_t module_id = severity_mid >> NRF_LOG_MODULE_ID_POS;
+    nrf_log_module_dynamic_data_t * p_module = NRF_LOG_DYNAMIC_SECTION_VARS_GET(module_id);
+    uint32_t counters[2];
+
+    if (!module_token_take(p_module))
+    {
+        return false;
+    }
+
+    if (((p_module->suppressed | p_module->dropped) == 0) ||
+        ((m_log_data.wr_idx - m_log_data.rd_idx) > ((m_log_data.mask + 1) / 2)))
+    {
+        return true;
+    }
+
+    CRITICAL_REGION_ENTER();
+    counters[0]          = p_module->suppressed;
+    counters[1]          = p_module->dropped;
+    p_module->suppressed = 0;
+    p_module->dropped    = 0;
+    CRITICAL_REGION_EXIT();
+
+    if ((counters[0] != 0) || (counters[1] != 0))
+    {
+        uint32_t summary_mid = NRF_LOG_LEVEL_WARNING | (module_id << NRF_LOG_MODULE_ID_POS);
+        if (!std_entry_store(summary_mid, m_drop_summary_info, counters, ARRAY_SIZE(counters)))
+        {
+            // Keep the counters to be reported with the next summary.
+            CRITICAL_REGION_ENTER();
+            counter_add(&p_module->suppressed, counters[0]);
+            counter_add(&p_module->dropped, counters[1]);
+            CRITICAL_REGION_EXIT();
+        }
+    }
+    return true;
+}
+#else
+static inline bool module_entry_admit(uint32_t severity_mid)
+{
+    return true;
+}
+
+static inline void module_drop_record(uint32_t module_id, uint32_t count)
+{
+}
+#endif // NRF_LOG_RATE_LIMIT_ENABLED
+
+static inline void std_n(uint32_t severity_mid, char const * const p_str, uint32_t const * args, uint32_t nargs)
+{
+    if (m_log_data.panic)
+    {
+        return;
+    }
+
+    if (module_entry_admit(severity_mid) &&
+        !std_entry_store(severity_mid, p_str, args, nargs))
+    {
+        module_drop_record(severity_mid >> NRF_LOG_MODULE_ID_POS, 1);
     }
     if (NRF_LOG_DEFERRED == 0)
     {
@@ -590,15 +815,10 @@ void nrf_log_frontend_std_6(uint32_t           severity_mid,
 }
 
 
-void nrf_log_frontend_hexdump(uint32_t           severity_mid,
-                              const void * const p_data,
-                              uint16_t           length)
+static inline bool hexdump_entry_store(uint32_t           severity_mid,
+                                       const void * const p_data,
+                                       uint16_t           length)
 {
-    if (m_log_data.panic)
-    {
-        return;
-    }
-
     uint32_t mask   = m_log_data.mask;
 
     uint32_t wr_idx;
@@ -631,6 +851,24 @@ void nrf_log_frontend_hexdump(uint32_t           severity_mid,
             length -= space0;
             memcpy(&m_log_data.buffer[0], &((uint8_t *)p_data)[space0], length);
         }
+        return true;
+    }
+    return false;
+}
+
+void nrf_log_frontend_hexdump(uint32_t           severity_mid,
+                              const void * const p_data,
+                              uint16_t           length)
+{
+    if (m_log_data.panic)
+    {
+        return;
+    }
+
+    if (module_entry_admit(severity_mid) &&
+        !hexdump_entry_store(severity_mid, p_data, length))
+    {
+        module_drop_record(severity_mid >> NRF_LOG_MODULE_ID_POS, 1);
     }
 
     if (NRF_LOG_DEFERRED == 0)
@@ -776,7 +1014,20 @@ bool nrf_log_frontend_dequeue(void)
          m_log_data.rd_idx = rd_idx;
     }
 
-    return buffer_is_empty() ? false : true;
+    if (buffer_is_empty())
+    {
+        nrf_log_backend_t * p_backend = m_log_data.p_backend_head;
+        while (p_backend)
+        {
+            if (nrf_log_backend_is_enabled(p_backend))
+            {
+                nrf_log_backend_flush(p_backend);
+            }
+            p_backend = p_backend->p_next;
+        }
+        return false;
+    }
+    return true;
 }
 
 static int32_t backend_id_assign(void)
@@ -871,6 +1122,7 @@ void nrf_log_panic(void)
 
 #if NRF_LOG_CLI_CMDS
 #include "nrf_cli.h"
+#include <stdlib.h>
 
 static const char * m_severity_lvls[] = {
         "none",
@@ -899,18 +1151,38 @@ static void log_status(nrf_cli_t const * p_cli, size_t argc, char **argv)
     {
         nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Logs are halted!\r\n");
     }
-    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "%-24s | current | buildin \r\n", "module_name");
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "%-24s | current | buildin ", "module_name");
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "| rate/burst  | suppressed | dropped");
+#endif
+    nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\r\n");
     nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "------------------------------------------\r\n");
     for (i = 0; i < modules_cnt; i++)
     {
         nrf_log_severity_t module_dynamic_lvl = nrf_log_module_filter_get(backend_id, i, true, true);
         nrf_log_severity_t module_compiled_lvl = nrf_log_module_filter_get(backend_id, i, true, false);
         nrf_log_severity_t actual_compiled_lvl = MIN(module_compiled_lvl, (nrf_log_severity_t)NRF_LOG_DEFAULT_LEVEL);
-        nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "%-24s | %-7s | %s%s\r\n",
+        nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "%-24s | %-7s | %s%-2s",
                                   nrf_log_module_name_get(i, true),
                                   m_severity_lvls[module_dynamic_lvl],
                                   m_severity_lvls[actual_compiled_lvl],
                                   actual_compiled_lvl < module_compiled_lvl ? "*" : "");
+#if NRF_LOG_RATE_LIMIT_ENABLED
+        nrf_log_module_rate_info_t info;
+        if (nrf_log_module_rate_info_get(i, true, &info) == NRF_SUCCESS)
+        {
+            if (info.rate)
+            {
+                nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, " | %5u/%-5u", info.rate, info.burst);
+            }
+            else
+            {
+                nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, " | %-11s", "none");
+            }
+            nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, " | %-10u | %u", info.suppressed, info.dropped);
+        }
+#endif
+        nrf_cli_fprintf(p_cli, NRF_CLI_NORMAL, "\r\n");
     }
 }
 
@@ -1025,6 +1297,61 @@ static void log_ctrl(nrf_cli_t const * p_cli, size_t argc, char **argv)
         }
     }
 }
+#if NRF_LOG_RATE_LIMIT_ENABLED
+static void log_rate(nrf_cli_t const * p_cli, size_t argc, char **argv)
+{
+    uint32_t i;
+    uint32_t rate;
+    uint32_t burst;
+    char *   p_end;
+
+    if ((argc < 3) || nrf_cli_help_requested(p_cli))
+    {
+        nrf_cli_help_print(p_cli, NULL, 0);
+        return;
+    }
+
+    rate  = strtoul(argv[1], &p_end, 10);
+    burst = (*p_end == '\0') ? strtoul(argv[2], &p_end, 10) : 0;
+    if ((*p_end != '\0') || (rate > UINT16_MAX) || (burst > UINT16_MAX))
+    {
+        nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Invalid rate or burst\r\n");
+        return;
+    }
+
+    for (i = 0; i < nrf_log_module_cnt_get(); i++)
+    {
+        uint32_t j;
+        bool     selected = (argc == 3);
+        for (j = 3; j < argc; j++)
+        {
+            if (strncmp(nrf_log_module_name_get(i, false), argv[j], 32) == 0)
+            {
+                selected = true;
+                break;
+            }
+        }
+
+        if (selected &&
+            (nrf_log_module_rate_limit_set(i, (uint16_t)rate, (uint16_t)burst) != NRF_SUCCESS))
+        {
+            nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Rate limit unavailable for module: %s\r\n",
+                            nrf_log_module_name_get(i, false));
+            return;
+        }
+    }
+
+    for (i = 3; i < argc; i++)
+    {
+        uint32_t module_id;
+        if (module_id_get(argv[i], &module_id) == false)
+        {
+            nrf_cli_fprintf(p_cli, NRF_CLI_ERROR, "Unknown module:%s\r\n", argv[i]);
+        }
+    }
+}
+#endif // NRF_LOG_RATE_LIMIT_ENABLED
+
 static void module_name_get(size_t idx, nrf_cli_static_entry_t * p_static);
 
 NRF_CLI_CREATE_DYNAMIC_CMD(m_module_name, module_name_get);
@@ -1070,6 +1397,12 @@ NRF_CLI_CREATE_STATIC_SUBCMD_SET(m_sub_log_stat)
         log_ctrl),
     NRF_CLI_CMD(go, NULL, "Resume logging", log_go),
     NRF_CLI_CMD(halt, NULL, "Halt logging", log_halt),
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    NRF_CLI_CMD(rate, NULL,
+        "'log rate <entries_per_s> <burst> <module_0> ... <module_n>' limits logs of specified "
+        "modules (all if no modules specified). Rate 0 removes the limit.",
+        log_rate),
+#endif
     NRF_CLI_CMD(status, NULL, "Logger status", log_status),
     NRF_CLI_SUBCMD_SET_END
 };
@@ -83,6 +83,14 @@
 #define NRF_LOG_FILTERS_ENABLED   0
 #endif
 
+#ifndef NRF_LOG_RATE_LIMIT_ENABLED
+#define NRF_LOG_RATE_LIMIT_ENABLED 0
+#endif
+
+#ifndef NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ
+#define NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ 32768
+#endif
+
 #ifndef NRF_LOG_MODULE_NAME
     #define NRF_LOG_MODULE_NAME app
 #endif
@@ -289,6 +297,14 @@ typedef struct
     uint16_t     order_idx;
     uint32_t     filter;
     uint32_t     filter_lvls;
+#if NRF_LOG_RATE_LIMIT_ENABLED
+    uint16_t     rate;         // Average number of entries per second, 0 if not limited.
+    uint16_t     burst;        // Bucket size (in entries).
+    uint32_t     tokens;       // Bucket content, scaled by NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ.
+    uint32_t     timestamp;    // Timestamp of the last bucket update.
+    uint16_t     suppressed;   // Entries suppressed by the rate limit since the last summary.
+    uint16_t     dropped;      // Entries lost due to lack of space since the last summary.
+#endif
 } nrf_log_module_dynamic_data_t;
 
 typedef struct
@@ -525,6 +541,17 @@ void nrf_log_frontend_hexdump(uint32_t           severity_mid,
                               const void * const p_data,
                               uint16_t           length);
 
+/**
+ * @brief A function for checking if an address points to a string pushed to the logger buffer.
+ *
+ * @param[in]  addr  Address, typically a logged argument.
+ * @param[out] p_len Length of the string (without the terminating character).
+ *
+ * @retval true  String is located in the logger buffer (see @ref NRF_LOG_PUSH).
+ * @retval false Address is outside of the logger buffer.
+ */
+bool nrf_log_frontend_pushed_str_get(uint32_t addr, uint32_t * p_len);
+
 /**
  * @brief A function for reading a byte from log backend.
  *
@@ -0,0 +1,309 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017, Nordic Semiconductor ASA
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form, except as embedded into a Nordic
+#    Semiconductor ASA integrated circuit in a product or a software update for
+#    such product, must reproduce the above copyright notice, this list of
+#    conditions and the following disclaimer in the documentation and/or other
+#    materials provided with the distribution.
+#
+# 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+#    contributors may be used to endorse or promote products derived from this
+#    software without specific prior written permission.
+#
+# 4. This software, with or without modification, must only be used with a
+#    Nordic Semiconductor ASA integrated circuit.
+#
+# 5. Any software provided in binary form under this license must not be reverse
+#    engineered, decompiled, modified and/or disassembled.
+#
+# THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+# GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+# LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+# OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Decoder for binary logger output (NRF_LOG_BACKEND_SERIAL_BINARY).
+
+Reads the SLIP framed log entries produced by the serial backends (RTT, UART)
+and prints them in the same form as the on-target string formatter. Format
+strings and module names are taken from the application ELF file, which must
+be the image running on the target.
+
+Usage:
+    nrf_log_decode.py app.elf rtt_log.bin
+    JLinkRTTLogger ... /dev/stdout | nrf_log_decode.py app.elf -
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SLIP_END = 0o300
+SLIP_ESC = 0o333
+SLIP_ESC_END = 0o334
+SLIP_ESC_ESC = 0o335
+
+FLAG_TIMESTAMP = 0x01
+
+HEADER_TYPE_STD = 1
+HEADER_TYPE_HEXDUMP = 2
+
+SEVERITY_NAMES = [None, 'error', 'warning', 'info', 'debug']
+
+HEXDUMP_BYTES_IN_LINE = 8
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+SHT_SYMTAB = 2
+
+
+class Elf(object):
+    """Minimal ELF reader: loadable section contents and the symbol table."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[5] != 1:
+            raise ValueError('%s: not a little endian ELF file' % path)
+        is64 = self.data[4] == 2
+        if is64:
+            shoff, = struct.unpack_from('<Q', self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x3A)
+            sh_fmt, self.ptr_size = '<IIQQQQIIQQ', 8
+        else:
+            shoff, = struct.unpack_from('<I', self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+            sh_fmt, self.ptr_size = '<IIIIIIIIII', 4
+        sections = [struct.unpack_from(sh_fmt, self.data, shoff + i * shentsize)
+                    for i in range(shnum)]
+        strtab = sections[shstrndx]
+
+        self.sections = {}
+        self.regions = []
+        symtab = None
+        for (name, stype, flags, addr, offset, size, link, _, _, entsize) in sections:
+            name = self._str(strtab[4], name)
+            if (flags & SHF_ALLOC) and stype != SHT_NOBITS and size:
+                self.regions.append((addr, self.data[offset:offset + size]))
+            self.sections[name] = (addr, size)
+            if stype == SHT_SYMTAB:
+                symtab = (offset, size, entsize, sections[link][4])
+
+        self.symbols = {}
+        if symtab:
+            offset, size, entsize, str_off = symtab
+            for i in range(size // entsize):
+                if is64:
+                    name, _, _, _, value, _ = struct.unpack_from('<IBBHQQ', self.data,
+                                                                 offset + i * entsize)
+                else:
+                    name, value, _, _, _, _ = struct.unpack_from('<IIIBBH', self.data,
+                                                                 offset + i * entsize)
+                self.symbols[self._str(str_off, name)] = value
+
+    def _str(self, table_offset, index):
+        start = table_offset + index
+        return self.data[start:self.data.index(b'\0', start)].decode('ascii', 'replace')
+
+    def read(self, addr, size):
+        for (start, content) in self.regions:
+            if start <= addr and addr + size <= start + len(content):
+                return content[addr - start:addr - start + size]
+        return None
+
+    def string(self, addr):
+        for (start, content) in self.regions:
+            if start <= addr < start + len(content):
+                end = content.find(b'\0', addr - start)
+                return content[addr - start:end if end >= 0 else None].decode('latin-1')
+        return None
+
+    def pointer(self, addr):
+        raw = self.read(addr, self.ptr_size)
+        if raw is None:
+            return None
+        return struct.unpack('<Q' if self.ptr_size == 8 else '<I', raw)[0]
+
+
+def module_names_get(elf):
+    """Module names, indexed by module ID (position in the log_const_data section)."""
+    start = stop = None
+    for (s, e) in (('__start_log_const_data', '__stop_log_const_data'),
+                   ('log_const_data$$Base', 'log_const_data$$Limit')):
+        if s in elf.symbols and e in elf.symbols:
+            start, stop = elf.symbols[s], elf.symbols[e]
+            break
+    if start is None:
+        for name in ('.log_const_data', 'log_const_data'):
+            if name in elf.sections:
+                start, size = elf.sections[name]
+                stop = start + size
+                break
+    if start is None:
+        return []
+    # nrf_log_module_const_data_t: name pointer followed by three bytes, padded.
+    item_size = 2 * elf.ptr_size
+    names = []
+    for addr in range(start, stop, item_size):
+        p_name = elf.pointer(addr)
+        names.append(elf.string(p_name) if p_name is not None else None)
+    return names
+
+
+def slip_frames(stream):
+    """Generator of decoded SLIP frames read from a binary stream."""
+    frame = bytearray()
+    esc = False
+    while True:
+        chunk = stream.read(1)
+        if not chunk:
+            return
+        c = chunk[0]
+        if c == SLIP_END:
+            if frame:
+                yield bytes(frame)
+            frame = bytearray()
+            esc = False
+        elif esc:
+            frame.append(SLIP_END if c == SLIP_ESC_END else
+                         SLIP_ESC if c == SLIP_ESC_ESC else c)
+            esc = False
+        elif c == SLIP_ESC:
+            esc = True
+        else:
+            frame.append(c)
+
+
+FORMAT_SPEC = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+def format_c(fmt, args, strings, elf):
+    """Format a C format string using 32 bit arguments as the target does."""
+    arg_iter = iter(range(len(args)))
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        try:
+            i = next(arg_iter)
+        except StopIteration:
+            return match.group(0)
+        value = args[i]
+        spec = '%' + flags + width + ('.' + precision if precision else '')
+        if conv == 's':
+            s = strings.get(i)
+            if s is None:
+                s = elf.string(value)
+            if s is None:
+                s = '<0x%08x>' % value
+            return (spec + 's') % s
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 'p':
+            return '0x%08x' % value
+        if conv in 'di':
+            value = value - (1 << 32) if value & 0x80000000 else value
+            return (spec + 'd') % value
+        return (spec + conv.replace('u', 'd')) % value
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+def frame_decode(frame, elf, modules):
+    """Decode one frame into text lines."""
+    flags = frame[0]
+    header, module_id = struct.unpack_from('<IH', frame, 1)
+    offset = 7
+    timestamp = None
+    if flags & FLAG_TIMESTAMP:
+        timestamp, = struct.unpack_from('<I', frame, offset)
+        offset += 4
+
+    entry_type = header & 0x3
+    raw = (header >> 2) & 0x1
+    severity = (header >> 3) & 0x7
+
+    prefix = ''
+    if not raw:
+        if timestamp is not None:
+            prefix += '[%08u] ' % timestamp
+        module = modules[module_id] if module_id < len(modules) else None
+        prefix += '<%s> %s: ' % (SEVERITY_NAMES[severity] if severity < len(SEVERITY_NAMES)
+                                 else severity,
+                                 module if module else 'module%d' % module_id)
+
+    if entry_type == HEADER_TYPE_STD:
+        nargs = (header >> 6) & 0xF
+        addr = header >> 10
+        args = list(struct.unpack_from('<%dI' % nargs, frame, offset))
+        offset += 4 * nargs
+        strings = {}
+        if nargs:
+            pushed_mask = frame[offset]
+            offset += 1
+            for i in range(nargs):
+                if pushed_mask & (1 << i):
+                    end = frame.index(b'\0', offset)
+                    strings[i] = frame[offset:end].decode('latin-1')
+                    offset = end + 1
+        fmt = elf.string(addr)
+        if fmt is None:
+            text = '<unknown string 0x%06x> %s' % (addr, ' '.join('0x%08x' % a for a in args))
+        else:
+            text = format_c(fmt, args, strings, elf)
+        # Raw entries carry their own line endings.
+        return [prefix + text + '\n'] if not raw else [text]
+
+    if entry_type == HEADER_TYPE_HEXDUMP:
+        data = frame[offset:offset + (header >> 22)]
+        lines = []
+        for i in range(0, len(data), HEXDUMP_BYTES_IN_LINE):
+            line = data[i:i + HEXDUMP_BYTES_IN_LINE]
+            hex_part = ''.join(' %02X' % b for b in line).ljust(3 * HEXDUMP_BYTES_IN_LINE)
+            chr_part = ''.join(chr(b) if 0x20 <= b < 0x7F else '.' for b in line)
+            lines.append(prefix + hex_part + '|' + chr_part.ljust(HEXDUMP_BYTES_IN_LINE) + '\n')
+        return lines
+
+    return ['<unknown entry type %d>\n' % entry_type]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('elf', help='application ELF file')
+    parser.add_argument('input', nargs='?', default='-',
+                        help='binary log stream (file, device or - for stdin)')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    modules = module_names_get(elf)
+    stream = sys.stdin.buffer if args.input == '-' else open(args.input, 'rb', buffering=0)
+
+    for frame in slip_frames(stream):
+        try:
+            lines = frame_decode(frame, elf, modules)
+        except (IndexError, ValueError, struct.error):
+            lines = ['<corrupted frame: %s>\n' % frame.hex()]
+        for line in lines:
+            sys.stdout.write(line)
+        sys.stdout.flush()
+
+
+if __name__ == '__main__':
+    main()
@@ -167,13 +167,11 @@ void nrf_memobj_put(nrf_memobj_t * p_obj)
     }
 }
 
-static void memobj_op(nrf_memobj_t * p_obj,
-                      void * p_data,
-                      uint32_t len,
-                      uint32_t offset,
-                      bool read)
+void nrf_memobj_iter_init(nrf_memobj_iter_t * p_iter,
+                          nrf_memobj_t      * p_obj,
+                          uint32_t            len,
+                          uint32_t            offset)
 {
-
     memobj_head_t * p_head  = (memobj_head_t *)p_obj;
     uint32_t space_in_chunk = p_head->head_header.data.fields.chunk_size;
     memobj_elem_t * p_curr_chunk = (memobj_elem_t *)p_obj;
@@ -191,25 +189,76 @@ static void memobj_op(nrf_memobj_t * p_obj,
         chunk_idx--;
     }
 
-    uint32_t src_offset  = 0;
-    uint32_t curr_cpy_size = space_in_chunk-chunk_offset;
-    curr_cpy_size = curr_cpy_size > len ? len : curr_cpy_size;
+    p_iter->p_chunk      = p_curr_chunk;
+    p_iter->chunk_size   = space_in_chunk;
+    p_iter->chunk_offset = chunk_offset;
+    p_iter->remaining    = len;
+}
+
+bool nrf_memobj_iter_next(nrf_memobj_iter_t * p_iter, nrf_memobj_iovec_t * p_seg)
+{
+    memobj_elem_t * p_curr_chunk = (memobj_elem_t *)p_iter->p_chunk;
+    uint32_t curr_size = p_iter->chunk_size - p_iter->chunk_offset;
+
+    if (p_iter->remaining == 0)
+    {
+        return false;
+    }
+
+    curr_size = curr_size > p_iter->remaining ? p_iter->remaining : curr_size;
+
+    p_seg->p_data = &p_curr_chunk->data[p_iter->chunk_offset];
+    p_seg->len    = curr_size;
+
+    p_iter->remaining   -= curr_size;
+    p_iter->chunk_offset = 0;
+    p_iter->p_chunk      = p_curr_chunk->header.p_next;
+
+    return true;
+}
+
+uint32_t nrf_memobj_iovec_get(nrf_memobj_t       * p_obj,
+                              nrf_memobj_iovec_t * p_iov,
+                              uint32_t             iov_cnt,
+                              uint32_t             len,
+                              uint32_t             offset)
+{
+    nrf_memobj_iter_t iter;
+    uint32_t          cnt = 0;
+
+    nrf_memobj_iter_init(&iter, p_obj, len, offset);
+
+    while ((cnt < iov_cnt) && nrf_memobj_iter_next(&iter, &p_iov[cnt]))
+    {
+        cnt++;
+    }
+
+    return cnt;
+}
 
-    while (len)
+static void memobj_op(nrf_memobj_t * p_obj,
+                      void * p_data,
+                      uint32_t len,
+                      uint32_t offset,
+                      bool read)
+{
+    nrf_memobj_iter_t  iter;
+    nrf_memobj_iovec_t seg;
+    uint32_t src_offset = 0;
+
+    nrf_memobj_iter_init(&iter, p_obj, len, offset);
+
+    while (nrf_memobj_iter_next(&iter, &seg))
     {
         if (read)
         {
-            memcpy(&((uint8_t *)p_data)[src_offset], &p_curr_chunk->data[chunk_offset], curr_cpy_size);
+            memcpy(&((uint8_t *)p_data)[src_offset], seg.p_data, seg.len);
         }
         else
         {
-            memcpy(&p_curr_chunk->data[chunk_offset], &((uint8_t *)p_data)[src_offset], curr_cpy_size);
+            memcpy(seg.p_data, &((uint8_t *)p_data)[src_offset], seg.len);
         }
-        chunk_offset = 0;
-        p_curr_chunk = p_curr_chunk->header.p_next;
-        len -= curr_cpy_size;
-        src_offset += curr_cpy_size;
-        curr_cpy_size = (space_in_chunk > len) ? len : space_in_chunk;
+        src_offset += seg.len;
     }
 }
 
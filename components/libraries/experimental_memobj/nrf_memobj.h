@@ -48,6 +48,7 @@
 * @brief Functions for controlling memory object
 */
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include "sdk_errors.h"
 #include "nrf_balloc.h"
@@ -97,6 +98,28 @@ typedef nrf_balloc_t nrf_memobj_pool_t;
  */
 typedef void * nrf_memobj_t;
 
+/**
+ * @brief Contiguous segment of the data of a memory object.
+ */
+typedef struct
+{
+    void *   p_data;        //!< Pointer to the segment data, inside a memory object chunk.
+    uint32_t len;           //!< Length of the segment.
+} nrf_memobj_iovec_t;
+
+/**
+ * @brief Memory object segment iterator.
+ *
+ * Fields are internal, the iterator is set up with @ref nrf_memobj_iter_init.
+ */
+typedef struct
+{
+    void *   p_chunk;       //!< Chunk holding the next segment.
+    uint16_t chunk_size;    //!< Data size of a chunk.
+    uint16_t chunk_offset;  //!< Offset of the next segment in its chunk.
+    uint32_t remaining;     //!< Amount of data left to iterate over.
+} nrf_memobj_iter_t;
+
 /**
  * @brief Function for initializing the memobj pool instance.
  *
@@ -189,6 +212,52 @@ void nrf_memobj_read(nrf_memobj_t * p_obj,
                      uint32_t len,
                      uint32_t offset);
 
+/**
+ * @brief Function for setting up an iterator over the data of a memory object.
+ *
+ * The iterator returns the data between offset and offset + len as contiguous segments, each
+ * within a single chunk. This allows data to be read or written in place, for example by DMA,
+ * without copying it to or from an intermediate buffer.
+ *
+ * @param[out] p_iter Pointer to the iterator.
+ * @param[in]  p_obj  Pointer to memory object.
+ * @param[in]  len    Amount of data to iterate over.
+ * @param[in]  offset Offset.
+ */
+void nrf_memobj_iter_init(nrf_memobj_iter_t * p_iter,
+                          nrf_memobj_t      * p_obj,
+                          uint32_t            len,
+                          uint32_t            offset);
+
+/**
+ * @brief Function for getting the next segment of a memory object.
+ *
+ * @param[in,out] p_iter Pointer to the iterator.
+ * @param[out]    p_seg  Segment.
+ *
+ * @retval true  Segment returned.
+ * @retval false No more data.
+ */
+bool nrf_memobj_iter_next(nrf_memobj_iter_t * p_iter, nrf_memobj_iovec_t * p_seg);
+
+/**
+ * @brief Function for getting the segments holding the data of a memory object.
+ *
+ * @param[in]  p_obj   Pointer to memory object.
+ * @param[out] p_iov   Array to be filled with the segments.
+ * @param[in]  iov_cnt Number of elements in the array.
+ * @param[in]  len     Amount of data.
+ * @param[in]  offset  Offset.
+ *
+ * @return Number of segments returned. If the array is too small, the data beyond the last
+ *         segment can be fetched by calling the function again with an increased offset.
+ */
+uint32_t nrf_memobj_iovec_get(nrf_memobj_t       * p_obj,
+                              nrf_memobj_iovec_t * p_iov,
+                              uint32_t             iov_cnt,
+                              uint32_t             len,
+                              uint32_t             offset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,11 @@
 #include "nrf_fstorage_sd.h"
 #elif (FDS_BACKEND == NRF_FSTORAGE_NVMC)
 #include "nrf_fstorage_nvmc.h"
+#elif (FDS_BACKEND == NRF_FSTORAGE_RAM)
+#include "nrf_fstorage_ram.h"
+#if (FDS_PHY_PAGES * FDS_PHY_PAGE_SIZE * 4 > NRF_FSTORAGE_RAM_SIZE)
+#error NRF_FSTORAGE_RAM_SIZE is too small for the FDS data.
+#endif
 #else
 #error Invalid FDS backend.
 #endif
@@ -59,6 +64,10 @@
     #include "crc16.h"
 #endif
 
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    #include "app_timer.h"
+#endif
+
 
 static void fs_event_handler(nrf_fstorage_evt_t * evt);
 
@@ -89,6 +98,20 @@ static fds_swap_page_t      m_swap_page;
 // Garbage collection data.
 static fds_gc_data_t        m_gc;
 
+// Written to flash to commit batches and mark them as complete.
+// Must be statically allocated since it will be written to flash.
+__ALIGN(4) static uint32_t const m_zero_word = 0x00000000;
+
+#if (FDS_INDEX_SIZE > 0)
+// RAM index of valid records.
+static fds_index_t          m_index;
+#endif
+
+#if (FDS_BATCH_MAX_RECORDS > 0)
+// The batch being written.
+static fds_batch_t          m_batch;
+#endif
+
 
 static void flag_set(fds_flags_t flag)
 {
@@ -166,6 +189,12 @@ static void event_prepare(fds_op_t const * const p_op, fds_evt_t * const p_evt)
             p_evt->id = FDS_EVT_GC;
             break;
 
+        case FDS_OP_BATCH:
+            p_evt->id                 = FDS_EVT_BATCH;
+            p_evt->batch.record_id    = p_op->batch.record_id;
+            p_evt->batch.record_count = p_op->batch.count;
+            break;
+
         default:
             // Should not happen.
             break;
@@ -274,6 +303,8 @@ static void page_scan(uint32_t const *       p_addr,
     while ((p_addr < p_end_addr) && (*p_addr != FDS_ERASED_WORD))
     {
         // NOTE: Skip records with a dirty key or with a missing file ID.
+        // This includes the marker of a batch which was not committed before a reset; its length
+        // spans all records in the batch, which are discarded together with the marker.
         fds_header_t const * const p_header = (fds_header_t*)p_addr;
 
         if (!header_is_valid(p_header))
@@ -419,6 +450,375 @@ static bool record_find_next(uint16_t page, uint32_t const ** p_record)
 }
 
 
+#if (FDS_BATCH_MAX_RECORDS > 0)
+
+// Check whether a record is the old copy of a record updated by the batch being written, and the
+// batch has been committed. Old copies stay valid until they have been flagged as dirty one by
+// one; searches skip them so that they never return a mix of old and new records.
+// Flash scans see the new records as soon as the marker is cleared in flash, while the index
+// holds them only once the commit has completed, so each uses its own commit point.
+static bool record_is_superseded(uint32_t const * const p_record, bool from_index)
+{
+    uint32_t const * const p_marker = m_batch.p_marker;
+    bool                   committed;
+
+    if (p_marker == NULL)
+    {
+        return false;
+    }
+
+    committed = from_index ? m_batch.indexed : (p_marker[FDS_OFFSET_TL] == 0);
+    if (!committed)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < m_batch.count; i++)
+    {
+        if ((m_batch.entry[i].update) && (m_batch.entry[i].old.p_record == p_record))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#else
+
+static bool record_is_superseded(uint32_t const * const p_record, bool from_index)
+{
+    return false;
+}
+
+#endif
+
+
+#if (FDS_INDEX_SIZE > 0)
+
+static uint32_t index_key(uint16_t file_id, uint16_t record_key)
+{
+    return (((uint32_t)file_id << 16) | record_key);
+}
+
+
+// Get the position of a record in flash, as (page << 16 | offset), used to order index
+// entries with the same key.
+static uint32_t index_entry_pos(fds_index_entry_t const * const p_entry)
+{
+    return (((uint32_t)p_entry->page << 16) | p_entry->offset);
+}
+
+
+// Find the position of the first index entry which is not less than the given key and position.
+// Entries are sorted by key and, for the same key, by their position in flash.
+static uint16_t index_lower_bound(uint32_t key, uint32_t pos)
+{
+    uint16_t lo = 0;
+    uint16_t hi = m_index.count;
+
+    while (lo < hi)
+    {
+        uint16_t                  const mid     = lo + ((hi - lo) / 2);
+        fds_index_entry_t const * const p_entry = &m_index.entry[mid];
+
+        if ((p_entry->key < key) ||
+            ((p_entry->key == key) && (index_entry_pos(p_entry) < pos)))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+
+// Add a valid record to the index. If the index is full, flag it as overflowed so that
+// lookups fall back to scanning flash.
+// NOTE: Must be called from within a critical section.
+static void index_insert(uint16_t page, uint32_t const * const p_record)
+{
+    fds_header_t      const * const p_header = (fds_header_t*)p_record;
+    fds_index_entry_t               entry;
+    uint16_t                        i;
+
+    if (m_index.overflow)
+    {
+        return;
+    }
+
+    if (m_index.count == FDS_INDEX_SIZE)
+    {
+        m_index.overflow = true;
+        return;
+    }
+
+    entry.key    = index_key(p_header->file_id, p_header->record_key);
+    entry.page   = page;
+    entry.offset = (uint16_t)(p_record - m_pages[page].p_addr);
+
+    i = index_lower_bound(entry.key, index_entry_pos(&entry));
+
+    memmove(&m_index.entry[i + 1], &m_index.entry[i],
+            (m_index.count - i) * sizeof(fds_index_entry_t));
+
+    m_index.entry[i] = entry;
+    m_index.count++;
+}
+
+
+// Remove an entry from the index.
+// NOTE: Must be called from within a critical section.
+static void index_entry_remove(fds_index_entry_t const * const p_entry)
+{
+    uint16_t const i = index_lower_bound(p_entry->key, index_entry_pos(p_entry));
+
+    if ((i < m_index.count)                         &&
+        (m_index.entry[i].key    == p_entry->key)   &&
+        (m_index.entry[i].page   == p_entry->page)  &&
+        (m_index.entry[i].offset == p_entry->offset))
+    {
+        m_index.count--;
+        memmove(&m_index.entry[i], &m_index.entry[i + 1],
+                (m_index.count - i) * sizeof(fds_index_entry_t));
+    }
+}
+
+
+// Remember the entry of a record which is about to be flagged as dirty, while its header is
+// still readable. The entry is skipped by searches while the write is in progress, and removed by
+// index_dirty_end() once the write has succeeded.
+static void index_dirty_begin(uint16_t page, uint32_t const * const p_record)
+{
+    fds_header_t const * const p_header = (fds_header_t*)p_record;
+
+    CRITICAL_SECTION_ENTER();
+    m_index.dirty.key     = index_key(p_header->file_id, p_header->record_key);
+    m_index.dirty.page    = page;
+    m_index.dirty.offset  = (uint16_t)(p_record - m_pages[page].p_addr);
+    m_index.dirty_pending = true;
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Complete flagging a record as dirty. If the write failed, the record is still valid and
+// stays in the index.
+static void index_dirty_end(ret_code_t result)
+{
+    if (!m_index.dirty_pending)
+    {
+        return;
+    }
+
+    CRITICAL_SECTION_ENTER();
+    m_index.dirty_pending = false;
+
+    if ((result == NRF_SUCCESS) && !m_index.overflow)
+    {
+        index_entry_remove(&m_index.dirty);
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Index all valid records on a page.
+// NOTE: Must be called from within a critical section.
+static void index_page_add(uint16_t page)
+{
+    // Set p_record to NULL to make record_find_next() search from the beginning of the page.
+    uint32_t const * p_record = NULL;
+
+    while (!m_index.overflow && record_find_next(page, &p_record))
+    {
+        index_insert(page, p_record);
+    }
+}
+
+
+// Build the index from scratch, by scanning all data pages.
+static void index_build(void)
+{
+    CRITICAL_SECTION_ENTER();
+    m_index.count    = 0;
+    m_index.overflow = false;
+
+    for (uint16_t page = 0; page < FDS_DATA_PAGES; page++)
+    {
+        if (m_pages[page].page_type == FDS_PAGE_DATA)
+        {
+            index_page_add(page);
+        }
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Remove all entries for a page, preserving the order of the remaining ones.
+// NOTE: Must be called from within a critical section.
+static void index_page_drop(uint16_t page)
+{
+    uint16_t kept = 0;
+
+    for (uint16_t i = 0; i < m_index.count; i++)
+    {
+        if (m_index.entry[i].page != page)
+        {
+            m_index.entry[kept++] = m_index.entry[i];
+        }
+    }
+
+    m_index.count = kept;
+}
+
+
+// Remove the entries for a page which is about to be erased by garbage collection.
+static void index_page_erase(uint16_t page)
+{
+    CRITICAL_SECTION_ENTER();
+    if (!m_index.overflow)
+    {
+        index_page_drop(page);
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Index a page again after it has been garbage collected, since its records have been moved.
+static void index_page_rebuild(uint16_t page)
+{
+    CRITICAL_SECTION_ENTER();
+    if (!m_index.overflow)
+    {
+        index_page_drop(page);
+        index_page_add(page);
+    }
+    CRITICAL_SECTION_EXIT();
+}
+
+
+// Search for a record using the index. Records are returned in index order, i.e. sorted by
+// file ID, record key and position in flash. The token holds the key and the position of the last
+// record found, so that each call resumes with a binary search, even if entries were added or
+// removed in the meantime. Interrupts are only disabled for one binary search at a time.
+static ret_code_t index_find(uint16_t          const * p_file_id,
+                             uint16_t          const * p_record_key,
+                             fds_record_desc_t       * p_desc,
+                             fds_find_token_t        * p_token)
+{
+    fds_index_entry_t    entry;
+    uint32_t             key;
+    uint32_t             pos;
+    uint16_t             i;
+    uint16_t             count;
+    bool                 deleting;
+    fds_header_t const * p_header;
+
+    if (p_token->page >= FDS_DATA_PAGES)
+    {
+        return FDS_ERR_NOT_FOUND;
+    }
+
+    if (p_token->p_addr != NULL)
+    {
+        // Resume searching after the record in the token.
+        key = p_token->index_key;
+        pos = ((uint32_t)p_token->page << 16) +
+              (uint32_t)(p_token->p_addr - m_pages[p_token->page].p_addr) + 1;
+    }
+    else
+    {
+        key = index_key((p_file_id    != NULL) ? *p_file_id    : 0,
+                        (p_record_key != NULL) ? *p_record_key : 0);
+        pos = 0;
+    }
+
+    for (;;)
+    {
+        CRITICAL_SECTION_ENTER();
+        i     = index_lower_bound(key, pos);
+        count = m_index.count;
+        if (i < count)
+        {
+            entry    = m_index.entry[i];
+            deleting = m_index.dirty_pending                 &&
+                       (entry.key    == m_index.dirty.key)   &&
+                       (entry.page   == m_index.dirty.page)  &&
+                       (entry.offset == m_index.dirty.offset);
+        }
+        CRITICAL_SECTION_EXIT();
+
+        if (i == count)
+        {
+            break;
+        }
+
+        if (deleting ||
+            record_is_superseded(m_pages[entry.page].p_addr + entry.offset, true))
+        {
+            // The record is being flagged as dirty, or replaced by a committed batch.
+            key = entry.key;
+            pos = index_entry_pos(&entry) + 1;
+            continue;
+        }
+
+        if ((p_file_id != NULL) && ((entry.key >> 16) != *p_file_id))
+        {
+            // Past the end of the file.
+            break;
+        }
+
+        if ((p_record_key != NULL) && ((uint16_t)entry.key != *p_record_key))
+        {
+            if (p_file_id != NULL)
+            {
+                break;
+            }
+
+            // Searching by record key only: skip to the key in this file, or in the next one.
+            // Since FDS_FILE_ID_INVALID is never indexed, the file ID cannot overflow.
+            key = ((uint16_t)entry.key < *p_record_key) ?
+                  index_key((uint16_t)(entry.key >> 16), *p_record_key) :
+                  index_key((uint16_t)(entry.key >> 16) + 1, *p_record_key);
+            pos = 0;
+            continue;
+        }
+
+        p_token->page      = entry.page;
+        p_token->p_addr    = m_pages[entry.page].p_addr + entry.offset;
+        p_token->index_key = entry.key;
+        p_header           = (fds_header_t*)p_token->p_addr;
+
+        // Record found; update the descriptor.
+        p_desc->record_id    = p_header->record_id;
+        p_desc->p_record     = p_token->p_addr;
+        p_desc->gc_run_count = m_gc.run_count;
+
+        return FDS_SUCCESS;
+    }
+
+    // Leave the token as record_find() would after scanning every page.
+    p_token->page   = FDS_DATA_PAGES;
+    p_token->p_addr = NULL;
+
+    return FDS_ERR_NOT_FOUND;
+}
+
+#else
+
+static void index_insert(uint16_t page, uint32_t const * const p_record) {}
+static void index_dirty_begin(uint16_t page, uint32_t const * const p_record) {}
+static void index_dirty_end(ret_code_t result) {}
+static void index_build(void) {}
+static void index_page_erase(uint16_t page) {}
+static void index_page_rebuild(uint16_t page) {}
+
+#endif
+
+
 // Find a record given its descriptor and retrive the page in which the record is stored.
 // NOTE: Do not pass NULL as an argument for p_page.
 static bool record_find_by_desc(fds_record_desc_t * const p_desc, uint16_t * const p_page)
@@ -475,6 +875,16 @@ static ret_code_t record_find(uint16_t          const * p_file_id,
         return FDS_ERR_NULL_ARG;
     }
 
+#if (FDS_INDEX_SIZE > 0)
+    // Records with the same file ID and record key are returned in flash order either way. Other
+    // searches are ordered differently, so a search that continues after the index overflows
+    // can return a record twice or skip it.
+    if (!m_index.overflow)
+    {
+        return index_find(p_file_id, p_record_key, p_desc, p_token);
+    }
+#endif
+
     // Begin (or resume) searching for a record.
     for (; p_token->page < FDS_DATA_PAGES; p_token->page++)
     {
@@ -502,6 +912,11 @@ static ret_code_t record_find(uint16_t          const * p_file_id,
                 continue;
             }
 
+            if (record_is_superseded(p_token->p_addr, false))
+            {
+                continue;
+            }
+
             // Record found; update the descriptor.
             p_desc->record_id    = p_header->record_id;
             p_desc->p_record     = p_token->p_addr;
@@ -563,6 +978,20 @@ static bool queue_advance(void)
 }
 
 
+// Swap the operation being executed with the next one in the queue.
+static void queue_yield(void)
+{
+    uint32_t const next = (m_op_queue.rp + 1) % FDS_OP_QUEUE_SIZE;
+    fds_op_t       op;
+
+    CRITICAL_SECTION_ENTER();
+    op                           = m_op_queue.op[m_op_queue.rp];
+    m_op_queue.op[m_op_queue.rp] = m_op_queue.op[next];
+    m_op_queue.op[next]          = op;
+    CRITICAL_SECTION_EXIT();
+}
+
+
 // Enqueue an operation.
 static bool op_enqueue(fds_op_t const * p_op)
 {
@@ -727,12 +1156,18 @@ static ret_code_t record_header_flag_dirty(uint32_t * const p_record, uint16_t p
     // Must be statically allocated since it will be written to flash.
     __ALIGN(4) static uint32_t const dirty_header = {0xFFFF0000};
 
+    // The record is removed from the index when the write has succeeded, in fs_event_handler().
+    // Its key must be saved now, since the write overwrites it and might complete synchronously,
+    // depending on the fstorage backend.
+    index_dirty_begin(page_to_gc, p_record);
+
     // Flag the record as dirty.
     ret_code_t ret = nrf_fstorage_write(&m_fs, (uint32_t)p_record,
                             &dirty_header, FDS_HEADER_SIZE_TL * sizeof(uint32_t), NULL);
 
     if (ret != NRF_SUCCESS)
     {
+        index_dirty_end(ret);
         return FDS_ERR_BUSY;
     }
 
@@ -821,18 +1256,17 @@ static ret_code_t record_write_data(fds_op_t * const p_op, uint32_t * const p_ad
 
 static bool crc_verify_success(uint16_t crc, uint16_t len_words, uint32_t const * const p_data)
 {
-    uint16_t computed_crc;
-
     // The CRC is computed on the entire record, except the CRC field itself.
     // The record header is 12 bytes, out of these we have to skip bytes 6 to 8 where the
     // CRC itself is stored. Then we compute the CRC for the rest of the record, from byte 8 of
     // the header (where the record ID begins) to the end of the record data.
-    computed_crc = crc16_compute((uint8_t const *)p_data,  6, NULL);
-    computed_crc = crc16_compute((uint8_t const *)p_data + 8,
-                                 (FDS_HEADER_SIZE_ID + len_words) * sizeof(uint32_t),
-                                 &computed_crc);
+    crc16_chunk_t const chunks[] =
+    {
+        {(uint8_t const *)p_data,     6},
+        {(uint8_t const *)p_data + 8, (FDS_HEADER_SIZE_ID + len_words) * sizeof(uint32_t)},
+    };
 
-    return (computed_crc == crc);
+    return (crc16_compute_chunks(chunks, ARRAY_SIZE(chunks), NULL) == crc);
 }
 
 #endif
@@ -898,6 +1332,9 @@ static ret_code_t gc_page_erase(void)
 
     if (m_pages[gc].records_open == 0)
     {
+        // The records on this page are not readable until the swap has been promoted.
+        index_page_erase(gc);
+
         ret = nrf_fstorage_erase(&m_fs, (uint32_t)m_pages[gc].p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
         m_gc.state = GC_ERASE_PAGE;
     }
@@ -974,6 +1411,14 @@ static ret_code_t gc_next_page(void)
         m_gc.cur_page     = 0;
         m_gc.p_record_src = NULL;
 
+#if (FDS_INDEX_SIZE > 0)
+        // Records might have been deleted since the index overflowed; try to build it again.
+        if (m_index.overflow)
+        {
+            index_build();
+        }
+#endif
+
         return FDS_OP_COMPLETED;
     }
 
@@ -1003,6 +1448,9 @@ static void gc_swap_pages(void)
     // Keep the offset for this page, but reset it for the swap.
     m_pages[m_gc.cur_page].write_offset = m_swap_page.write_offset;
     m_swap_page.write_offset            = FDS_PAGE_TAG_SIZE;
+
+    // The records on this page have been moved.
+    index_page_rebuild(m_gc.cur_page);
 }
 
 
@@ -1018,17 +1466,21 @@ static void gc_state_advance(void)
         // A record was successfully copied.
         case GC_COPY_RECORD:
             gc_update_swap_offset();
+            m_gc.stat.records_copied++;
             m_gc.state = GC_FIND_NEXT_RECORD;
             break;
 
         // A page was successfully erased. Prepare to promote the swap.
         case GC_ERASE_PAGE:
             gc_swap_pages();
+            m_gc.stat.pages_erased++;
             m_gc.state = GC_PROMOTE_SWAP;
             break;
 
         // Swap was discarded because the page being GC'ed had open records.
         case GC_DISCARD_SWAP:
+            m_gc.stat.pages_erased++;
+            // Fallthrough.
         // Swap was sucessfully promoted.
         case GC_PROMOTE_SWAP:
             // Prepare to tag the page just GC'ed as swap.
@@ -1046,32 +1498,261 @@ static void gc_state_advance(void)
 }
 
 
-// Initialize the filesystem.
-static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
+static uint32_t gc_ticks_get(void)
 {
-    ret_code_t ret = FDS_ERR_INTERNAL;
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    return app_timer_cnt_get();
+#else
+    return 0;
+#endif
+}
 
-    if (prev_ret != NRF_SUCCESS)
+
+// Update the statistics at the end of a garbage collection slice.
+static void gc_slice_end(void)
+{
+    uint32_t ticks = 0;
+
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    ticks = app_timer_cnt_diff_compute(gc_ticks_get(), m_gc.slice_start);
+#endif
+
+    m_gc.stat.slices++;
+    m_gc.stat.ticks_total += ticks;
+
+    if (ticks > m_gc.stat.slice_ticks_max)
     {
-        // A previous operation has timed out.
-        flag_clear(FDS_FLAG_INITIALIZING);
-        return FDS_ERR_OPERATION_TIMEOUT;
+        m_gc.stat.slice_ticks_max = ticks;
     }
 
-    switch (p_op->init.step)
+    if (m_gc.slice_ops > m_gc.stat.slice_ops_max)
     {
-        case FDS_OP_INIT_TAG_SWAP:
-            // The page write offset was determined previously by pages_init().
-            ret             = page_tag_write_swap();
-            p_op->init.step = FDS_OP_INIT_TAG_DATA;
-            break;
+        m_gc.stat.slice_ops_max = m_gc.slice_ops;
+    }
 
-        case FDS_OP_INIT_TAG_DATA:
-        {
-            // Tag remaining erased pages as data.
-            bool write_reqd = false;
-            for (uint16_t i = 0; i < FDS_DATA_PAGES; i++)
-            {
+    m_gc.slice_ops = 0;
+}
+
+
+#if (FDS_GC_SLICE_OPS > 0)
+
+// Determine whether garbage collection should end the current slice and let the next operation
+// in the queue run first. While a page is being garbage collected, only writes to other pages
+// may run, since other operations might modify records which have already been copied to swap.
+// Between pages, any operation may run.
+static bool gc_slice_yield(void)
+{
+    fds_op_t const * p_next;
+
+    if (m_gc.slice_ops < FDS_GC_SLICE_OPS)
+    {
+        return false;
+    }
+
+    if (m_op_queue.count < 2)
+    {
+        // No operations are waiting. Start a new slice and carry on.
+        gc_slice_end();
+        return false;
+    }
+
+    p_next = &m_op_queue.op[(m_op_queue.rp + 1) % FDS_OP_QUEUE_SIZE];
+
+    if ((m_gc.state == GC_NEXT_PAGE) ||
+        ((p_next->op_code == FDS_OP_WRITE) && (p_next->write.page != m_gc.cur_page)))
+    {
+        gc_slice_end();
+        return true;
+    }
+
+    return false;
+}
+
+#endif
+
+
+// Returns true if a garbage collection operation is queued or being executed.
+static bool gc_is_queued(void)
+{
+    bool ret = false;
+
+    CRITICAL_SECTION_ENTER();
+    for (uint32_t i = 0; i < m_op_queue.count; i++)
+    {
+        if (m_op_queue.op[(m_op_queue.rp + i) % FDS_OP_QUEUE_SIZE].op_code == FDS_OP_GC)
+        {
+            ret = true;
+            break;
+        }
+    }
+    CRITICAL_SECTION_EXIT();
+
+    return ret;
+}
+
+
+// Enqueue a garbage collection operation. If garbage collection was interrupted by an error
+// and is not queued anymore, it will resume by retrying the last step.
+static bool gc_enqueue(void)
+{
+    fds_op_t   op;
+    bool const resume = (m_gc.state != GC_BEGIN) && !gc_is_queued();
+
+    op.op_code = FDS_OP_GC;
+
+    if (!op_enqueue(&op))
+    {
+        return false;
+    }
+
+    if (resume)
+    {
+        m_gc.resume = true;
+    }
+
+    return true;
+}
+
+
+#if (FDS_GC_AUTO_DIRTY_PERCENT > 0)
+
+// Enqueue garbage collection if dirty records take up at least FDS_GC_AUTO_DIRTY_PERCENT
+// of the flash space available for records.
+static void gc_auto_trigger(void)
+{
+    uint16_t dirty_records = 0;
+    uint16_t dirty_words   = 0;
+    uint32_t total_words   = 0;
+
+    if (gc_is_queued())
+    {
+        return;
+    }
+
+    for (uint16_t i = 0; i < FDS_DATA_PAGES; i++)
+    {
+        if (m_pages[i].page_type == FDS_PAGE_DATA)
+        {
+            dirty_records_stat(i, &dirty_records, &dirty_words);
+            total_words += (FDS_PAGE_SIZE - FDS_PAGE_TAG_SIZE);
+        }
+    }
+
+    if ((uint32_t)dirty_words * 100 < total_words * FDS_GC_AUTO_DIRTY_PERCENT)
+    {
+        return;
+    }
+
+    if (gc_enqueue())
+    {
+        m_gc.stat.auto_runs++;
+    }
+}
+
+#endif
+
+
+#if (FDS_BATCH_MAX_RECORDS > 0)
+// Determine whether a record is the marker of a batch which was committed, but not completed.
+// Such a marker has been cleared, except for its file ID and record ID, and is followed by the
+// list of records which were updated by the batch and might not have been deleted yet.
+static bool batch_is_incomplete(uint32_t const * const p_rec, uint32_t const * const p_end)
+{
+    uint32_t     const * const p_list        = p_rec + FDS_HEADER_SIZE;
+    fds_header_t const * const p_list_header = (fds_header_t const *)p_list;
+
+    return ((p_rec[FDS_OFFSET_TL] == 0)                                            &&
+            (p_rec[FDS_OFFSET_IC] == FDS_ERASED_WORD)                              &&
+            (p_rec[FDS_OFFSET_ID] == FDS_ERASED_WORD)                              &&
+            (p_list + FDS_HEADER_SIZE <= p_end)                                    &&
+            (p_list_header->record_key == FDS_RECORD_KEY_DIRTY)                    &&
+            (p_list_header->length_words != 0)                                     &&
+            (p_list[FDS_OFFSET_IC] == FDS_ERASED_WORD)                             &&
+            (p_list[FDS_OFFSET_ID] == FDS_ERASED_WORD)                             &&
+            (p_list + FDS_HEADER_SIZE + p_list_header->length_words <= p_end));
+}
+
+
+// Finds a batch which was interrupted by a reset after being committed, and deletes the next
+// record it updated. Once there are none left, the batch is marked as complete.
+// Returns FDS_ERR_NOT_FOUND if no batch needs to be completed.
+static ret_code_t batch_repair(void)
+{
+    ret_code_t ret;
+
+    for (uint16_t page = 0; page < FDS_DATA_PAGES; page++)
+    {
+        uint32_t const *       p_rec;
+        uint32_t const * const p_end = m_pages[page].p_addr + FDS_PAGE_SIZE;
+
+        if (m_pages[page].page_type != FDS_PAGE_DATA)
+        {
+            continue;
+        }
+
+        p_rec = m_pages[page].p_addr + FDS_PAGE_TAG_SIZE;
+
+        while ((p_rec < p_end) && (*p_rec != FDS_ERASED_WORD))
+        {
+            if (batch_is_incomplete(p_rec, p_end))
+            {
+                fds_header_t const * const p_list = (fds_header_t const *)(p_rec + FDS_HEADER_SIZE);
+                uint32_t     const * const p_ids  = (uint32_t const *)p_list + FDS_OFFSET_DATA;
+
+                for (uint16_t i = 0; i < p_list->length_words; i++)
+                {
+                    fds_record_desc_t desc = {0};
+                    uint16_t          rec_page;
+
+                    desc.record_id = p_ids[i];
+
+                    if (record_find_by_desc(&desc, &rec_page))
+                    {
+                        return record_header_flag_dirty((uint32_t*)desc.p_record, rec_page);
+                    }
+                }
+
+                ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_rec + FDS_OFFSET_ID),
+                                         &m_zero_word, FDS_HEADER_SIZE_ID * sizeof(uint32_t), NULL);
+
+                return (ret == NRF_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+            }
+
+            p_rec += (FDS_HEADER_SIZE + ((fds_header_t const *)p_rec)->length_words);
+        }
+    }
+
+    return FDS_ERR_NOT_FOUND;
+}
+#endif
+
+
+// Initialize the filesystem.
+static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
+{
+    ret_code_t ret = FDS_ERR_INTERNAL;
+
+    if (prev_ret != NRF_SUCCESS)
+    {
+        // A previous operation has timed out.
+        flag_clear(FDS_FLAG_INITIALIZING);
+        return FDS_ERR_OPERATION_TIMEOUT;
+    }
+
+    switch (p_op->init.step)
+    {
+        case FDS_OP_INIT_TAG_SWAP:
+            // The page write offset was determined previously by pages_init().
+            ret             = page_tag_write_swap();
+            p_op->init.step = FDS_OP_INIT_TAG_DATA;
+            break;
+
+        case FDS_OP_INIT_TAG_DATA:
+        {
+            // Tag remaining erased pages as data.
+            bool write_reqd = false;
+            for (uint16_t i = 0; i < FDS_DATA_PAGES; i++)
+            {
                 if (m_pages[i].page_type == FDS_PAGE_ERASED)
                 {
                     ret = page_tag_write_data(m_pages[i].p_addr);
@@ -1080,14 +1761,32 @@ static ret_code_t init_execute(uint32_t prev_ret, fds_op_t * const p_op)
                     break;
                 }
             }
-            if (!write_reqd)
+            if (write_reqd)
+            {
+                break;
+            }
+#if (FDS_BATCH_MAX_RECORDS > 0)
+            p_op->init.step = FDS_OP_INIT_BATCH_REPAIR;
+        }
+        // Fallthrough to FDS_OP_INIT_BATCH_REPAIR.
+
+        case FDS_OP_INIT_BATCH_REPAIR:
+            ret = batch_repair();
+            if (ret == FDS_ERR_NOT_FOUND)
             {
+                index_build();
                 flag_set(FDS_FLAG_INITIALIZED);
                 flag_clear(FDS_FLAG_INITIALIZING);
                 return FDS_OP_COMPLETED;
             }
+            break;
+#else
+            index_build();
+            flag_set(FDS_FLAG_INITIALIZED);
+            flag_clear(FDS_FLAG_INITIALIZING);
+            return FDS_OP_COMPLETED;
         }
-        break;
+#endif
 
         case FDS_OP_INIT_ERASE_SWAP:
             ret = nrf_fstorage_erase(&m_fs, (uint32_t)m_swap_page.p_addr, FDS_PHY_PAGES_IN_VPAGE, NULL);
@@ -1193,6 +1892,11 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
             break;
 
         case FDS_OP_WRITE_FLAG_DIRTY:
+            // The new copy of the record is complete.
+            CRITICAL_SECTION_ENTER();
+            index_insert(p_op->write.page, p_write_addr);
+            CRITICAL_SECTION_EXIT();
+
             ret = record_header_flag_dirty((uint32_t*)desc.p_record, page);
             p_op->write.step = FDS_OP_WRITE_DONE;
             break;
@@ -1200,6 +1904,14 @@ static ret_code_t write_execute(uint32_t prev_ret, fds_op_t * const p_op)
         case FDS_OP_WRITE_DONE:
             ret = FDS_OP_COMPLETED;
 
+            if (p_op->op_code == FDS_OP_WRITE)
+            {
+                // Updates index the record in FDS_OP_WRITE_FLAG_DIRTY instead.
+                CRITICAL_SECTION_ENTER();
+                index_insert(p_op->write.page, p_write_addr);
+                CRITICAL_SECTION_EXIT();
+            }
+
 #if (FDS_CRC_CHECK_ON_WRITE)
             if (!crc_verify_success(p_op->write.header.crc16,
                                     p_op->write.header.length_words,
@@ -1266,6 +1978,299 @@ static ret_code_t delete_execute(uint32_t prev_ret, fds_op_t * const p_op)
 }
 
 
+#if (FDS_BATCH_MAX_RECORDS > 0)
+
+// Locate the records which are updated by the batch. Like for updates, the batch fails if one of
+// them can't be found, so that queuing several updates of the same record doesn't make duplicates.
+static ret_code_t batch_records_find(fds_op_t const * const p_op)
+{
+    for (uint16_t i = 0; i < p_op->batch.count; i++)
+    {
+        fds_batch_entry_t * const p_entry = &m_batch.entry[i];
+        uint16_t                  page;
+
+        if (!p_entry->update)
+        {
+            continue;
+        }
+
+        // Force a search, to make sure the record has not been deleted already.
+        p_entry->old.p_record = NULL;
+
+        if (!record_find_by_desc(&p_entry->old, &page))
+        {
+            return FDS_ERR_NOT_FOUND;
+        }
+    }
+
+    return FDS_SUCCESS;
+}
+
+
+// Write the batch marker, which hides the records in the batch until it is committed.
+static ret_code_t batch_marker_write(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t ret;
+
+    m_batch.marker   = ((uint32_t)m_batch.length_words << 16) | FDS_BATCH_KEY;
+    m_batch.p_marker = p_addr;
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_TL),
+                             &m_batch.marker, FDS_HEADER_SIZE_TL * sizeof(uint32_t), NULL);
+
+    if (ret != NRF_SUCCESS)
+    {
+        // Nothing was written; the reserved space is freed.
+        return FDS_ERR_BUSY;
+    }
+
+    p_op->batch.step   = (m_batch.list_words != 0) ? FDS_OP_BATCH_LIST : FDS_OP_BATCH_HEADER;
+    p_op->batch.idx    = 0;
+    p_op->batch.offset = FDS_HEADER_SIZE + m_batch.list_words;
+
+    return FDS_SUCCESS;
+}
+
+
+// Write the list of the records which are to be deleted once the batch is committed, so that
+// they can be deleted after a reset too.
+static ret_code_t batch_list_write(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t ret;
+
+    p_op->batch.step = FDS_OP_BATCH_HEADER;
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_HEADER_SIZE),
+                             m_batch.list, m_batch.list_words * sizeof(uint32_t), NULL);
+
+    return (ret == NRF_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Move on to the next record in the batch, or to the commit once all records are written.
+static void batch_record_next(fds_op_t * const p_op)
+{
+    fds_header_t const * const p_header = &m_batch.entry[p_op->batch.idx].header;
+
+    p_op->batch.offset += FDS_HEADER_SIZE + p_header->length_words;
+    p_op->batch.idx++;
+
+    p_op->batch.step = (p_op->batch.idx < p_op->batch.count) ? FDS_OP_BATCH_HEADER :
+                                                                 FDS_OP_BATCH_COMMIT;
+}
+
+
+// Write the whole header of a record at once. The record can't be found before the batch is
+// committed, so there is no need to write the header in several steps as for single records.
+static ret_code_t batch_header_write(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t                      ret;
+    fds_batch_entry_t const * const p_entry = &m_batch.entry[p_op->batch.idx];
+    uint32_t                * const p_rec   = p_addr + p_op->batch.offset;
+
+    if ((p_entry->p_data != NULL) && (p_entry->header.length_words != 0))
+    {
+        p_op->batch.step = FDS_OP_BATCH_DATA;
+    }
+    else
+    {
+        batch_record_next(p_op);
+    }
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)p_rec,
+                             &p_entry->header, FDS_HEADER_SIZE * sizeof(uint32_t), NULL);
+
+    return (ret == NRF_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+static ret_code_t batch_data_write(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t                      ret;
+    fds_batch_entry_t const * const p_entry = &m_batch.entry[p_op->batch.idx];
+    uint32_t                * const p_rec   = p_addr + p_op->batch.offset;
+
+    batch_record_next(p_op);
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_rec + FDS_OFFSET_DATA), p_entry->p_data,
+                             p_entry->header.length_words * sizeof(uint32_t), NULL);
+
+    return (ret == NRF_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Commit the batch. Clearing the first word of the marker turns it into a dirty record with no
+// data, so that the records which follow it become visible all at once.
+static ret_code_t batch_commit(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t ret;
+
+    p_op->batch.step = FDS_OP_BATCH_FLAG_DIRTY;
+    p_op->batch.idx  = 0;
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_TL),
+                             &m_zero_word, FDS_HEADER_SIZE_TL * sizeof(uint32_t), NULL);
+
+    return (ret == NRF_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Flag the old copy of the next updated record as dirty. Once there are none left, mark the
+// batch as complete, so that the list of records to delete is not processed again on init.
+static ret_code_t batch_flag_dirty(fds_op_t * const p_op, uint32_t * const p_addr)
+{
+    ret_code_t ret;
+
+    while (p_op->batch.idx < p_op->batch.count)
+    {
+        fds_batch_entry_t * const p_entry = &m_batch.entry[p_op->batch.idx++];
+        uint16_t                  page;
+
+        // The same record might be updated more than once in the batch.
+        if ((p_entry->update) &&
+            (record_find_by_desc(&p_entry->old, &page)) &&
+            (header_is_valid((fds_header_t const *)p_entry->old.p_record)))
+        {
+            return record_header_flag_dirty((uint32_t*)p_entry->old.p_record, page);
+        }
+    }
+
+    if (m_batch.list_words == 0)
+    {
+        return FDS_OP_COMPLETED;
+    }
+
+    p_op->batch.step = FDS_OP_BATCH_DONE;
+
+    ret = nrf_fstorage_write(&m_fs, (uint32_t)(p_addr + FDS_OFFSET_ID),
+                             &m_zero_word, FDS_HEADER_SIZE_ID * sizeof(uint32_t), NULL);
+
+    return (ret == NRF_SUCCESS) ? FDS_SUCCESS : FDS_ERR_BUSY;
+}
+
+
+// Executes batch operations.
+static ret_code_t batch_execute(uint32_t prev_ret, fds_op_t * const p_op)
+{
+    ret_code_t         ret;
+    uint32_t   *       p_batch_addr;
+    fds_page_t * const p_page = &m_pages[p_op->batch.page];
+
+    // The batch marker is written at the beginning of the space reserved for the batch.
+    p_batch_addr = (uint32_t*)(p_page->p_addr + p_page->write_offset);
+
+    if (prev_ret != NRF_SUCCESS)
+    {
+        // The previous operation has timed out.
+        ret = FDS_ERR_OPERATION_TIMEOUT;
+    }
+    else
+    {
+        switch (p_op->batch.step)
+        {
+            case FDS_OP_BATCH_FIND_RECORDS:
+                ret = batch_records_find(p_op);
+                if (ret != FDS_SUCCESS)
+                {
+                    break;
+                }
+                // Fallthrough to FDS_OP_BATCH_BEGIN.
+
+            case FDS_OP_BATCH_BEGIN:
+                ret = batch_marker_write(p_op, p_batch_addr);
+                break;
+
+            case FDS_OP_BATCH_LIST:
+                ret = batch_list_write(p_op, p_batch_addr);
+                break;
+
+            case FDS_OP_BATCH_HEADER:
+                ret = batch_header_write(p_op, p_batch_addr);
+                break;
+
+            case FDS_OP_BATCH_DATA:
+                ret = batch_data_write(p_op, p_batch_addr);
+                break;
+
+            case FDS_OP_BATCH_COMMIT:
+                ret = batch_commit(p_op, p_batch_addr);
+                break;
+
+            case FDS_OP_BATCH_FLAG_DIRTY:
+                if (p_op->batch.idx == 0)
+                {
+                    // The batch has been committed: index the new records.
+                    uint32_t const * p_rec = p_batch_addr + FDS_HEADER_SIZE + m_batch.list_words;
+
+                    CRITICAL_SECTION_ENTER();
+                    for (uint16_t i = 0; i < p_op->batch.count; i++)
+                    {
+                        index_insert(p_op->batch.page, p_rec);
+                        p_rec += FDS_HEADER_SIZE + m_batch.entry[i].header.length_words;
+                    }
+                    m_batch.indexed = true;
+                    CRITICAL_SECTION_EXIT();
+                }
+                ret = batch_flag_dirty(p_op, p_batch_addr);
+                break;
+
+            case FDS_OP_BATCH_DONE:
+                ret = FDS_OP_COMPLETED;
+                break;
+
+            default:
+                ret = FDS_ERR_INTERNAL;
+                break;
+        }
+    }
+
+    if (ret == FDS_SUCCESS)
+    {
+        return FDS_OP_EXECUTING;
+    }
+
+#if (FDS_CRC_CHECK_ON_WRITE)
+    if (ret == FDS_OP_COMPLETED)
+    {
+        uint32_t const * p_rec = p_batch_addr + FDS_HEADER_SIZE + m_batch.list_words;
+
+        for (uint16_t i = 0; i < p_op->batch.count; i++)
+        {
+            fds_header_t const * const p_header = &m_batch.entry[i].header;
+
+            if (!crc_verify_success(p_header->crc16, p_header->length_words, p_rec))
+            {
+                ret = FDS_ERR_CRC_CHECK_FAILED;
+            }
+
+            p_rec += FDS_HEADER_SIZE + p_header->length_words;
+        }
+    }
+#endif
+
+    // There won't be another callback for this operation. Once the marker has been written
+    // the space is taken, even if the batch failed: the marker hides whatever was written.
+    CRITICAL_SECTION_ENTER();
+    if ((p_op->batch.step == FDS_OP_BATCH_FIND_RECORDS) ||
+        (p_op->batch.step == FDS_OP_BATCH_BEGIN))
+    {
+        write_space_free(m_batch.length_words, p_op->batch.page);
+    }
+    else
+    {
+        page_offsets_update(p_page, m_batch.length_words);
+    }
+    m_batch.p_marker = NULL;
+    m_batch.indexed  = false;
+    m_batch.queued   = false;
+    CRITICAL_SECTION_EXIT();
+
+    return ret;
+}
+
+#endif
+
+
 static ret_code_t gc_execute(uint32_t prev_ret)
 {
     ret_code_t ret;
@@ -1284,6 +2289,20 @@ static ret_code_t gc_execute(uint32_t prev_ret)
         gc_state_advance();
     }
 
+#if (FDS_GC_SLICE_OPS > 0)
+    if (gc_slice_yield())
+    {
+        // The state has already been advanced; execute it when garbage collection resumes.
+        m_gc.resume = true;
+        return FDS_OP_YIELD;
+    }
+#endif
+
+    if (m_gc.slice_ops == 0)
+    {
+        m_gc.slice_start = gc_ticks_get();
+    }
+
     switch (m_gc.state)
     {
         case GC_NEXT_PAGE:
@@ -1316,7 +2335,22 @@ static ret_code_t gc_execute(uint32_t prev_ret)
             break;
     }
 
-    // Either FDS_OP_EXECUTING, FDS_OP_COMPLETED, FDS_ERR_BUSY or FDS_ERR_INTERNAL.
+    if (ret == FDS_OP_EXECUTING)
+    {
+        m_gc.slice_ops++;
+        m_gc.stat.flash_ops++;
+    }
+    else
+    {
+        gc_slice_end();
+
+        if (ret == FDS_OP_COMPLETED)
+        {
+            m_gc.stat.runs++;
+        }
+    }
+
+    // Either FDS_OP_EXECUTING, FDS_OP_COMPLETED, FDS_OP_YIELD, FDS_ERR_BUSY or FDS_ERR_INTERNAL.
     return ret;
 }
 
@@ -1346,12 +2380,24 @@ static void queue_process(ret_code_t result)
             ret = gc_execute(result);
             break;
 
+#if (FDS_BATCH_MAX_RECORDS > 0)
+        case FDS_OP_BATCH:
+            ret = batch_execute(result, p_op);
+            break;
+#endif
+
         default:
             ret = FDS_ERR_INTERNAL;
             break;
     }
 
-    if (ret != FDS_OP_EXECUTING)
+    if (ret == FDS_OP_YIELD)
+    {
+        // Run the next operation first, then resume garbage collection.
+        queue_yield();
+        queue_process(NRF_SUCCESS);
+    }
+    else if (ret != FDS_OP_EXECUTING)
     {
         fds_evt_t evt;
 
@@ -1369,6 +2415,17 @@ static void queue_process(ret_code_t result)
         event_prepare(p_op, &evt);
         event_send(&evt);
 
+#if (FDS_GC_AUTO_DIRTY_PERCENT > 0)
+        if ((ret == FDS_OP_COMPLETED)              &&
+            ((p_op->op_code == FDS_OP_UPDATE)     ||
+             (p_op->op_code == FDS_OP_DEL_RECORD) ||
+             (p_op->op_code == FDS_OP_DEL_FILE)   ||
+             (p_op->op_code == FDS_OP_BATCH)))
+        {
+            gc_auto_trigger();
+        }
+#endif
+
         // Advance the queue, and if there are any queued operations, process them.
         if (queue_advance())
         {
@@ -1396,6 +2453,7 @@ static void queue_start(void)
 
 static void fs_event_handler(nrf_fstorage_evt_t * p_evt)
 {
+    index_dirty_end(p_evt->result);
     queue_process(p_evt->result);
 }
 
@@ -1471,14 +2529,16 @@ static ret_code_t write_enqueue(fds_record_desc_t         * const p_desc,
     }
 
 #if (FDS_CRC_CHECK_ON_READ)
-    // First, compute the CRC for the first 6 bytes of the header which contain the
-    // record key, length and file ID, then, compute the CRC of the record ID (4 bytes).
-    crc = crc16_compute((uint8_t*)&op.write.header,           6, NULL);
-    crc = crc16_compute((uint8_t*)&op.write.header.record_id, 4, &crc);
-
-    // Compute the CRC for the record data.
-    crc = crc16_compute((uint8_t*)p_record->data.p_data,
-                        p_record->data.length_words * sizeof(uint32_t), &crc);
+    // Compute the CRC over the first 6 bytes of the header which contain the record key,
+    // length and file ID, the record ID (4 bytes) and the record data, in one pass.
+    crc16_chunk_t const chunks[] =
+    {
+        {&op.write.header,           6},
+        {&op.write.header.record_id, 4},
+        {p_record->data.p_data,      p_record->data.length_words * sizeof(uint32_t)},
+    };
+
+    crc = crc16_compute_chunks(chunks, ARRAY_SIZE(chunks), NULL);
 #endif
 
     op.write.header.crc16 = crc;
@@ -1535,11 +2595,15 @@ ret_code_t fds_register(fds_cb_t cb)
 
 static uint32_t flash_end_addr()
 {
+#if (FDS_BACKEND == NRF_FSTORAGE_RAM)
+    return nrf_fstorage_ram_end_addr();
+#else
     uint32_t const bootloader_addr = NRF_UICR->NRFFW[0];
     uint32_t const page_sz         = NRF_FICR->CODEPAGESIZE;
     uint32_t const code_sz         = NRF_FICR->CODESIZE;
 
     return (bootloader_addr != 0xFFFFFFFF) ? bootloader_addr : (code_sz * page_sz);
+#endif
 }
 
 
@@ -1580,6 +2644,8 @@ ret_code_t fds_init(void)
     ret = nrf_fstorage_init(&m_fs, &nrf_fstorage_sd, NULL);
 #elif (FDS_BACKEND == NRF_FSTORAGE_NVMC)
     ret = nrf_fstorage_init(&m_fs, &nrf_fstorage_nvmc, NULL);
+#elif (FDS_BACKEND == NRF_FSTORAGE_RAM)
+    ret = nrf_fstorage_init(&m_fs, &nrf_fstorage_ram, NULL);
 #else
     #error Invalid FDS_BACKEND.
 #endif
@@ -1603,11 +2669,19 @@ ret_code_t fds_init(void)
             return FDS_ERR_NO_PAGES;
 
         case ALREADY_INSTALLED:
+#if (FDS_BATCH_MAX_RECORDS > 0)
+            // Only batches interrupted by a reset might need to be completed. If there are
+            // none, the application is notified immediately.
+            op.init.step = FDS_OP_INIT_BATCH_REPAIR;
+            break;
+#else
             // No initialization is necessary. Notify the application immediately.
+            index_build();
             flag_set(FDS_FLAG_INITIALIZED);
             flag_clear(FDS_FLAG_INITIALIZING);
             event_send(&evt_success);
             return FDS_SUCCESS;
+#endif
 
         case FRESH_INSTALL:
         case TAG_SWAP:
@@ -1828,6 +2902,182 @@ ret_code_t fds_record_update(fds_record_desc_t       * const p_desc,
 }
 
 
+ret_code_t fds_batch_write(fds_batch_record_t const * const p_records, uint16_t count)
+{
+#if (FDS_BATCH_MAX_RECORDS > 0)
+    ret_code_t ret;
+    fds_op_t   op;
+    uint16_t   page;
+    uint16_t   updates      = 0;
+    uint32_t   length_words = 0;
+
+    if (!flag_is_set(FDS_FLAG_INITIALIZED))
+    {
+        return FDS_ERR_NOT_INITIALIZED;
+    }
+
+    if (p_records == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    if ((count == 0) || (count > FDS_BATCH_MAX_RECORDS))
+    {
+        return FDS_ERR_INVALID_ARG;
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        fds_record_t const * const p_record = p_records[i].p_record;
+
+        if (p_record == NULL)
+        {
+            return FDS_ERR_NULL_ARG;
+        }
+
+        if ((p_record->file_id == FDS_FILE_ID_INVALID) ||
+            (p_record->key     == FDS_RECORD_KEY_DIRTY))
+        {
+            return FDS_ERR_INVALID_ARG;
+        }
+
+        if (!is_word_aligned(p_record->data.p_data))
+        {
+            return FDS_ERR_UNALIGNED_ADDR;
+        }
+
+        if (p_records[i].p_desc != NULL)
+        {
+            updates++;
+        }
+
+        length_words += FDS_HEADER_SIZE + p_record->data.length_words;
+    }
+
+    if (updates != 0)
+    {
+        // The list of records to delete.
+        length_words += FDS_HEADER_SIZE + updates;
+    }
+
+    // The batch marker takes a record header, which write_space_reserve() accounts for.
+    if (length_words >= FDS_PAGE_SIZE - FDS_PAGE_TAG_SIZE - FDS_HEADER_SIZE)
+    {
+        return FDS_ERR_RECORD_TOO_LARGE;
+    }
+
+    CRITICAL_SECTION_ENTER();
+    if (m_batch.queued)
+    {
+        ret = FDS_ERR_BUSY;
+    }
+    else
+    {
+        m_batch.queued = true;
+        ret            = FDS_SUCCESS;
+    }
+    CRITICAL_SECTION_EXIT();
+
+    if (ret != FDS_SUCCESS)
+    {
+        return ret;
+    }
+
+    ret = write_space_reserve(length_words, &page);
+
+    if (ret != FDS_SUCCESS)
+    {
+        m_batch.queued = false;
+        return ret;
+    }
+
+    // The list is a dirty record, so that it is never found, with an erased file ID and record ID.
+    m_batch.list[FDS_OFFSET_TL] = ((uint32_t)updates << 16) | FDS_RECORD_KEY_DIRTY;
+    m_batch.list[FDS_OFFSET_IC] = FDS_ERASED_WORD;
+    m_batch.list[FDS_OFFSET_ID] = FDS_ERASED_WORD;
+    m_batch.list_words          = 0;
+    m_batch.count               = count;
+
+    // Assign consecutive record IDs to the records in the batch.
+    CRITICAL_SECTION_ENTER();
+    op.batch.record_id  = m_latest_rec_id + 1;
+    m_latest_rec_id    += count;
+    CRITICAL_SECTION_EXIT();
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        fds_record_t      const * const p_record = p_records[i].p_record;
+        fds_batch_entry_t       * const p_entry  = &m_batch.entry[i];
+        uint16_t                        crc      = 0;
+
+        p_entry->p_data              = p_record->data.p_data;
+        p_entry->header.record_id    = op.batch.record_id + i;
+        p_entry->header.file_id      = p_record->file_id;
+        p_entry->header.record_key   = p_record->key;
+        p_entry->header.length_words = p_record->data.length_words;
+        p_entry->update              = (p_records[i].p_desc != NULL);
+
+        if (p_entry->update)
+        {
+            p_entry->old = *p_records[i].p_desc;
+            m_batch.list[FDS_OFFSET_DATA + m_batch.list_words++] = p_entry->old.record_id;
+        }
+
+#if (FDS_CRC_CHECK_ON_READ)
+        crc16_chunk_t const chunks[] =
+        {
+            {&p_entry->header,           6},
+            {&p_entry->header.record_id, 4},
+            {p_record->data.p_data,      p_record->data.length_words * sizeof(uint32_t)},
+        };
+
+        crc = crc16_compute_chunks(chunks, ARRAY_SIZE(chunks), NULL);
+#endif
+
+        p_entry->header.crc16 = crc;
+    }
+
+    m_batch.list_words   = (updates != 0) ? (FDS_HEADER_SIZE + updates) : 0;
+    m_batch.length_words = (uint16_t)length_words;
+
+    op.op_code     = FDS_OP_BATCH;
+    op.batch.step  = FDS_OP_BATCH_FIND_RECORDS;
+    op.batch.page  = page;
+    op.batch.count = count;
+
+    if (!op_enqueue(&op))
+    {
+        CRITICAL_SECTION_ENTER();
+        write_space_free(m_batch.length_words, page);
+        m_batch.queued = false;
+        CRITICAL_SECTION_EXIT();
+
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+    }
+
+    // Update the descriptors of the records being updated to describe the new records.
+    for (uint16_t i = 0; i < count; i++)
+    {
+        fds_record_desc_t * const p_desc = p_records[i].p_desc;
+
+        if (p_desc != NULL)
+        {
+            p_desc->p_record       = NULL;
+            p_desc->record_id      = m_batch.entry[i].header.record_id;
+            p_desc->record_is_open = false;
+            p_desc->gc_run_count   = m_gc.run_count;
+        }
+    }
+
+    queue_start();
+
+    return FDS_SUCCESS;
+#else
+    return FDS_ERR_INVALID_ARG;
+#endif
+}
+
+
 ret_code_t fds_record_delete(fds_record_desc_t * const p_desc)
 {
     fds_op_t op;
@@ -1886,23 +3136,13 @@ ret_code_t fds_file_delete(uint16_t file_id)
 
 ret_code_t fds_gc(void)
 {
-    fds_op_t op;
-
     if (!flag_is_set(FDS_FLAG_INITIALIZED))
     {
         return FDS_ERR_NOT_INITIALIZED;
     }
 
-    op.op_code = FDS_OP_GC;
-
-    if (op_enqueue(&op))
+    if (gc_enqueue())
     {
-        if (m_gc.state != GC_BEGIN)
-        {
-            // Resume GC by retrying the last step.
-            m_gc.resume = true;
-        }
-
         queue_start();
         return FDS_SUCCESS;
     }
@@ -2017,4 +3257,20 @@ ret_code_t fds_stat(fds_stat_t * const p_stat)
     return FDS_SUCCESS;
 }
 
+
+
+ret_code_t fds_gc_stat(fds_gc_stat_t * const p_stat)
+{
+    if (p_stat == NULL)
+    {
+        return FDS_ERR_NULL_ARG;
+    }
+
+    CRITICAL_SECTION_ENTER();
+    *p_stat = m_gc.stat;
+    CRITICAL_SECTION_EXIT();
+
+    return FDS_SUCCESS;
+}
+
 #endif //NRF_MODULE_ENABLED(FDS)
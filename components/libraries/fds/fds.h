@@ -158,6 +158,19 @@ typedef struct
 } fds_record_t;
 
 
+/**@brief   A record to be written as part of a batch, see @ref fds_batch_write. */
+typedef struct
+{
+    fds_record_t      const * p_record; //!< The record to be written.
+    /**@brief   The descriptor of the record to update, or NULL to write a new record.
+     *
+     * If not NULL, the record described by @p p_desc is deleted once the batch has been
+     * committed, and @p p_desc is updated to describe the new record.
+     */
+    fds_record_desc_t       * p_desc;
+} fds_batch_record_t;
+
+
 /**@brief   A token to a reserved space in flash, created by @ref fds_reserve.
  *
  * This token can be used to write the record in the reserved space (@ref fds_record_write_reserved)
@@ -178,8 +191,9 @@ typedef struct
  */
 typedef struct
 {
-    uint32_t const * p_addr;
-    uint16_t         page;
+    uint32_t const * p_addr;    //!< Address of the last record found.
+    uint16_t         page;      //!< Page of the last record found.
+    uint32_t         index_key; //!< Key of the last record found, used by the RAM index (FDS_INDEX_SIZE).
 } fds_find_token_t;
 
 
@@ -192,7 +206,8 @@ typedef enum
     FDS_EVT_UPDATE,     //!< Event for @ref fds_record_update.
     FDS_EVT_DEL_RECORD, //!< Event for @ref fds_record_delete.
     FDS_EVT_DEL_FILE,   //!< Event for @ref fds_file_delete.
-    FDS_EVT_GC          //!< Event for @ref fds_gc.
+    FDS_EVT_GC,         //!< Event for @ref fds_gc.
+    FDS_EVT_BATCH       //!< Event for @ref fds_batch_write.
 } fds_evt_id_t;
 
 
@@ -230,6 +245,11 @@ typedef struct
             uint16_t pages_skipped;
             uint16_t space_reclaimed;
         } gc;
+        struct
+        {
+            uint32_t record_id;     //!< The record ID of the first record; the others follow in order.
+            uint16_t record_count;  //!< The number of records in the batch.
+        } batch; //!< Information for @ref FDS_EVT_BATCH events.
     };
 } fds_evt_t;
 
@@ -264,6 +284,26 @@ typedef struct
 } fds_stat_t;
 
 
+/**@brief   Garbage collection statistics.
+ *
+ * Garbage collection runs in slices of at most @ref FDS_GC_SLICE_OPS flash operations. Between
+ * slices, queued operations are allowed to run. Times are in app_timer ticks, and are only
+ * recorded if the app_timer module is enabled.
+ */
+typedef struct
+{
+    uint32_t runs;              //!< The number of completed garbage collection cycles.
+    uint32_t auto_runs;         //!< The number of cycles queued because of @ref FDS_GC_AUTO_DIRTY_PERCENT.
+    uint32_t slices;            //!< The number of slices executed.
+    uint32_t flash_ops;         //!< The total number of flash operations issued by garbage collection.
+    uint32_t records_copied;    //!< The number of records copied to the swap page.
+    uint32_t pages_erased;      //!< The number of pages erased, including discarded swap pages.
+    uint32_t slice_ops_max;     //!< The largest number of flash operations in one slice.
+    uint32_t slice_ticks_max;   //!< The longest slice, in app_timer ticks.
+    uint32_t ticks_total;       //!< The total time spent in garbage collection, in app_timer ticks.
+} fds_gc_stat_t;
+
+
 /**@brief   FDS event handler function prototype.
  *
  * @param   p_evt   The event.
@@ -496,6 +536,46 @@ ret_code_t fds_record_update(fds_record_desc_t       * p_desc,
                              fds_record_t      const * p_record);
 
 
+/**@brief   Function for writing and updating several records atomically.
+ *
+ * The records are written back to back on the same page, enclosed in a batch which is committed
+ * by a single flash word write once all records have been written. Until then, none of the
+ * records can be found. If the device resets before the batch is committed, the records are
+ * discarded when the file system is initialized, and the space they take is reclaimed by
+ * garbage collection. Records that are updated are deleted after the batch has been committed;
+ * while they are being deleted, searches skip them, so a search never returns a mix of old and
+ * new records. If the device resets before they have all been deleted, the remaining ones are
+ * deleted when the file system is initialized. If deleting one of them fails, the batch is
+ * reported with an error, and both copies of the remaining records can be found until the file
+ * system is initialized again.
+ *
+ * The restrictions on the file ID and the record key are the same as for
+ * @ref fds_record_write. Record data must be aligned to a 4 byte boundary and must be kept in
+ * memory until the callback for the operation has been received. The array of records is copied
+ * and does not have to be kept in memory. The batch, including a record header for each record
+ * and a three word batch marker, must fit in a single virtual page.
+ *
+ * Only one batch can be queued at a time. This function is asynchronous. Completion of the whole
+ * batch is reported through a single @ref FDS_EVT_BATCH event.
+ *
+ * @param[in]   p_records   The records to write.
+ * @param[in]   count       The number of records; at most @ref FDS_BATCH_MAX_RECORDS.
+ *
+ * @retval  FDS_SUCCESS                 If the operation was queued successfully.
+ * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_records or one of the records is NULL.
+ * @retval  FDS_ERR_INVALID_ARG         If @p count is zero or too large, or if a file ID or
+ *                                      record key is invalid.
+ * @retval  FDS_ERR_UNALIGNED_ADDR      If the data of a record is not aligned to a 4 byte boundary.
+ * @retval  FDS_ERR_BUSY                If a batch is already queued.
+ * @retval  FDS_ERR_RECORD_TOO_LARGE    If the batch does not fit in a virtual page.
+ * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
+ * @retval  FDS_ERR_NO_SPACE_IN_FLASH   If there is not enough free space on any page to store
+ *                                      the batch.
+ */
+ret_code_t fds_batch_write(fds_batch_record_t const * p_records, uint16_t count);
+
+
 /**@brief   Function for iterating through all records in flash.
  *
  * To search for the next record, call the function again and supply the same @ref fds_find_token_t
@@ -632,6 +712,11 @@ ret_code_t fds_record_close(fds_record_desc_t * p_desc);
  * This function is asynchronous. Completion is reported through an event that is sent to the
  * registered event handler function.
  *
+ * If @ref FDS_GC_SLICE_OPS is non-zero, garbage collection is split into slices, and queued write
+ * operations are executed between slices. If @ref FDS_GC_AUTO_DIRTY_PERCENT is non-zero, garbage
+ * collection is also queued automatically when enough flash is taken by deleted records; an
+ * @ref FDS_EVT_GC event is sent in that case too.
+ *
  * @retval  FDS_SUCCESS                 If the operation was queued successfully.
  * @retval  FDS_ERR_NOT_INITIALIZED     If the module is not initialized.
  * @retval  FDS_ERR_NO_SPACE_IN_QUEUES  If the operation queue is full.
@@ -693,6 +778,16 @@ ret_code_t fds_record_id_from_desc(fds_record_desc_t const * p_desc,
 ret_code_t fds_stat(fds_stat_t * p_stat);
 
 
+/**@brief   Function for retrieving garbage collection statistics.
+ *
+ * @param[out]  p_stat      Garbage collection statistics.
+ *
+ * @retval  FDS_SUCCESS                 If the statistics were returned successfully.
+ * @retval  FDS_ERR_NULL_ARG            If @p p_stat is NULL.
+ */
+ret_code_t fds_gc_stat(fds_gc_stat_t * p_stat);
+
+
 /** @} */
 
 
@@ -63,6 +63,13 @@ extern "C" {
 
 #define FDS_ERASED_WORD         (0xFFFFFFFF)
 
+// The record key of the marker which opens a batch. The marker is never valid: its file ID is
+// left erased, and its length spans the records in the batch so that they are skipped until the
+// batch is committed by zeroing the first word of the marker. If the batch updates records, the
+// marker is followed by a dirty record which lists the IDs of the records to delete, and the
+// record ID word of the marker is zeroed once they have been deleted.
+#define FDS_BATCH_KEY           (0xFFFF)
+
 #define FDS_OFFSET_TL           (0) // Offset of TL from the record base address, in 4-byte words.
 #define FDS_OFFSET_IC           (1) // Offset of IC from the record base address, in 4-byte words.
 #define FDS_OFFSET_ID           (2) // Offset of ID from the record base address, in 4-byte words.
@@ -75,9 +82,11 @@ extern "C" {
 
 #define FDS_OP_EXECUTING        (NRF_SUCCESS)
 #define FDS_OP_COMPLETED        (0x1D1D)
+#define FDS_OP_YIELD            (0x1D1E) // Garbage collection lets the next operation run first.
 
 #define NRF_FSTORAGE_NVMC       1
 #define NRF_FSTORAGE_SD         2
+#define NRF_FSTORAGE_RAM        3
 
 // The size of a physical page, in 4-byte words.
 #if     defined(NRF51)
@@ -107,6 +116,32 @@ extern "C" {
     #error "FDS requires at least two virtual pages."
 #endif
 
+// The number of records that can be held by the RAM index. Zero disables the index.
+#ifndef FDS_INDEX_SIZE
+    #define FDS_INDEX_SIZE          (0)
+#endif
+
+#if (FDS_INDEX_SIZE > UINT16_MAX)
+    #error "FDS_INDEX_SIZE must not exceed 65535."
+#endif
+
+// The number of flash operations garbage collection runs before it lets other operations
+// execute. Zero runs garbage collection to completion.
+#ifndef FDS_GC_SLICE_OPS
+    #define FDS_GC_SLICE_OPS            (0)
+#endif
+
+// The percentage of flash taken by dirty records which triggers garbage collection.
+// Zero disables automatic garbage collection.
+#ifndef FDS_GC_AUTO_DIRTY_PERCENT
+    #define FDS_GC_AUTO_DIRTY_PERCENT   (0)
+#endif
+
+// The maximum number of records in a batch written by fds_batch_write(). Zero disables batches.
+#ifndef FDS_BATCH_MAX_RECORDS
+    #define FDS_BATCH_MAX_RECORDS       (0)
+#endif
+
 
 // FDS internal status flags.
 typedef enum
@@ -154,7 +189,8 @@ typedef enum
     FDS_OP_UPDATE,      // Update a record.
     FDS_OP_DEL_RECORD,  // Delete a record.
     FDS_OP_DEL_FILE,    // Delete a file.
-    FDS_OP_GC           // Run garbage collection.
+    FDS_OP_GC,          // Run garbage collection.
+    FDS_OP_BATCH        // Write a batch of records.
 } fds_op_code_t;
 
 
@@ -164,6 +200,7 @@ typedef enum
     FDS_OP_INIT_TAG_DATA,
     FDS_OP_INIT_ERASE_SWAP,
     FDS_OP_INIT_PROMOTE_SWAP,
+    FDS_OP_INIT_BATCH_REPAIR,       // Complete batches which were interrupted by a reset.
 } fds_init_step_t;
 
 
@@ -187,6 +224,19 @@ typedef enum
 } fds_delete_step_t;
 
 
+typedef enum
+{
+    FDS_OP_BATCH_FIND_RECORDS,      // Locate the records to be updated.
+    FDS_OP_BATCH_BEGIN,             // Write the batch marker.
+    FDS_OP_BATCH_LIST,              // Write the list of records to delete.
+    FDS_OP_BATCH_HEADER,            // Write the header of a record.
+    FDS_OP_BATCH_DATA,              // Write the data of a record.
+    FDS_OP_BATCH_COMMIT,            // Commit the batch by clearing the batch marker.
+    FDS_OP_BATCH_FLAG_DIRTY,        // Flag the old copies of updated records as dirty.
+    FDS_OP_BATCH_DONE,
+} fds_batch_step_t;
+
+
 #if defined(__CC_ARM)
     #pragma push
     #pragma anon_unions
@@ -220,6 +270,15 @@ typedef struct
             uint16_t          record_key;
             uint32_t          record_to_delete;
         } del;
+        struct
+        {
+            fds_batch_step_t step;
+            uint16_t         page;              // The page the flash space for the batch was reserved.
+            uint16_t         idx;               // The record being processed.
+            uint16_t         offset;            // The offset of that record from the batch marker.
+            uint16_t         count;             // The number of records in the batch.
+            uint32_t         record_id;         // The record ID of the first record.
+        } batch;
     };
 } fds_op_t;
 
@@ -312,9 +371,66 @@ typedef struct
     uint16_t         run_count;                  // Total number of times GC was run.
     bool             do_gc_page[FDS_DATA_PAGES]; // Controls which pages to garbage collect.
     bool             resume;                     // Whether or not GC should be resumed.
+    uint16_t         slice_ops;                  // Flash operations issued in the current slice.
+    uint32_t         slice_start;                // The time at which the current slice started.
+    fds_gc_stat_t    stat;                       // Garbage collection statistics.
 } fds_gc_data_t;
 
 
+#if (FDS_INDEX_SIZE > 0)
+
+// An entry in the RAM index. Records are located by page and offset rather than by address,
+// so that entries on pages not touched by garbage collection stay valid when pages are swapped.
+typedef struct
+{
+    uint32_t key;       // The file ID (upper 16 bits) and the record key (lower 16 bits).
+    uint16_t page;      // The page on which the record is stored, as an index in m_pages[].
+    uint16_t offset;    // The offset of the record from the beginning of the page, in 4-byte words.
+} fds_index_entry_t;
+
+
+// Maps file IDs and record keys to the valid records in flash.
+typedef struct
+{
+    fds_index_entry_t entry[FDS_INDEX_SIZE];    // Index entries, sorted by key.
+    uint16_t          count;                    // The number of entries in use.
+    bool              overflow;                 // The index is incomplete and must not be used.
+    bool              dirty_pending;            // A record is being flagged as dirty.
+    fds_index_entry_t dirty;                    // The entry of the record being flagged as dirty.
+} fds_index_t;
+
+#endif
+
+
+#if (FDS_BATCH_MAX_RECORDS > 0)
+
+typedef struct
+{
+    fds_header_t        header;     // The record header, laid out as in flash.
+    void        const * p_data;     // The record data.
+    fds_record_desc_t   old;        // The record to delete, if this is an update.
+    bool                update;     // Whether the record replaces an existing one.
+} fds_batch_entry_t;
+
+
+// Holds the records of the batch being written. Only one batch is queued at a time.
+typedef struct
+{
+    fds_batch_entry_t entry[FDS_BATCH_MAX_RECORDS];
+    // The list of records to delete, as written to flash: a record header and the record IDs.
+    uint32_t          list[FDS_HEADER_SIZE + FDS_BATCH_MAX_RECORDS];
+    uint16_t          list_words;   // The length of the list, header included. Zero if no updates.
+    uint32_t          marker;       // The first word of the batch marker, as written to flash.
+    uint16_t          length_words; // The length of the list and the records, headers included.
+    uint16_t          count;        // The number of records in the batch.
+    uint32_t  const * p_marker;     // The batch marker in flash, once it is being written.
+    bool              indexed;      // The committed records have been added to the index.
+    bool              queued;       // A batch is queued or being written.
+} fds_batch_t;
+
+#endif
+
+
 // Macros to enable and disable application interrupts.
 #if defined (FDS_THREADS)
 
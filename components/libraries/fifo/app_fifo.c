@@ -39,6 +39,7 @@
  */
 #include "sdk_common.h"
 #if NRF_MODULE_ENABLED(APP_FIFO)
+#include <string.h>
 #include "app_fifo.h"
 
 static __INLINE uint32_t fifo_length(app_fifo_t * p_fifo)
@@ -51,6 +52,13 @@ static __INLINE uint32_t fifo_length(app_fifo_t * p_fifo)
 #define FIFO_LENGTH() fifo_length(p_fifo)  /**< Macro for calculating the FIFO length. */
 
 
+/**@brief Size of the contiguous region starting at a position and ending at the buffer end. */
+static __INLINE uint32_t fifo_span_to_end(app_fifo_t * p_fifo, uint32_t pos)
+{
+    return (uint32_t)p_fifo->buf_size_mask + 1 - (pos & p_fifo->buf_size_mask);
+}
+
+
 /**@brief Put one byte to the FIFO. */
 static __INLINE void fifo_put(app_fifo_t * p_fifo, uint8_t byte)
 {
@@ -148,7 +156,6 @@ uint32_t app_fifo_read(app_fifo_t * p_fifo, uint8_t * p_byte_array, uint32_t * p
 
     const uint32_t byte_count    = fifo_length(p_fifo);
     const uint32_t requested_len = (*p_size);
-    uint32_t       index         = 0;
     uint32_t       read_size     = MIN(requested_len, byte_count);
 
     (*p_size) = byte_count;
@@ -165,11 +172,14 @@ uint32_t app_fifo_read(app_fifo_t * p_fifo, uint8_t * p_byte_array, uint32_t * p
         return NRF_SUCCESS;
     }
 
-    // Fetch bytes from the FIFO.
-    while (index < read_size)
-    {
-        fifo_get(p_fifo, &p_byte_array[index++]);
-    }
+    // Fetch bytes from the FIFO, in at most two copies when the data wraps around.
+    const uint32_t read_pos = p_fifo->read_pos;
+    uint32_t       span     = MIN(read_size, fifo_span_to_end(p_fifo, read_pos));
+
+    memcpy(p_byte_array, &p_fifo->p_buf[read_pos & p_fifo->buf_size_mask], span);
+    memcpy(&p_byte_array[span], p_fifo->p_buf, read_size - span);
+
+    p_fifo->read_pos = read_pos + read_size;
 
     (*p_size) = read_size;
 
@@ -184,7 +194,6 @@ uint32_t app_fifo_write(app_fifo_t * p_fifo, uint8_t const * p_byte_array, uint3
 
     const uint32_t available_count = p_fifo->buf_size_mask - fifo_length(p_fifo) + 1;
     const uint32_t requested_len   = (*p_size);
-    uint32_t       index           = 0;
     uint32_t       write_size      = MIN(requested_len, available_count);
 
     (*p_size) = available_count;
@@ -201,13 +210,90 @@ uint32_t app_fifo_write(app_fifo_t * p_fifo, uint8_t const * p_byte_array, uint3
         return NRF_SUCCESS;
     }
 
-    //Fetch bytes from the FIFO.
-    while (index < write_size)
+    // Put bytes to the FIFO, in at most two copies when the free space wraps around.
+    const uint32_t write_pos = p_fifo->write_pos;
+    uint32_t       span      = MIN(write_size, fifo_span_to_end(p_fifo, write_pos));
+
+    memcpy(&p_fifo->p_buf[write_pos & p_fifo->buf_size_mask], p_byte_array, span);
+    memcpy(p_fifo->p_buf, &p_byte_array[span], write_size - span);
+
+    p_fifo->write_pos = write_pos + write_size;
+
+    (*p_size) = write_size;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_alloc(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+    VERIFY_PARAM_NOT_NULL(pp_data);
+    VERIFY_PARAM_NOT_NULL(p_size);
+
+    const uint32_t write_pos       = p_fifo->write_pos;
+    const uint32_t available_count = p_fifo->buf_size_mask - fifo_length(p_fifo) + 1;
+
+    if (available_count == 0)
     {
-        fifo_put(p_fifo, p_byte_array[index++]);
+        *p_size = 0;
+        return NRF_ERROR_NO_MEM;
     }
 
-    (*p_size) = write_size;
+    *pp_data = &p_fifo->p_buf[write_pos & p_fifo->buf_size_mask];
+    *p_size  = MIN(available_count, fifo_span_to_end(p_fifo, write_pos));
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_commit(app_fifo_t * p_fifo, uint32_t size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+
+    if (size > (p_fifo->buf_size_mask - fifo_length(p_fifo) + 1))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_fifo->write_pos += size;
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_peek_span(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+    VERIFY_PARAM_NOT_NULL(pp_data);
+    VERIFY_PARAM_NOT_NULL(p_size);
+
+    const uint32_t read_pos   = p_fifo->read_pos;
+    const uint32_t byte_count = fifo_length(p_fifo);
+
+    if (byte_count == 0)
+    {
+        *p_size = 0;
+        return NRF_ERROR_NOT_FOUND;
+    }
+
+    *pp_data = &p_fifo->p_buf[read_pos & p_fifo->buf_size_mask];
+    *p_size  = MIN(byte_count, fifo_span_to_end(p_fifo, read_pos));
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_fifo_consume(app_fifo_t * p_fifo, uint32_t size)
+{
+    VERIFY_PARAM_NOT_NULL(p_fifo);
+
+    if (size > fifo_length(p_fifo))
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    p_fifo->read_pos += size;
 
     return NRF_SUCCESS;
 }
@@ -171,6 +171,61 @@ uint32_t app_fifo_read(app_fifo_t * p_fifo, uint8_t * p_byte_array, uint32_t * p
  */
 uint32_t app_fifo_write(app_fifo_t * p_fifo, uint8_t const * p_byte_array, uint32_t * p_size);
 
+/**@brief Function for getting the largest contiguous free region of the FIFO.
+ *
+ * The producer can fill the region in place, e.g. by DMA, and then make the data available
+ * with @ref app_fifo_commit.
+ *
+ * @param[in]  p_fifo       Pointer to the FIFO. Must not be NULL.
+ * @param[out] pp_data      Pointer to the start of the free region.
+ * @param[out] p_size       Size of the free region. It can be smaller than the total free space
+ *                          in the FIFO when the free space wraps around the end of the buffer.
+ *
+ * @retval     NRF_SUCCESS       If a free region was returned.
+ * @retval     NRF_ERROR_NULL    If a NULL parameter was passed.
+ * @retval     NRF_ERROR_NO_MEM  If the FIFO is full.
+ */
+uint32_t app_fifo_alloc(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size);
+
+/**@brief Function for adding bytes written in place to the FIFO.
+ *
+ * @param[in]  p_fifo       Pointer to the FIFO. Must not be NULL.
+ * @param[in]  size         Number of bytes written to the region returned by @ref app_fifo_alloc.
+ *
+ * @retval     NRF_SUCCESS              If the bytes were added.
+ * @retval     NRF_ERROR_NULL           If a NULL parameter was passed.
+ * @retval     NRF_ERROR_INVALID_LENGTH If size is larger than the free space in the FIFO.
+ */
+uint32_t app_fifo_commit(app_fifo_t * p_fifo, uint32_t size);
+
+/**@brief Function for getting the largest contiguous region of data in the FIFO, without
+ *        consuming it.
+ *
+ * The consumer can use the data in place, e.g. by DMA, and then release it with
+ * @ref app_fifo_consume.
+ *
+ * @param[in]  p_fifo       Pointer to the FIFO. Must not be NULL.
+ * @param[out] pp_data      Pointer to the oldest byte in the FIFO.
+ * @param[out] p_size       Size of the region. It can be smaller than the number of bytes in
+ *                          the FIFO when the data wraps around the end of the buffer.
+ *
+ * @retval     NRF_SUCCESS          If a region was returned.
+ * @retval     NRF_ERROR_NULL       If a NULL parameter was passed.
+ * @retval     NRF_ERROR_NOT_FOUND  If the FIFO is empty.
+ */
+uint32_t app_fifo_peek_span(app_fifo_t * p_fifo, uint8_t ** pp_data, uint32_t * p_size);
+
+/**@brief Function for removing bytes used in place from the FIFO.
+ *
+ * @param[in]  p_fifo       Pointer to the FIFO. Must not be NULL.
+ * @param[in]  size         Number of bytes to remove.
+ *
+ * @retval     NRF_SUCCESS              If the bytes were removed.
+ * @retval     NRF_ERROR_NULL           If a NULL parameter was passed.
+ * @retval     NRF_ERROR_INVALID_LENGTH If size is larger than the number of bytes in the FIFO.
+ */
+uint32_t app_fifo_consume(app_fifo_t * p_fifo, uint32_t size);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,532 @@
+/**
+ * Copyright (c) 2016 - 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+
+#include "sdk_common.h"
+
+#if NRF_MODULE_ENABLED(NRF_FSTORAGE) && NRF_MODULE_ENABLED(NRF_FSTORAGE_RAM)
+
+#include "nrf_fstorage_ram.h"
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "nordic_common.h"
+
+
+#if   defined(NRF51)
+    #define RAM_ERASE_UNIT  1024
+#elif defined(NRF52_SERIES)
+    #define RAM_ERASE_UNIT  4096
+#else
+    #error Family not defined.
+#endif
+
+#define RAM_PAGES   (NRF_FSTORAGE_RAM_SIZE / RAM_ERASE_UNIT)
+
+#if (NRF_FSTORAGE_RAM_SIZE == 0) || (NRF_FSTORAGE_RAM_SIZE % RAM_ERASE_UNIT)
+    #error NRF_FSTORAGE_RAM_SIZE must be a non-zero multiple of the flash page size.
+#endif
+
+#if (NRF_FSTORAGE_RAM_MAX_WRITE_SIZE == 0) || (NRF_FSTORAGE_RAM_MAX_WRITE_SIZE % 4)
+    #error NRF_FSTORAGE_RAM_MAX_WRITE_SIZE must be a non-zero multiple of the word size.
+#endif
+
+
+/**@brief   fstorage operation codes. */
+typedef enum
+{
+    NRF_FSTORAGE_OP_WRITE,  //!< Write bytes to flash.
+    NRF_FSTORAGE_OP_ERASE   //!< Erase flash pages.
+} nrf_fstorage_ram_opcode_t;
+
+
+/**@brief   fstorage operation queue element. */
+typedef struct
+{
+    nrf_fstorage_t            const * p_fs;     //!< The fstorage instance that requested the operation.
+    nrf_fstorage_ram_opcode_t         op_code;  //!< Requested operation.
+    void                            * p_param;  //!< User-defined parameter passed to the event handler.
+    void                      const * p_src;    //!< Data to be written to flash.
+    uint32_t                          addr;     //!< Destination of the data, or address of the first page to erase.
+    uint32_t                          len;      //!< Length of the data in bytes, or number of pages to erase.
+    uint32_t                          progress; //!< Bytes written, or pages erased.
+    uint64_t                          queued;   //!< Time at which the operation was queued.
+} nrf_fstorage_ram_op_t;
+
+
+typedef struct
+{
+    nrf_fstorage_ram_op_t op[NRF_FSTORAGE_RAM_QUEUE_SIZE];
+    uint32_t              rp;
+    uint32_t              cnt;
+} nrf_fstorage_ram_queue_t;
+
+
+/* API function prototypes. */
+static ret_code_t init(nrf_fstorage_t *, void *);
+static ret_code_t uninit(nrf_fstorage_t *, void *);
+static ret_code_t read(nrf_fstorage_t const *, uint32_t, void *, uint32_t);
+static ret_code_t write(nrf_fstorage_t const *, uint32_t, void const *, uint32_t, void *);
+static ret_code_t erase(nrf_fstorage_t const *, uint32_t, uint32_t, void *);
+static bool is_busy(nrf_fstorage_t const *);
+
+
+/* Flash information. */
+static nrf_fstorage_info_t m_flash_info =
+{
+    .erase_unit   = RAM_ERASE_UNIT,
+    .program_unit = 4,
+};
+
+
+/* API implementation. */
+nrf_fstorage_api_t nrf_fstorage_ram =
+{
+    .init    = init,
+    .uninit  = uninit,
+    .read    = read,
+    .write   = write,
+    .erase   = erase,
+    .is_busy = is_busy
+};
+
+
+/* The emulated flash. Its contents are retained across uninit() and init(). */
+__ALIGN(RAM_ERASE_UNIT)
+static uint32_t m_flash[NRF_FSTORAGE_RAM_SIZE / sizeof(uint32_t)];
+static bool     m_flash_formatted;
+
+static uint32_t m_wear[RAM_PAGES];
+
+static nrf_fstorage_ram_queue_t m_queue;
+static nrf_fstorage_ram_stat_t  m_stat;
+
+static uint32_t m_write_us = NRF_FSTORAGE_RAM_WRITE_TIME_US;
+static uint32_t m_erase_us = NRF_FSTORAGE_RAM_ERASE_TIME_US;
+
+static uint64_t m_time;             // Current time, in microseconds.
+static uint32_t m_access_left;      // Time until the ongoing flash access completes.
+static bool     m_access_ongoing;
+
+
+static uint32_t flash_start(void)
+{
+    return (uint32_t)(uintptr_t)m_flash;
+}
+
+
+static bool addr_is_valid(uint32_t addr, uint32_t len)
+{
+    uint32_t const start = flash_start();
+
+    return (addr >= start) &&
+           (len  <= NRF_FSTORAGE_RAM_SIZE) &&
+           (addr - start <= NRF_FSTORAGE_RAM_SIZE - len);
+}
+
+
+/* Sends events to the application. */
+static void event_send(nrf_fstorage_ram_op_t const * p_op, ret_code_t result)
+{
+    if (p_op->p_fs->evt_handler == NULL)
+    {
+        /* Nothing to do. */
+        return;
+    }
+
+    nrf_fstorage_evt_t evt;
+    memset(&evt, 0x00, sizeof(evt));
+
+    evt.result  = result;
+    evt.p_param = p_op->p_param;
+    evt.addr    = p_op->addr;
+    evt.len     = p_op->len;
+    evt.id      = (p_op->op_code == NRF_FSTORAGE_OP_WRITE) ? NRF_FSTORAGE_EVT_WRITE_RESULT :
+                                                              NRF_FSTORAGE_EVT_ERASE_RESULT;
+
+    p_op->p_fs->evt_handler(&evt);
+}
+
+
+/* Length of the next flash access of a write operation, in bytes. */
+static uint32_t write_chunk_len(nrf_fstorage_ram_op_t const * p_op)
+{
+    return MIN(p_op->len - p_op->progress, NRF_FSTORAGE_RAM_MAX_WRITE_SIZE);
+}
+
+
+/* Write one chunk to flash. Like real flash, bits can only be cleared. */
+static void write_execute(nrf_fstorage_ram_op_t const * p_op)
+{
+    uint32_t const words = write_chunk_len(p_op) / sizeof(uint32_t);
+    uint32_t const idx   = (p_op->addr + p_op->progress - flash_start()) / sizeof(uint32_t);
+
+    uint8_t const * p_src = (uint8_t const *)p_op->p_src + p_op->progress;
+
+    for (uint32_t i = 0; i < words; i++)
+    {
+        uint32_t word;
+
+        /* The source buffer is not required to be word-aligned. */
+        memcpy(&word, p_src + (i * sizeof(uint32_t)), sizeof(word));
+
+        m_flash[idx + i] &= word;
+    }
+
+    m_stat.words_written += words;
+}
+
+
+/* Erase one flash page. */
+static void erase_execute(nrf_fstorage_ram_op_t const * p_op)
+{
+    uint32_t const page = (p_op->addr - flash_start()) / RAM_ERASE_UNIT + p_op->progress;
+
+    memset(&m_flash[page * (RAM_ERASE_UNIT / sizeof(uint32_t))], 0xFF, RAM_ERASE_UNIT);
+
+    m_wear[page]++;
+    m_stat.pages_erased++;
+}
+
+
+/* Advance the queue, wrapping around if necessary. */
+static void queue_advance(void)
+{
+    m_queue.cnt--;
+    m_queue.rp++;
+
+    if (m_queue.rp == NRF_FSTORAGE_RAM_QUEUE_SIZE)
+    {
+        m_queue.rp = 0;
+    }
+}
+
+
+/* Start the next flash access of the current operation, if the flash is idle. */
+static void access_start(void)
+{
+    if (m_access_ongoing || (m_queue.cnt == 0))
+    {
+        return;
+    }
+
+    nrf_fstorage_ram_op_t const * const p_op = &m_queue.op[m_queue.rp];
+
+    if (p_op->op_code == NRF_FSTORAGE_OP_WRITE)
+    {
+        m_access_left = (write_chunk_len(p_op) / sizeof(uint32_t)) * m_write_us;
+    }
+    else
+    {
+        m_access_left = m_erase_us;
+    }
+
+    m_access_ongoing = true;
+}
+
+
+/* Complete the ongoing flash access. If the operation has finished,
+ * advance the queue and send an event. */
+static void access_end(void)
+{
+    nrf_fstorage_ram_op_t * const p_op = &m_queue.op[m_queue.rp];
+    bool operation_finished;
+
+    m_access_ongoing = false;
+    m_stat.flash_accesses++;
+
+    if (p_op->op_code == NRF_FSTORAGE_OP_WRITE)
+    {
+        write_execute(p_op);
+        p_op->progress    += write_chunk_len(p_op);
+        operation_finished = (p_op->progress == p_op->len);
+    }
+    else
+    {
+        erase_execute(p_op);
+        p_op->progress++;
+        operation_finished = (p_op->progress == p_op->len);
+    }
+
+    if (operation_finished)
+    {
+        nrf_fstorage_ram_op_t op;
+        uint32_t              latency;
+
+        /* Copy the current operation, to allow the queue element to be re-used. */
+        memcpy(&op, p_op, sizeof(op));
+        /* Free the queue element, so that new operations can be queued.*/
+        queue_advance();
+
+        latency = (uint32_t)(m_time - op.queued);
+
+        m_stat.latency_total_us += latency;
+        m_stat.latency_max_us    = MAX(m_stat.latency_max_us, latency);
+
+        if (op.op_code == NRF_FSTORAGE_OP_WRITE)
+        {
+            m_stat.writes++;
+        }
+        else
+        {
+            m_stat.erases++;
+        }
+
+        /* Keep the flash busy while the application handles the event. */
+        access_start();
+
+        event_send(&op, NRF_SUCCESS);
+    }
+
+    access_start();
+}
+
+
+/* Retrieves a pointer to the next free element in the queue. */
+static bool queue_get_next_free(nrf_fstorage_ram_op_t ** p_op)
+{
+    uint32_t idx;
+
+    if (m_queue.cnt == NRF_FSTORAGE_RAM_QUEUE_SIZE)
+    {
+        return false;
+    }
+
+    idx = ((m_queue.rp + m_queue.cnt) < NRF_FSTORAGE_RAM_QUEUE_SIZE) ?
+           (m_queue.rp + m_queue.cnt) :
+           (m_queue.rp + m_queue.cnt) - NRF_FSTORAGE_RAM_QUEUE_SIZE;
+
+    m_queue.cnt++;
+    m_stat.queue_max = MAX(m_stat.queue_max, m_queue.cnt);
+
+    memset((void*)&m_queue.op[idx], 0x00, sizeof(nrf_fstorage_ram_op_t));
+    m_queue.op[idx].queued = m_time;
+
+    *p_op = &m_queue.op[idx];
+
+    return true;
+}
+
+
+static ret_code_t init(nrf_fstorage_t * p_fs, void * p_param)
+{
+    (void) p_param;
+
+    /* Flash addresses are 32 bits wide, and flash users read the flash through pointers made
+     * from them. On a 64-bit host, the emulated flash must lie in the lower 4 GB. */
+    if ((uintptr_t)flash_start() != (uintptr_t)m_flash)
+    {
+        return NRF_ERROR_NOT_SUPPORTED;
+    }
+
+    p_fs->p_flash_info = &m_flash_info;
+
+    if (!m_flash_formatted)
+    {
+        /* The contents of the emulated flash persist across re-initialization,
+         * as they would on a real device. */
+        memset(m_flash, 0xFF, sizeof(m_flash));
+        m_flash_formatted = true;
+    }
+
+    /* Reset the queue. */
+    memset(&m_queue, 0x00, sizeof(m_queue));
+    m_access_ongoing = false;
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t uninit(nrf_fstorage_t * p_fs, void * p_param)
+{
+    (void) p_param;
+
+    /* The state is re-initialized upon init().
+     * The common uninitialization code is run by the caller.
+     * Nothing to do.
+     */
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t write(nrf_fstorage_t const * p_fs,
+                        uint32_t               dest,
+                        void           const * p_src,
+                        uint32_t               len,
+                        void                 * p_param)
+{
+    nrf_fstorage_ram_op_t * p_op;
+
+    if (!addr_is_valid(dest, len))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    if (!queue_get_next_free(&p_op))
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    /* Initialize the operation. */
+    p_op->op_code = NRF_FSTORAGE_OP_WRITE;
+    p_op->p_fs    = p_fs;
+    p_op->p_param = p_param;
+    p_op->addr    = dest;
+    p_op->p_src   = p_src;
+    p_op->len     = len;
+
+    access_start();
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t read(nrf_fstorage_t const * p_fs, uint32_t src, void * p_dest, uint32_t len)
+{
+    if (!addr_is_valid(src, len))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    memcpy(p_dest, (uint8_t*)m_flash + (src - flash_start()), len);
+
+    return NRF_SUCCESS;
+}
+
+
+static ret_code_t erase(nrf_fstorage_t const * p_fs,
+                        uint32_t               page_addr,
+                        uint32_t               len,
+                        void                 * p_param)
+{
+    nrf_fstorage_ram_op_t * p_op;
+
+    if (   (len > RAM_PAGES)
+        || !addr_is_valid(page_addr, len * RAM_ERASE_UNIT))
+    {
+        return NRF_ERROR_INVALID_ADDR;
+    }
+
+    if (!queue_get_next_free(&p_op))
+    {
+        return NRF_ERROR_NO_MEM;
+    }
+
+    /* Initialize the operation. */
+    p_op->op_code = NRF_FSTORAGE_OP_ERASE;
+    p_op->p_fs    = p_fs;
+    p_op->p_param = p_param;
+    p_op->addr    = page_addr;
+    p_op->len     = len;
+
+    access_start();
+
+    return NRF_SUCCESS;
+}
+
+
+static bool is_busy(nrf_fstorage_t const * p_fs)
+{
+    return (m_queue.cnt != 0);
+}
+
+
+uint32_t nrf_fstorage_ram_start_addr(void)
+{
+    return flash_start();
+}
+
+
+uint32_t nrf_fstorage_ram_end_addr(void)
+{
+    return flash_start() + NRF_FSTORAGE_RAM_SIZE;
+}
+
+
+void nrf_fstorage_ram_timing_set(uint32_t write_us, uint32_t erase_us)
+{
+    m_write_us = write_us;
+    m_erase_us = erase_us;
+}
+
+
+void nrf_fstorage_ram_process(uint32_t elapsed_us)
+{
+    while (m_access_ongoing)
+    {
+        if (m_access_left > elapsed_us)
+        {
+            m_access_left  -= elapsed_us;
+            m_stat.busy_us += elapsed_us;
+            m_time         += elapsed_us;
+            return;
+        }
+
+        elapsed_us     -= m_access_left;
+        m_stat.busy_us += m_access_left;
+        m_time         += m_access_left;
+
+        access_end();
+    }
+
+    /* The flash is idle for the remaining time. */
+    m_time += elapsed_us;
+}
+
+
+void nrf_fstorage_ram_stat_get(nrf_fstorage_ram_stat_t * p_stat)
+{
+    *p_stat = m_stat;
+}
+
+
+void nrf_fstorage_ram_stat_reset(void)
+{
+    memset(&m_stat, 0x00, sizeof(m_stat));
+    memset(m_wear,  0x00, sizeof(m_wear));
+}
+
+
+uint32_t nrf_fstorage_ram_wear_get(uint32_t page)
+{
+    return (page < RAM_PAGES) ? m_wear[page] : 0;
+}
+
+#endif // NRF_FSTORAGE_ENABLED && NRF_FSTORAGE_RAM_ENABLED
@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2016 - 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+/**
+ * @file
+ *
+ * @defgroup nrf_fstorage_ram RAM implementation
+ * @ingroup nrf_fstorage
+ * @{
+ *
+ * @brief API implementation of fstorage that emulates flash in RAM.
+ *
+ * @details The flash is emulated by a RAM area of @ref NRF_FSTORAGE_RAM_SIZE bytes, which has the
+ *          semantics of NOR flash: writes can only clear bits, and erases are page-granular.
+ *          Like in the SoftDevice implementation, operations are queued and executed one flash
+ *          access at a time; long writes are split in chunks of at most
+ *          @ref NRF_FSTORAGE_RAM_MAX_WRITE_SIZE bytes and every page is erased separately.
+ *          Flash accesses take a configurable time to execute, and they only complete when time
+ *          is advanced using @ref nrf_fstorage_ram_process. This allows measuring the latency and
+ *          the write amplification of flash users, such as FDS, without hardware.
+ *
+ *          Flash addresses used with this implementation must lie between
+ *          @ref nrf_fstorage_ram_start_addr and @ref nrf_fstorage_ram_end_addr. They are the
+ *          addresses of the RAM area, so that the flash can be read directly. When built for a
+ *          64-bit host, the RAM area must be placed in the lower 4 GB of the address space, for
+ *          example by linking a non-position-independent executable. Otherwise, initialization
+ *          fails with NRF_ERROR_NOT_SUPPORTED.
+ */
+
+#ifndef NRF_FSTORAGE_RAM_H__
+#define NRF_FSTORAGE_RAM_H__
+
+#include <stdint.h>
+#include "nrf_fstorage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**@brief   Statistics of the emulated flash. */
+typedef struct
+{
+    uint32_t writes;            //!< The number of write operations completed.
+    uint32_t erases;            //!< The number of erase operations completed.
+    uint32_t flash_accesses;    //!< The number of flash accesses (write chunks and page erases).
+    uint32_t words_written;     //!< The number of words written.
+    uint32_t pages_erased;      //!< The number of pages erased.
+    uint32_t queue_max;         //!< The largest number of operations queued at the same time.
+    uint32_t latency_max_us;    //!< The longest time from queuing an operation to its completion.
+    uint64_t latency_total_us;  //!< The sum of the latencies of all completed operations.
+    uint64_t busy_us;           //!< The total time spent executing flash accesses.
+} nrf_fstorage_ram_stat_t;
+
+
+/**@brief   API implementation that emulates flash in RAM.
+ *
+ * @details An fstorage instance with this API implementation can be initialized by providing
+ *          this structure as a parameter to @ref nrf_fstorage_init.
+ *          The structure is defined in @c nrf_fstorage_ram.c.
+ */
+extern nrf_fstorage_api_t nrf_fstorage_ram;
+
+
+/**@brief   Function for retrieving the address of the first byte of the emulated flash. */
+uint32_t nrf_fstorage_ram_start_addr(void);
+
+
+/**@brief   Function for retrieving the address following the last byte of the emulated flash. */
+uint32_t nrf_fstorage_ram_end_addr(void);
+
+
+/**@brief   Function for setting the time taken by flash accesses.
+ *
+ * The defaults are @ref NRF_FSTORAGE_RAM_WRITE_TIME_US and @ref NRF_FSTORAGE_RAM_ERASE_TIME_US.
+ * The new values apply to flash accesses started after this call.
+ *
+ * @param[in]   write_us    Time to write one word, in microseconds.
+ * @param[in]   erase_us    Time to erase one page, in microseconds.
+ */
+void nrf_fstorage_ram_timing_set(uint32_t write_us, uint32_t erase_us);
+
+
+/**@brief   Function for advancing the time of the emulated flash.
+ *
+ * Flash accesses which complete within the given time are executed, and events are sent for
+ * the operations which have finished. Event handlers are called from this function, and they may
+ * queue new operations; these are started as soon as the flash is idle.
+ *
+ * @param[in]   elapsed_us  Time elapsed since the previous call, in microseconds. Zero completes
+ *                          the flash accesses which take no time.
+ */
+void nrf_fstorage_ram_process(uint32_t elapsed_us);
+
+
+/**@brief   Function for retrieving the statistics of the emulated flash.
+ *
+ * @param[out]  p_stat  Statistics.
+ */
+void nrf_fstorage_ram_stat_get(nrf_fstorage_ram_stat_t * p_stat);
+
+
+/**@brief   Function for resetting the statistics and the wear counters of the emulated flash. */
+void nrf_fstorage_ram_stat_reset(void);
+
+
+/**@brief   Function for retrieving the number of times a page of the emulated flash was erased.
+ *
+ * @param[in]   page    The page number, counted from @ref nrf_fstorage_ram_start_addr.
+ *
+ * @return  The number of erases, or zero if the page does not exist.
+ */
+uint32_t nrf_fstorage_ram_wear_get(uint32_t page);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_FSTORAGE_RAM_H__
+/** @} */
@@ -51,11 +51,27 @@
 #include "nrf_sdh_soc.h"
 #include "nordic_common.h"
 
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    #include "app_timer.h"
+#endif
+
 
 #if (NRF_FSTORAGE_SD_MAX_WRITE_SIZE % 4)
     #error NRF_FSTORAGE_SD_MAX_WRITE_SIZE must be a multiple of the word size.
 #endif
 
+#ifndef NRF_FSTORAGE_SD_COALESCE_SIZE
+    #define NRF_FSTORAGE_SD_COALESCE_SIZE 0
+#endif
+
+#if (NRF_FSTORAGE_SD_COALESCE_SIZE % 4)
+    #error NRF_FSTORAGE_SD_COALESCE_SIZE must be a multiple of the word size.
+#endif
+
+#if (NRF_FSTORAGE_SD_COALESCE_SIZE > NRF_FSTORAGE_SD_MAX_WRITE_SIZE)
+    #error NRF_FSTORAGE_SD_COALESCE_SIZE must not exceed NRF_FSTORAGE_SD_MAX_WRITE_SIZE.
+#endif
+
 
 /**@brief   fstorage operation codes. */
 typedef enum
@@ -72,6 +88,7 @@ typedef struct
     nrf_fstorage_t           const * p_fs;     //!< The fstorage instance that requested the operation.
     nrf_fstorage_sd_opcode_t         op_code;  //!< Requested operation.
     void                           * p_param;  //!< User-defined parameter passed to the event handler.
+    uint32_t                         queued;   //!< Time at which the operation was queued, in app_timer ticks.
     union
     {
         struct
@@ -169,6 +186,44 @@ nrf_fstorage_api_t nrf_fstorage_sd =
 static nrf_fstorage_sd_queue_t m_queue;
 static nrf_fstorage_sd_flags_t m_flags;
 static uint32_t                m_retry_cnt;
+static nrf_fstorage_sd_stat_t  m_stat;
+
+/* The number of operations executed by the ongoing flash operation. */
+static uint32_t                m_op_cnt;
+
+#if (NRF_FSTORAGE_SD_COALESCE_SIZE > 0)
+/* Holds the data of writes which are merged into a single flash operation. */
+static uint32_t                m_coalesce_buf[NRF_FSTORAGE_SD_COALESCE_SIZE / sizeof(uint32_t)];
+#endif
+
+
+static uint32_t ticks_get(void)
+{
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    return app_timer_cnt_get();
+#else
+    return 0;
+#endif
+}
+
+
+/* Update the statistics when an operation completes. */
+static void stat_update(nrf_fstorage_sd_op_t const * p_op)
+{
+    uint32_t latency = 0;
+
+#if NRF_MODULE_ENABLED(APP_TIMER)
+    latency = app_timer_cnt_diff_compute(ticks_get(), p_op->queued);
+#endif
+
+    m_stat.ops++;
+    m_stat.latency_total += latency;
+
+    if (latency > m_stat.latency_max)
+    {
+        m_stat.latency_max = latency;
+    }
+}
 
 
 /* Sends events to the application. */
@@ -209,11 +264,77 @@ static void event_send(nrf_fstorage_sd_op_t const * p_op, ret_code_t result)
 }
 
 
+#if (NRF_FSTORAGE_SD_COALESCE_SIZE > 0)
+
+/* Merge a write with the writes queued after it, if they continue it in flash, so that they
+ * are executed by a single flash operation. Only whole operations are merged, while their
+ * total length fits in NRF_FSTORAGE_SD_COALESCE_SIZE; longer writes are split in chunks of
+ * NRF_FSTORAGE_SD_MAX_WRITE_SIZE as usual. Returns the length of the merged write, in bytes,
+ * or zero if there is nothing to merge. */
+static uint32_t write_coalesce(nrf_fstorage_sd_op_t const * p_op)
+{
+    uint32_t len = p_op->write.len;
+    uint32_t cnt;
+
+    if ((p_op->write.offset != 0) || (len > NRF_FSTORAGE_SD_COALESCE_SIZE))
+    {
+        return 0;
+    }
+
+    for (cnt = 1; cnt < m_queue.cnt; cnt++)
+    {
+        nrf_fstorage_sd_op_t const * const p_next =
+            &m_queue.op[(m_queue.rp + cnt) % NRF_FSTORAGE_SD_QUEUE_SIZE];
+
+        if (   (p_next->op_code    != NRF_FSTORAGE_OP_WRITE)
+            || (p_next->write.dest != p_op->write.dest + len)
+            || (p_next->write.len  >  NRF_FSTORAGE_SD_COALESCE_SIZE - len))
+        {
+            break;
+        }
+
+        len += p_next->write.len;
+    }
+
+    if (cnt == 1)
+    {
+        return 0;
+    }
+
+    /* The data is copied now, so it is not read from the sources after the operations complete. */
+    len = 0;
+    for (uint32_t i = 0; i < cnt; i++)
+    {
+        nrf_fstorage_sd_op_t const * const p_merged =
+            &m_queue.op[(m_queue.rp + i) % NRF_FSTORAGE_SD_QUEUE_SIZE];
+
+        memcpy((uint8_t*)m_coalesce_buf + len, p_merged->write.p_src, p_merged->write.len);
+        len += p_merged->write.len;
+    }
+
+    m_op_cnt = cnt;
+
+    return len;
+}
+
+#endif
+
+
 /* Write to flash. */
 static uint32_t write_execute(nrf_fstorage_sd_op_t const * p_op)
 {
     uint32_t chunk_len;
 
+#if (NRF_FSTORAGE_SD_COALESCE_SIZE > 0)
+    uint32_t const coalesced_len = write_coalesce(p_op);
+
+    if (coalesced_len != 0)
+    {
+        return sd_flash_write((uint32_t*)p_op->write.dest, m_coalesce_buf,
+                              coalesced_len / m_flash_info.program_unit);
+    }
+#endif
+
     chunk_len = MIN(p_op->write.len - p_op->write.offset, NRF_FSTORAGE_SD_MAX_WRITE_SIZE);
     chunk_len = MAX(1, chunk_len / m_flash_info.program_unit);
 
@@ -257,6 +378,7 @@ static void queue_process()
     /* Get the current operation from the queue and execute it. */
     nrf_fstorage_sd_op_t * const p_op = &m_queue.op[m_queue.rp];
     m_flags.flash_operation_ongoing = true;
+    m_op_cnt                        = 1;
 
     uint32_t rc;
     switch (p_op->op_code)
@@ -284,6 +406,8 @@ static void queue_process()
             break;
 
         case NRF_SUCCESS:
+            m_stat.flash_ops++;
+            m_stat.ops_coalesced += (m_op_cnt - 1);
             /* The operation was accepted by the SoftDevice.
              * If the SOftDevice is enabled, wait for a system event.
              * Otherwise, the SoftDevice call is synchronous and will not send an event. */
@@ -320,6 +444,12 @@ static bool on_operation_success(nrf_fstorage_sd_op_t * p_op)
     /* Reset the retry counter on success. */
     m_retry_cnt = 0;
 
+    if (m_op_cnt > 1)
+    {
+        /* Coalesced writes are executed by a single flash operation. */
+        return true;
+    }
+
     switch (p_op->op_code)
     {
         case NRF_FSTORAGE_OP_WRITE:
@@ -388,7 +518,13 @@ static bool queue_get_next_free(nrf_fstorage_sd_op_t ** p_op)
 
     m_queue.cnt++;
 
+    if (m_queue.cnt > m_stat.queue_max)
+    {
+        m_stat.queue_max = m_queue.cnt;
+    }
+
     memset((void*)&m_queue.op[idx], 0x00, sizeof(nrf_fstorage_sd_op_t));
+    m_queue.op[idx].queued = ticks_get();
     *p_op = &m_queue.op[idx];
 
     return true;
@@ -502,6 +638,13 @@ static bool is_busy(nrf_fstorage_t const * p_fs)
 }
 
 
+void nrf_fstorage_sd_stat_get(nrf_fstorage_sd_stat_t * p_stat)
+{
+    *p_stat           = m_stat;
+    p_stat->queue_cnt = m_queue.cnt;
+}
+
+
 void nrf_fstorage_sys_evt_handler(uint32_t sys_evt, void * p_context)
 {
     (void) p_context;
@@ -525,17 +668,26 @@ void nrf_fstorage_sys_evt_handler(uint32_t sys_evt, void * p_context)
 
         if (operation_finished)
         {
-            nrf_fstorage_sd_op_t op;
+            ret_code_t const result = (sys_evt == NRF_EVT_FLASH_OPERATION_SUCCESS) ?
+                                      NRF_SUCCESS : NRF_ERROR_TIMEOUT;
 
-            /* Copy the current operation, to allow the queue element to be re-used. */
-            memcpy(&op, p_op, sizeof(op));
-            /* Free the queue element, so that new operations can be queued.*/
-            queue_advance();
+            /* Send an event for each of the operations executed by the flash operation.
+             * Operations queued by the event handlers are started once all have been sent. */
+            for (uint32_t i = 0; i < m_op_cnt; i++)
+            {
+                nrf_fstorage_sd_op_t op;
 
-            m_flags.flash_operation_ongoing = false;
+                /* Copy the current operation, to allow the queue element to be re-used. */
+                memcpy(&op, &m_queue.op[m_queue.rp], sizeof(op));
+                /* Free the queue element, so that new operations can be queued.*/
+                queue_advance();
+
+                stat_update(&op);
+                event_send(&op, result);
+            }
 
-            event_send(&op, (sys_evt == NRF_EVT_FLASH_OPERATION_SUCCESS) ?
-                            NRF_SUCCESS : NRF_ERROR_TIMEOUT);
+            m_op_cnt                        = 0;
+            m_flags.flash_operation_ongoing = false;
         }
     }
     else if (m_flags.flash_operation_pending)
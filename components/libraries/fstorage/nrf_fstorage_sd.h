@@ -69,6 +69,30 @@ extern "C" {
 extern nrf_fstorage_api_t nrf_fstorage_sd;
 
 
+/**@brief   Statistics of the SoftDevice implementation.
+ *
+ * Latencies are measured from the time an operation is queued to the time its event is sent.
+ * They are expressed in app_timer ticks, and are zero if the app_timer library is not enabled.
+ */
+typedef struct
+{
+    uint32_t ops;           //!< The number of operations completed.
+    uint32_t flash_ops;     //!< The number of flash operations accepted by the SoftDevice.
+    uint32_t ops_coalesced; //!< The number of writes merged into the flash operation of another write.
+    uint32_t queue_cnt;     //!< The number of operations currently queued.
+    uint32_t queue_max;     //!< The largest number of operations queued at the same time.
+    uint32_t latency_max;   //!< The longest latency of an operation.
+    uint32_t latency_total; //!< The sum of the latencies of all completed operations.
+} nrf_fstorage_sd_stat_t;
+
+
+/**@brief   Function for retrieving the statistics of the SoftDevice implementation.
+ *
+ * @param[out]  p_stat  Statistics.
+ */
+void nrf_fstorage_sd_stat_get(nrf_fstorage_sd_stat_t * p_stat);
+
+
 /**@brief   Function for handling system events from the SoftDevice.
  *
  * @details This function dispatches system events to the nrf_fstorage_sd implementation.
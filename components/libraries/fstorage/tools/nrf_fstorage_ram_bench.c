@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+
+/**@file
+ *
+ * @brief Host benchmark of FDS and nrf_dfu_flash, using the nrf_fstorage_ram backend.
+ *
+ * @details Runs a flash workload against the emulated flash, and prints the write amplification,
+ *          the latency of flash operations and the wear of the flash pages.
+ *
+ *          fds  [records] [words] [updates]  Updates @p records FDS records of @p words words
+ *                                            in turn, @p updates times in total, like a settings
+ *                                            module. Garbage collection is run when FDS is full.
+ *          dfu  [bytes] [chunk] [interval]   Stores a firmware image of @p bytes bytes in chunks of
+ *                                            @p chunk bytes, one every @p interval microseconds,
+ *                                            like the DFU transport. Each page is erased before
+ *                                            it is written.
+ *
+ *          The benchmark is built for the host from the SDK root, with the sdk_config.h of the
+ *          application being measured. The emulated flash is read through 32-bit addresses, so
+ *          the executable must not be position independent:
+ *
+ *          gcc -no-pie -Wl,-T,components/libraries/fstorage/tools/nrf_fstorage_ram_bench.ld
+ *              -std=gnu99 -DNRF52832_XXAA -DNRF52 -DS132 -DSOFTDEVICE_PRESENT
+ *              -DNRF_SD_BLE_API_VERSION=5 -U__unix -U__unix__ -Uunix
+ *              -D__STATIC_INLINE="static inline" -DSVCALL_AS_NORMAL_FUNCTION
+ *              -DAPP_TIMER_ENABLED=0 -DNRF_LOG_ENABLED=0 -DCRC16_ENABLED=1 -DFDS_ENABLED=1
+ *              -DFDS_BACKEND=3 -DNRF_FSTORAGE_ENABLED=1 -DNRF_FSTORAGE_RAM_ENABLED=1
+ *              -DNRF_FSTORAGE_RAM_SIZE=65536 -I<directory of sdk_config.h>
+ *              -Icomponents/device -Icomponents/toolchain -Icomponents/toolchain/cmsis/include
+ *              -Icomponents/softdevice/s132/headers -Icomponents/softdevice/s132/headers/nrf52
+ *              -Icomponents/libraries/util -Icomponents/libraries/experimental_section_vars
+ *              -Icomponents/libraries/experimental_log -Icomponents/libraries/experimental_log/src
+ *              -Icomponents/libraries/fstorage -Icomponents/libraries/fds
+ *              -Icomponents/libraries/bootloader/dfu -Icomponents/libraries/svc
+ *              components/libraries/fstorage/tools/nrf_fstorage_ram_bench.c
+ *              components/libraries/fstorage/nrf_fstorage.c
+ *              components/libraries/fstorage/nrf_fstorage_ram.c
+ *              components/libraries/fds/fds.c components/libraries/crc16/crc16.c
+ *              -o nrf_fstorage_ram_bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdk_common.h"
+#include "fds.h"
+#include "nrf_fstorage_ram.h"
+
+/* nrf_dfu_flash uses the NVMC implementation when the SoftDevice is not running. It is built into
+ * the benchmark with the RAM implementation in its place. Its fstorage instance is renamed, as FDS
+ * defines an instance with the same name. */
+#undef  BLE_STACK_SUPPORT_REQD
+#define nrf_fstorage_nvmc nrf_fstorage_ram
+#define m_fs              m_dfu_fs
+#include "nrf_dfu_flash.c"
+#undef  nrf_fstorage_nvmc
+#undef  m_fs
+
+
+#define STEP_US     100     //!< Time by which the emulated flash is advanced while waiting.
+
+
+static uint32_t m_fds_evt_cnt;
+static bool     m_fds_busy;
+
+
+static void fds_evt_handler(fds_evt_t const * p_evt)
+{
+    if (p_evt->result != FDS_SUCCESS)
+    {
+        printf("FDS event %d failed: %u\n", p_evt->id, (unsigned)p_evt->result);
+        exit(1);
+    }
+
+    m_fds_evt_cnt++;
+    m_fds_busy = false;
+}
+
+
+/* Advance time until all queued flash operations have completed. */
+static void flash_idle_wait(void)
+{
+    while (nrf_fstorage_ram.is_busy(NULL))
+    {
+        nrf_fstorage_ram_process(STEP_US);
+    }
+}
+
+
+/* Run an FDS operation to completion. */
+static void fds_wait(void)
+{
+    while (m_fds_busy)
+    {
+        nrf_fstorage_ram_process(STEP_US);
+    }
+}
+
+
+static void stat_print(uint32_t payload_bytes, uint32_t pages)
+{
+    nrf_fstorage_ram_stat_t stat;
+    uint32_t                ops;
+    uint32_t                wear_max = 0;
+
+    nrf_fstorage_ram_stat_get(&stat);
+    ops = stat.writes + stat.erases;
+
+    for (uint32_t i = 0; i < pages; i++)
+    {
+        wear_max = MAX(wear_max, nrf_fstorage_ram_wear_get(i));
+    }
+
+    printf("payload           %u bytes\n", (unsigned)payload_bytes);
+    printf("written           %u bytes in %u writes, %u flash accesses in total\n",
+           (unsigned)(stat.words_written * sizeof(uint32_t)), (unsigned)stat.writes,
+           (unsigned)stat.flash_accesses);
+    printf("write amplification %.2f\n",
+           payload_bytes ? (double)(stat.words_written * sizeof(uint32_t)) / payload_bytes : 0.0);
+    printf("erased            %u pages, most worn page %u erases\n",
+           (unsigned)stat.pages_erased, (unsigned)wear_max);
+    printf("latency           avg %llu us, max %u us, queue max %u\n",
+           ops ? (unsigned long long)(stat.latency_total_us / ops) : 0ULL,
+           (unsigned)stat.latency_max_us, (unsigned)stat.queue_max);
+    printf("flash busy        %llu us\n", (unsigned long long)stat.busy_us);
+}
+
+
+static int fds_bench(uint32_t records, uint32_t words, uint32_t updates)
+{
+    static uint32_t data[FDS_VIRTUAL_PAGE_SIZE];
+    uint32_t        gc_cnt = 0;
+
+    if ((records == 0) || (words == 0) || (words > FDS_VIRTUAL_PAGE_SIZE / 4))
+    {
+        printf("Invalid FDS workload.\n");
+        return 1;
+    }
+
+    (void)fds_register(fds_evt_handler);
+
+    m_fds_busy = true;
+    if (fds_init() != FDS_SUCCESS)
+    {
+        printf("fds_init() failed.\n");
+        return 1;
+    }
+    fds_wait();
+
+    /* Measure the workload only. */
+    nrf_fstorage_ram_stat_reset();
+
+    for (uint32_t i = 0; i < updates; i++)
+    {
+        fds_record_t      record;
+        fds_record_desc_t desc;
+        fds_find_token_t  token = {0};
+        ret_code_t        ret;
+
+        data[0] = i;
+
+        record.file_id           = 1;
+        record.key               = (uint16_t)(1 + (i % records));
+        record.data.p_data       = data;
+        record.data.length_words = words;
+
+        m_fds_busy = true;
+        if (fds_record_find(record.file_id, record.key, &desc, &token) == FDS_SUCCESS)
+        {
+            ret = fds_record_update(&desc, &record);
+        }
+        else
+        {
+            ret = fds_record_write(&desc, &record);
+        }
+
+        if (ret == FDS_ERR_NO_SPACE_IN_FLASH)
+        {
+            m_fds_busy = true;
+            if (fds_gc() != FDS_SUCCESS)
+            {
+                printf("fds_gc() failed.\n");
+                return 1;
+            }
+            fds_wait();
+            gc_cnt++;
+            i--;
+            continue;
+        }
+        if (ret != FDS_SUCCESS)
+        {
+            printf("Update %u failed: %u\n", (unsigned)i, (unsigned)ret);
+            return 1;
+        }
+        fds_wait();
+    }
+
+    printf("FDS: %u records of %u words, %u updates, %u garbage collections\n",
+           (unsigned)records, (unsigned)words, (unsigned)updates, (unsigned)gc_cnt);
+    stat_print(updates * words * sizeof(uint32_t), NRF_FSTORAGE_RAM_SIZE / CODE_PAGE_SIZE);
+
+    return 0;
+}
+
+
+static int dfu_bench(uint32_t bytes, uint32_t chunk, uint32_t interval_us)
+{
+    static uint8_t image[NRF_FSTORAGE_RAM_SIZE];
+    uint32_t       page_size;
+    uint32_t       stalls = 0;
+
+    if (nrf_dfu_flash_init(false) != NRF_SUCCESS)
+    {
+        printf("nrf_dfu_flash_init() failed.\n");
+        return 1;
+    }
+
+    /* The image is stored in the emulated flash, instead of the application area. */
+    m_dfu_fs.start_addr = nrf_fstorage_ram_start_addr();
+    m_dfu_fs.end_addr   = nrf_fstorage_ram_end_addr();
+    page_size       = m_dfu_fs.p_flash_info->erase_unit;
+
+    if ((chunk == 0) || (chunk % sizeof(uint32_t)) || (page_size % chunk) || (bytes > sizeof(image)))
+    {
+        printf("Invalid DFU workload.\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < bytes; i++)
+    {
+        image[i] = (uint8_t)rand();
+    }
+
+    nrf_fstorage_ram_stat_reset();
+
+    for (uint32_t offset = 0; offset < bytes; offset += chunk)
+    {
+        uint32_t const addr = m_dfu_fs.start_addr + offset;
+        uint32_t const len  = MIN(chunk, bytes - offset);
+
+        if ((offset % page_size) == 0)
+        {
+            while (nrf_dfu_flash_erase(addr, 1, NULL) == NRF_ERROR_NO_MEM)
+            {
+                nrf_fstorage_ram_process(STEP_US);
+                stalls++;
+            }
+        }
+
+        while (nrf_dfu_flash_store(addr, &image[offset], len, NULL) == NRF_ERROR_NO_MEM)
+        {
+            nrf_fstorage_ram_process(STEP_US);
+            stalls++;
+        }
+
+        /* The next chunk is received. */
+        nrf_fstorage_ram_process(interval_us);
+    }
+
+    flash_idle_wait();
+
+    if (memcmp((void *)(uintptr_t)m_dfu_fs.start_addr, image, bytes) != 0)
+    {
+        printf("The stored image does not match.\n");
+        return 1;
+    }
+
+    printf("DFU: %u bytes in chunks of %u bytes every %u us, waited %u us on a full queue\n",
+           (unsigned)bytes, (unsigned)chunk, (unsigned)interval_us, (unsigned)(stalls * STEP_US));
+    stat_print(bytes, NRF_FSTORAGE_RAM_SIZE / CODE_PAGE_SIZE);
+
+    return 0;
+}
+
+
+int main(int argc, char ** argv)
+{
+    if ((argc > 1) && (strcmp(argv[1], "fds") == 0))
+    {
+        return fds_bench((argc > 2) ? strtoul(argv[2], NULL, 0) : 16,
+                         (argc > 3) ? strtoul(argv[3], NULL, 0) : 4,
+                         (argc > 4) ? strtoul(argv[4], NULL, 0) : 1000);
+    }
+
+    if ((argc > 1) && (strcmp(argv[1], "dfu") == 0))
+    {
+        return dfu_bench((argc > 2) ? strtoul(argv[2], NULL, 0) : 32768,
+                         (argc > 3) ? strtoul(argv[3], NULL, 0) : 256,
+                         (argc > 4) ? strtoul(argv[4], NULL, 0) : 2000);
+    }
+
+    printf("Usage: %s fds [records] [words] [updates]\n"
+           "       %s dfu [bytes] [chunk] [interval_us]\n", argv[0], argv[0]);
+    return 1;
+}
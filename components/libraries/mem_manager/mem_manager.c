@@ -41,6 +41,7 @@
 #if NRF_MODULE_ENABLED(MEM_MANAGER)
 #include "mem_manager.h"
 #include "nrf_assert.h"
+#include "app_util_platform.h"
 #define NRF_LOG_MODULE_NAME mem_mngr
 #include "nrf_log.h"
 NRF_LOG_MODULE_REGISTER();
@@ -397,7 +398,7 @@ NRF_LOG_MODULE_REGISTER();
                            MEMORY_MANAGER_MEDIUM_BLOCK_COUNT  +                                     \
                            MEMORY_MANAGER_LARGE_BLOCK_COUNT   +                                     \
                            MEMORY_MANAGER_XLARGE_BLOCK_COUNT  +                                     \
-                           MEMORY_MANAGER_XLARGE_BLOCK_COUNT)
+                           MEMORY_MANAGER_XXLARGE_BLOCK_COUNT)
 
 
 /**@brief Total memory managed by the module. */
@@ -420,7 +421,25 @@ NRF_LOG_MODULE_REGISTER();
 #define BLOCK_CAT_XXL                  6                                                            /**< Extra Extra Large category identifier. */
 
 #define BITMAP_SIZE                    32                                                           /**< Bitmap size for each word used to contain block information. */
-#define BLOCK_BITMAP_ARRAY_SIZE        CEIL_DIV(TOTAL_BLOCK_COUNT, BITMAP_SIZE)                     /**< Determines number of blocks needed for book keeping availability status of all blocks. */
+#define BITMAP_WORDS(COUNT)            CEIL_DIV((COUNT), BITMAP_SIZE)                               /**< Number of bitmap words needed for book keeping availability status of COUNT blocks. */
+#define BITMAP_BIT(INDEX)              (0x80000000UL >> (INDEX))                                    /**< Bit representing INDEX in a bitmap word. Most significant bit first, so that __CLZ() finds the lowest index. */
+#define BLOCK_BITMAP_ARRAY_SIZE        (BITMAP_WORDS(MEMORY_MANAGER_XXSMALL_BLOCK_COUNT) +          \
+                                        BITMAP_WORDS(MEMORY_MANAGER_XSMALL_BLOCK_COUNT)  +          \
+                                        BITMAP_WORDS(MEMORY_MANAGER_SMALL_BLOCK_COUNT)   +          \
+                                        BITMAP_WORDS(MEMORY_MANAGER_MEDIUM_BLOCK_COUNT)  +          \
+                                        BITMAP_WORDS(MEMORY_MANAGER_LARGE_BLOCK_COUNT)   +          \
+                                        BITMAP_WORDS(MEMORY_MANAGER_XLARGE_BLOCK_COUNT)  +          \
+                                        BITMAP_WORDS(MEMORY_MANAGER_XXLARGE_BLOCK_COUNT))           /**< Determines number of blocks needed for book keeping availability status of all blocks. */
+#define MAX_BLOCK_COUNT                (BITMAP_SIZE * BITMAP_SIZE)                                  /**< Maximum number of blocks in a category, one summary word per category. */
+
+STATIC_ASSERT(BLOCK_CAT_COUNT == NRF_MEM_BLOCK_CAT_COUNT);
+STATIC_ASSERT((MEMORY_MANAGER_XXSMALL_BLOCK_COUNT <= MAX_BLOCK_COUNT) &&
+              (MEMORY_MANAGER_XSMALL_BLOCK_COUNT  <= MAX_BLOCK_COUNT) &&
+              (MEMORY_MANAGER_SMALL_BLOCK_COUNT   <= MAX_BLOCK_COUNT) &&
+              (MEMORY_MANAGER_MEDIUM_BLOCK_COUNT  <= MAX_BLOCK_COUNT) &&
+              (MEMORY_MANAGER_LARGE_BLOCK_COUNT   <= MAX_BLOCK_COUNT) &&
+              (MEMORY_MANAGER_XLARGE_BLOCK_COUNT  <= MAX_BLOCK_COUNT) &&
+              (MEMORY_MANAGER_XXLARGE_BLOCK_COUNT <= MAX_BLOCK_COUNT));
 
 
 /**@brief Lookup table for maximum memory size per block category. */
@@ -435,28 +454,16 @@ static const uint32_t m_block_size[BLOCK_CAT_COUNT] =
     MEMORY_MANAGER_XXLARGE_BLOCK_SIZE
 };
 
-/**@brief Lookup table for block start index for each block caetgory. */
-static const uint32_t m_block_start[BLOCK_CAT_COUNT] =
-{
-    XXSMALL_BLOCK_START,
-    XSMALL_BLOCK_START,
-    SMALL_BLOCK_START,
-    MEDIUM_BLOCK_START,
-    LARGE_BLOCK_START,
-    XLARGE_BLOCK_START,
-    XXLARGE_BLOCK_START
-};
-
-/**@brief Lookup table for last block index for each block category. */
-static const uint32_t m_block_end[BLOCK_CAT_COUNT] =
+/**@brief Lookup table for count of block available in each block category. */
+static const uint32_t m_block_count[BLOCK_CAT_COUNT] =
 {
-    XXSMALL_BLOCK_END,
-    XSMALL_BLOCK_END,
-    SMALL_BLOCK_END,
-    MEDIUM_BLOCK_END,
-    LARGE_BLOCK_END,
-    XLARGE_BLOCK_END,
-    XXLARGE_BLOCK_END
+    MEMORY_MANAGER_XXSMALL_BLOCK_COUNT,
+    MEMORY_MANAGER_XSMALL_BLOCK_COUNT,
+    MEMORY_MANAGER_SMALL_BLOCK_COUNT,
+    MEMORY_MANAGER_MEDIUM_BLOCK_COUNT,
+    MEMORY_MANAGER_LARGE_BLOCK_COUNT,
+    MEMORY_MANAGER_XLARGE_BLOCK_COUNT,
+    MEMORY_MANAGER_XXLARGE_BLOCK_COUNT
 };
 
 /**@brief Lookup table for memory start range for each block category. */
@@ -472,7 +479,16 @@ static const uint32_t m_block_mem_start[BLOCK_CAT_COUNT] =
 };
 
 static uint8_t  m_memory[TOTAL_MEMORY_SIZE];                                                        /**< Memory managed by the module. */
-static uint32_t m_mem_pool[BLOCK_BITMAP_ARRAY_SIZE];                                                /**< Bitmap used for book-keeping availability of all blocks managed by the module.  */
+static uint32_t m_mem_pool[BLOCK_BITMAP_ARRAY_SIZE];                                                /**< Bitmap used for book-keeping availability of all blocks managed by the module, a set bit marks a free block. */
+static uint8_t  m_bitmap_start[BLOCK_CAT_COUNT];                                                    /**< Index of the first bitmap word of each block category. */
+static uint32_t m_bitmap_summary[BLOCK_CAT_COUNT];                                                  /**< For each block category, bit set for each bitmap word with a free block. */
+static uint32_t m_cat_free;                                                                         /**< Bit set for each block category with a free block. */
+static uint16_t m_cat_in_use[BLOCK_CAT_COUNT];                                                      /**< Number of blocks in use in each block category. */
+static uint16_t m_cat_max_in_use[BLOCK_CAT_COUNT];                                                  /**< Maximum number of blocks in use in each block category. */
+static uint32_t m_in_use_size;                                                                      /**< Memory in allocated blocks. */
+static uint32_t m_max_in_use_size;                                                                  /**< Maximum memory in allocated blocks. */
+static uint32_t m_spilled_count;                                                                    /**< Number of allocations served from a larger block category. */
+static uint32_t m_failed_count;                                                                     /**< Number of failed allocations. */
 
 #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
 
@@ -503,24 +519,6 @@ static uint32_t m_min_size[BLOCK_CAT_COUNT]  =
 /**@brief Table for book keeping largest size allocated in each block range. */
 static uint32_t m_max_size[BLOCK_CAT_COUNT];
 
-/**@brief Global pointing to minimum size holder for block type being allocated. */
-static uint32_t * p_min_size;
-
-/**@brief Global pointing to maximum size holder for block type being allocated. */
-static uint32_t * p_max_size;
-
-/**@brief Lookup table for count of block available in each block category. */
-static uint32_t m_block_count[BLOCK_CAT_COUNT] =
-{
-    MEMORY_MANAGER_XXSMALL_BLOCK_COUNT,
-    MEMORY_MANAGER_XSMALL_BLOCK_COUNT,
-    MEMORY_MANAGER_SMALL_BLOCK_COUNT,
-    MEMORY_MANAGER_MEDIUM_BLOCK_COUNT,
-    MEMORY_MANAGER_LARGE_BLOCK_COUNT,
-    MEMORY_MANAGER_XLARGE_BLOCK_COUNT,
-    MEMORY_MANAGER_XXLARGE_BLOCK_COUNT
-};
-
 #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
 
 SDK_MUTEX_DEFINE(m_mm_mutex)                                                                        /**< Mutex variable. Currently unused, this declaration does not occupy any space in RAM. */
@@ -534,93 +532,95 @@ static bool     m_module_initialized = false;
  * @details Function to get X and Y co-ordinates for the block identified by index.
  *          Here, X determines relevant word for the block. Y determines the actual bit in the word.
  *
- * @param[in]  index Identifies the block.
- * @param[out] p_x   Points to the word that contains the bit representing the block.
- * @param[out] p_y   Contains the bitnumber in the the word 'X' relevant to the block.
+ * @param[in]  block_cat   Identifies the category of block.
+ * @param[in]  block_index Identifies the block within its category.
+ * @param[out] p_x         Points to the word that contains the bit representing the block.
+ * @param[out] p_y         Contains the bitnumber in the the word 'X' relevant to the block.
  */
-static __INLINE void get_block_coordinates(uint32_t block_index, uint32_t * p_x, uint32_t * p_y)
+static __INLINE void get_block_coordinates(uint32_t   block_cat,
+                                           uint32_t   block_index,
+                                           uint32_t * p_x,
+                                           uint32_t * p_y)
 {
     // Determine position of the block in the bitmap.
     // X determines relevant word for the block. Y determines the actual bit in the word.
-    const uint32_t x = block_index / BITMAP_SIZE;
-    const uint32_t y = (block_index - x * BITMAP_SIZE);
-
-    (*p_x) = x;
-    (*p_y) = y;
+    (*p_x) = m_bitmap_start[block_cat] + (block_index / BITMAP_SIZE);
+    (*p_y) = block_index % BITMAP_SIZE;
 }
 
 
 /**@brief Initializes the block by setting it to be free. */
-static void block_init (uint32_t block_index)
+static void block_init(uint32_t block_cat, uint32_t block_index)
 {
     uint32_t x;
     uint32_t y;
 
-    // Determine position of the block in the bitmap.
-    // X determines relevant word for the block. Y determines the actual bit in the word.
-    get_block_coordinates(block_index, &x, &y);
+    get_block_coordinates(block_cat, block_index, &x, &y);
 
-    // Set bit related to the block to indicate that the block is free.
-    SET_BIT(m_mem_pool[x], y);
+    // Set bit related to the block to indicate that the block is free, and mark the word and the
+    // category as having a free block.
+    m_mem_pool[x]                 |= BITMAP_BIT(y);
+    m_bitmap_summary[block_cat]   |= BITMAP_BIT(x - m_bitmap_start[block_cat]);
+    m_cat_free                    |= BITMAP_BIT(block_cat);
 }
 
 
-/**@brief Function to get the category of the block of size 'size' or block number 'block_index'.*/
-static __INLINE uint32_t get_block_cat(uint32_t size, uint32_t block_index)
+/**@brief Function to get the smallest category of blocks of size 'size' or larger.
+ *
+ * @return Block category, or BLOCK_CAT_COUNT if no category is large enough.
+ */
+static __INLINE uint32_t get_block_cat(uint32_t size)
 {
     for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
     {
-        if (((size != 0) && (size <= m_block_size[block_cat]) &&
-            (m_block_end[block_cat] != m_block_start[block_cat])) ||
-            (block_index < m_block_end[block_cat]))
+        if ((size <= m_block_size[block_cat]) && (m_block_count[block_cat] != 0))
         {
             return block_cat;
         }
     }
 
-    return 0;
-}
-
-
-/**@brief Function to get the size of the block number 'block_index'. */
-static __INLINE uint32_t get_block_size(uint32_t block_index)
-{
-    const uint32_t block_cat = get_block_cat(0, block_index);
-
-    #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
-        p_min_size = &m_min_size[block_cat];
-        p_max_size = &m_max_size[block_cat];
-    #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
-
-    return m_block_size[block_cat];
+    return BLOCK_CAT_COUNT;
 }
 
 
-/**@brief Function to free the block identified by block number 'block_index'. */
-static bool is_block_free(uint32_t block_index)
+/**@brief Function to check if the block identified by block number 'block_index' is free. */
+static bool is_block_free(uint32_t block_cat, uint32_t block_index)
 {
     uint32_t x;
     uint32_t y;
 
-    // Determine position of the block in the bitmap.
-    // X determines relevant word for the block. Y determines the actual bit in the word.
-    get_block_coordinates(block_index, &x, &y);
+    get_block_coordinates(block_cat, block_index, &x, &y);
 
-    return IS_SET(m_mem_pool[x], y);
+    return ((m_mem_pool[x] & BITMAP_BIT(y)) != 0);
 }
 
 
-/**@brief Function to allocate the block identified by block number 'block_index'. */
-static void block_allocate(uint32_t block_index)
+/**@brief Function to allocate the first free block of category 'block_cat'.
+ *
+ * @details The category must have a free block. The word holding a free block is found in the
+ *          category summary, and the block in that word, each with a single count of leading zeros.
+ *
+ * @return Number of the allocated block in its category.
+ */
+static uint32_t block_allocate(uint32_t block_cat)
 {
-    uint32_t x;
-    uint32_t y;
+    const uint32_t   word    = __CLZ(m_bitmap_summary[block_cat]);
+    uint32_t * const p_word  = &m_mem_pool[m_bitmap_start[block_cat] + word];
+    const uint32_t   bit     = __CLZ(*p_word);
 
-    // Determine position of the block in the bitmap.
-    // X determines relevant word for the block. Y determines the actual bit in the word.
-    get_block_coordinates(block_index, &x, &y);
+    (*p_word) &= ~BITMAP_BIT(bit);
+
+    if ((*p_word) == 0)
+    {
+        m_bitmap_summary[block_cat] &= ~BITMAP_BIT(word);
 
-    CLR_BIT(m_mem_pool[x], y);
+        if (m_bitmap_summary[block_cat] == 0)
+        {
+            m_cat_free &= ~BITMAP_BIT(block_cat);
+        }
+    }
+
+    return (word * BITMAP_SIZE) + bit;
 }
 
 
@@ -632,11 +632,28 @@ uint32_t nrf_mem_init(void)
 
     MM_MUTEX_LOCK();
 
-    uint32_t block_index = 0;
+    uint32_t bitmap_index = 0;
+
+    memset(m_mem_pool, 0, sizeof(m_mem_pool));
+    memset(m_bitmap_summary, 0, sizeof(m_bitmap_summary));
+    memset(m_cat_in_use, 0, sizeof(m_cat_in_use));
+    memset(m_cat_max_in_use, 0, sizeof(m_cat_max_in_use));
+
+    m_cat_free        = 0;
+    m_in_use_size     = 0;
+    m_max_in_use_size = 0;
+    m_spilled_count   = 0;
+    m_failed_count    = 0;
 
-    for (block_index = 0; block_index < TOTAL_BLOCK_COUNT; block_index++)
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
     {
-        block_init(block_index);
+        m_bitmap_start[block_cat] = bitmap_index;
+        bitmap_index += BITMAP_WORDS(m_block_count[block_cat]);
+
+        for (uint32_t block_index = 0; block_index < m_block_count[block_cat]; block_index++)
+        {
+            block_init(block_cat, block_index);
+        }
     }
 
 #if (MEM_MANAGER_DISABLE_API_PARAM_CHECK == 0)
@@ -669,43 +686,44 @@ uint32_t nrf_mem_reserve(uint8_t ** pp_buffer, uint32_t * p_size)
 
     MM_MUTEX_LOCK();
 
-    const uint32_t block_cat    = get_block_cat(requested_size, TOTAL_BLOCK_COUNT);
-    uint32_t       block_index  = m_block_start[block_cat];
-    uint32_t       memory_index = m_block_mem_start[block_cat];
-    uint32_t       err_code     = (NRF_ERROR_NO_MEM | NRF_ERROR_MEMORY_MANAGER_ERR_BASE);
-
-    NRF_LOG_DEBUG("[MM]: Start index for the pool = 0x%08lX, total block count 0x%08X",
-           block_index,
-           TOTAL_BLOCK_COUNT);
+    const uint32_t block_cat = get_block_cat(requested_size);
+    // Categories with a free block, starting from the smallest one that fits.
+    const uint32_t cat_free  = m_cat_free & (0xFFFFFFFFUL >> block_cat);
+    uint32_t       err_code  = (NRF_ERROR_NO_MEM | NRF_ERROR_MEMORY_MANAGER_ERR_BASE);
 
-    for (; block_index < TOTAL_BLOCK_COUNT; block_index++)
+    if (cat_free != 0)
     {
-        uint32_t block_size = get_block_size(block_index);
+        const uint32_t alloc_cat   = __CLZ(cat_free);
+        const uint32_t block_index = block_allocate(alloc_cat);
+        const uint32_t block_size  = m_block_size[alloc_cat];
 
-        if (is_block_free(block_index) == true)
-        {
-            NRF_LOG_DEBUG("[MM]: Reserving block 0x%08lX", block_index);
+        NRF_LOG_DEBUG("[MM]: Reserving block 0x%08lX of category %d", block_index, alloc_cat);
 
-            // Search succeeded, found free block.
-            err_code     = NRF_SUCCESS;
+        // Search succeeded, found free block.
+        err_code     = NRF_SUCCESS;
 
-            // Allocate block.
-            block_allocate(block_index);
+        (*pp_buffer) = &m_memory[m_block_mem_start[alloc_cat] + (block_index * block_size)];
+        (*p_size)    = block_size;
 
-            (*pp_buffer) = &m_memory[memory_index];
-            (*p_size)    = block_size;
+        if (alloc_cat != block_cat)
+        {
+            m_spilled_count++;
+        }
 
-            #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
-                (*p_min_size) = MIN((*p_min_size), requested_size);
-                (*p_max_size) = MAX((*p_max_size), requested_size);
-            #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
+        m_cat_in_use[alloc_cat]++;
+        m_cat_max_in_use[alloc_cat] = MAX(m_cat_max_in_use[alloc_cat], m_cat_in_use[alloc_cat]);
+        m_in_use_size              += block_size;
+        m_max_in_use_size           = MAX(m_max_in_use_size, m_in_use_size);
 
-            break;
-        }
-        memory_index += block_size;
+        #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
+            m_min_size[alloc_cat] = MIN(m_min_size[alloc_cat], requested_size);
+            m_max_size[alloc_cat] = MAX(m_max_size[alloc_cat], requested_size);
+        #endif // MEM_MANAGER_ENABLE_DIAGNOSTICS
     }
-    if (err_code != NRF_SUCCESS)
+    else
     {
+        m_failed_count++;
+
         NRF_LOG_DEBUG ("[MM]: Memory reservation result %d, memory %p, size %d!",
                 err_code,
                 (uint32_t)(*pp_buffer),
@@ -773,19 +791,29 @@ void nrf_free(void * p_mem)
 
     MM_MUTEX_LOCK();
 
-    uint32_t index;
-    uint32_t memory_index = 0;
+    const uint32_t memory_index = (uint8_t *)p_mem - m_memory;
 
-    for (index = 0; index < TOTAL_BLOCK_COUNT; index++)
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
     {
-        if (&m_memory[memory_index] == p_mem)
+        const uint32_t block_size = m_block_size[block_cat];
+        const uint32_t offset     = memory_index - m_block_mem_start[block_cat];
+
+        if ((memory_index >= m_block_mem_start[block_cat]) &&
+            (offset < (m_block_count[block_cat] * block_size)))
         {
-            // Found a free block of memory, assign.
-            NRF_LOG_DEBUG("[MM]: << Freeing block %d.", index);
-            block_init(index);
+            const uint32_t block_index = offset / block_size;
+
+            if (((offset % block_size) == 0) && !is_block_free(block_cat, block_index))
+            {
+                // Found the block of memory, free it.
+                NRF_LOG_DEBUG("[MM]: << Freeing block %d of category %d.", block_index, block_cat);
+                block_init(block_cat, block_index);
+
+                m_cat_in_use[block_cat]--;
+                m_in_use_size -= block_size;
+            }
             break;
         }
-        memory_index += get_block_size(index);
     }
 
     MM_MUTEX_UNLOCK();
@@ -801,6 +829,57 @@ void * nrf_realloc(void * p_mem, uint32_t size)
 }
 
 
+uint32_t nrf_mem_stats_get(nrf_mem_stats_t * p_stats)
+{
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(p_stats);
+
+    MM_MUTEX_LOCK();
+
+    p_stats->total_size        = TOTAL_MEMORY_SIZE;
+    p_stats->in_use_size       = m_in_use_size;
+    p_stats->max_in_use_size   = m_max_in_use_size;
+    p_stats->largest_free_size = 0;
+    p_stats->spilled_count     = m_spilled_count;
+    p_stats->failed_count      = m_failed_count;
+
+    for (uint32_t block_cat = 0; block_cat < BLOCK_CAT_COUNT; block_cat++)
+    {
+        if ((m_cat_free & BITMAP_BIT(block_cat)) != 0)
+        {
+            p_stats->largest_free_size = MAX(p_stats->largest_free_size, m_block_size[block_cat]);
+        }
+    }
+
+    MM_MUTEX_UNLOCK();
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t nrf_mem_cat_stats_get(uint32_t block_cat, nrf_mem_cat_stats_t * p_stats)
+{
+    VERIFY_MODULE_INITIALIZED();
+    NULL_PARAM_CHECK(p_stats);
+
+    if (block_cat >= BLOCK_CAT_COUNT)
+    {
+        return (NRF_ERROR_INVALID_PARAM | NRF_ERROR_MEMORY_MANAGER_ERR_BASE);
+    }
+
+    MM_MUTEX_LOCK();
+
+    p_stats->block_size  = m_block_size[block_cat];
+    p_stats->block_count = m_block_count[block_cat];
+    p_stats->in_use      = m_cat_in_use[block_cat];
+    p_stats->max_in_use  = m_cat_max_in_use[block_cat];
+
+    MM_MUTEX_UNLOCK();
+
+    return NRF_SUCCESS;
+}
+
+
 #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
 
 /**@brief Function to format and print information with respect to each block.
@@ -819,10 +898,8 @@ void print_block_info(uint32_t block_cat, uint32_t * p_mem_in_use)
     #define ASCII_VALUE_FOR_SPACE   32
 
     char           print_buffer[PRINT_BUFFER_SIZE];
-    const uint32_t total_count   = (m_block_start[block_cat] + m_block_count[block_cat]);
-    uint32_t       in_use        = 0;
-    uint32_t       num_of_blocks = 0;
-    uint32_t       index         = m_block_start[block_cat];
+    const uint32_t num_of_blocks = m_cat_in_use[block_cat];
+    const uint32_t in_use        = num_of_blocks * m_block_size[block_cat];
     uint32_t       column_number;
 
     // No statistic provided in case block category is not included.
@@ -830,15 +907,6 @@ void print_block_info(uint32_t block_cat, uint32_t * p_mem_in_use)
     {
         memset(print_buffer, ASCII_VALUE_FOR_SPACE, PRINT_BUFFER_SIZE);
 
-        for (; index < total_count; index++)
-        {
-            if (is_block_free(index) == false)
-            {
-                num_of_blocks++;
-                in_use += m_block_size[block_cat];
-            }
-        }
-
         column_number = 0;
         snprintf(&print_buffer[column_number * PRINT_COLUMN_WIDTH],
                  PRINT_COLUMN_WIDTH,
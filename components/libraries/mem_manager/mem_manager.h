@@ -56,6 +56,10 @@
  * To use fewer than seven buffer pools, do not define the count for the unwanted block
  * or explicitly set it to zero. At least one block category must be configured
  * for this module to function as expected.
+ *
+ * Free blocks are tracked in a bitmap per block category, with a summary word per category and
+ * a word marking categories with a free block. Both reservation and freeing take constant time,
+ * regardless of how many blocks are in use.
  */
 
 #ifndef MEM_MANAGER_H__
@@ -67,6 +71,29 @@
 extern "C" {
 #endif
 
+#define NRF_MEM_BLOCK_CAT_COUNT 7   /**< Number of block categories, from 0 (xxsmall) to 6 (xxlarge). */
+
+/**@brief Memory Manager usage statistics. */
+typedef struct
+{
+    uint32_t total_size;            /**< Memory managed by the module, in bytes. */
+    uint32_t in_use_size;           /**< Memory in reserved blocks, in bytes. */
+    uint32_t max_in_use_size;       /**< Highest value of in_use_size observed (high-water mark). */
+    uint32_t largest_free_size;     /**< Size of the largest free block, in bytes. */
+    uint32_t spilled_count;         /**< Number of reservations served by a larger block category
+                                         because the smallest fitting category was exhausted. */
+    uint32_t failed_count;          /**< Number of failed reservations. */
+} nrf_mem_stats_t;
+
+/**@brief Block category usage statistics. */
+typedef struct
+{
+    uint32_t block_size;            /**< Size of the blocks in the category. */
+    uint16_t block_count;           /**< Number of blocks in the category. */
+    uint16_t in_use;                /**< Number of reserved blocks. */
+    uint16_t max_in_use;            /**< Highest number of reserved blocks observed (high-water mark). */
+} nrf_mem_cat_stats_t;
+
 
 /**@brief Initializes Memory Manager.
  *
@@ -151,6 +178,32 @@ void nrf_free(void * p_buffer);
  */
 void * nrf_realloc(void *p_buffer, uint32_t size);
 
+
+/**@brief Function for getting the Memory Manager usage statistics.
+ *
+ * @details Cheap enough to be polled in a final application. Free memory split over blocks smaller
+ *          than the largest request the application makes, and a growing spilled count, indicate
+ *          that block sizes or counts need tuning.
+ *
+ * @param[out] p_stats   Usage statistics.
+ *
+ * @retval NRF_SUCCESS If the statistics were returned.
+ *         Otherwise, an error code that indicates the reason for the failure is returned.
+ */
+uint32_t nrf_mem_stats_get(nrf_mem_stats_t * p_stats);
+
+
+/**@brief Function for getting the usage statistics of a block category.
+ *
+ * @param[in]  block_cat Block category, from 0 (xxsmall) to @ref NRF_MEM_BLOCK_CAT_COUNT - 1
+ *                       (xxlarge).
+ * @param[out] p_stats   Usage statistics of the category.
+ *
+ * @retval NRF_SUCCESS If the statistics were returned.
+ *         Otherwise, an error code that indicates the reason for the failure is returned.
+ */
+uint32_t nrf_mem_cat_stats_get(uint32_t block_cat, nrf_mem_cat_stats_t * p_stats);
+
 #ifdef MEM_MANAGER_ENABLE_DIAGNOSTICS
 
 /**@brief Function to print statstics related to memory blocks managed by memory manager.
@@ -68,6 +68,240 @@ __STATIC_INLINE size_t queue_utilization_get(nrf_queue_t const * p_queue)
     return (back >= front) ? (back - front) : (p_queue->size + 1 - front + back);
 }
 
+/**@brief Write an element to the queue buffer.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ * @param[in]   idx         Index of the element in the buffer.
+ * @param[in]   p_element   Pointer to the element to write.
+ */
+__STATIC_INLINE void element_write(nrf_queue_t const * p_queue, size_t idx, void const * p_element)
+{
+    switch (p_queue->element_size)
+    {
+        case sizeof(uint8_t):
+            ((uint8_t *)p_queue->p_buffer)[idx] = *((uint8_t *)p_element);
+            break;
+
+        case sizeof(uint16_t):
+            ((uint16_t *)p_queue->p_buffer)[idx] = *((uint16_t *)p_element);
+            break;
+
+        case sizeof(uint32_t):
+            ((uint32_t *)p_queue->p_buffer)[idx] = *((uint32_t *)p_element);
+            break;
+
+        case sizeof(uint64_t):
+            ((uint64_t *)p_queue->p_buffer)[idx] = *((uint64_t *)p_element);
+            break;
+
+        default:
+            memcpy((void *)((size_t)p_queue->p_buffer + idx * p_queue->element_size),
+                   p_element,
+                   p_queue->element_size);
+            break;
+    }
+}
+
+/**@brief Read an element from the queue buffer.
+ *
+ * @param[in]   p_queue     Pointer to the queue instance.
+ * @param[in]   idx         Index of the element in the buffer.
+ * @param[out]  p_element   Pointer where the element will be copied.
+ */
+__STATIC_INLINE void element_read(nrf_queue_t const * p_queue, size_t idx, void * p_element)
+{
+    switch (p_queue->element_size)
+    {
+        case sizeof(uint8_t):
+            *((uint8_t *)p_element) = ((uint8_t *)p_queue->p_buffer)[idx];
+            break;
+
+        case sizeof(uint16_t):
+            *((uint16_t *)p_element) = ((uint16_t *)p_queue->p_buffer)[idx];
+            break;
+
+        case sizeof(uint32_t):
+            *((uint32_t *)p_element) = ((uint32_t *)p_queue->p_buffer)[idx];
+            break;
+
+        case sizeof(uint64_t):
+            *((uint64_t *)p_element) = ((uint64_t *)p_queue->p_buffer)[idx];
+            break;
+
+        default:
+            memcpy(p_element,
+                   (void const *)((size_t)p_queue->p_buffer + idx * p_queue->element_size),
+                   p_queue->element_size);
+            break;
+    }
+}
+
+/**@brief Copy elements to the queue buffer, wrapping around at the end of the buffer.
+ *
+ * @param[in]   p_queue             Pointer to the queue instance.
+ * @param[in]   idx                 Index of the first element in the buffer.
+ * @param[in]   p_data              Pointer to the buffer with elements to write.
+ * @param[in]   element_count       Number of elements to write.
+ *
+ * @return      Index following the last written element.
+ */
+static size_t buffer_write(nrf_queue_t const * p_queue,
+                           size_t              idx,
+                           void const        * p_data,
+                           size_t              element_count)
+{
+    if (element_count == 1)
+    {
+        element_write(p_queue, idx, p_data);
+        return nrf_queue_next_idx(p_queue, idx);
+    }
+
+    size_t continuous = MIN(element_count, p_queue->size + 1 - idx);
+
+    memcpy((void *)((size_t)p_queue->p_buffer + idx * p_queue->element_size),
+           p_data,
+           continuous * p_queue->element_size);
+
+    if (element_count > continuous)
+    {
+        memcpy(p_queue->p_buffer,
+               (void const *)((size_t)p_data + continuous * p_queue->element_size),
+               (element_count - continuous) * p_queue->element_size);
+    }
+
+    idx += element_count;
+    return (idx <= p_queue->size) ? idx : (idx - p_queue->size - 1);
+}
+
+/**@brief Copy elements from the queue buffer, wrapping around at the end of the buffer.
+ *
+ * @param[in]   p_queue             Pointer to the queue instance.
+ * @param[in]   idx                 Index of the first element in the buffer.
+ * @param[out]  p_data              Pointer to the buffer where elements will be copied.
+ * @param[in]   element_count       Number of elements to read.
+ *
+ * @return      Index following the last read element.
+ */
+static size_t buffer_read(nrf_queue_t const * p_queue,
+                          size_t              idx,
+                          void              * p_data,
+                          size_t              element_count)
+{
+    if (element_count == 1)
+    {
+        element_read(p_queue, idx, p_data);
+        return nrf_queue_next_idx(p_queue, idx);
+    }
+
+    size_t continuous = MIN(element_count, p_queue->size + 1 - idx);
+
+    memcpy(p_data,
+           (void const *)((size_t)p_queue->p_buffer + idx * p_queue->element_size),
+           continuous * p_queue->element_size);
+
+    if (element_count > continuous)
+    {
+        memcpy((void *)((size_t)p_data + continuous * p_queue->element_size),
+               p_queue->p_buffer,
+               (element_count - continuous) * p_queue->element_size);
+    }
+
+    idx += element_count;
+    return (idx <= p_queue->size) ? idx : (idx - p_queue->size - 1);
+}
+
+/**@brief Add elements to a queue in @ref NRF_QUEUE_MODE_SPSC.
+ *
+ * @details Must only be called by the producer. The back index is only written by the producer
+ *          and the front index only by the consumer, so no critical region is needed.
+ *
+ * @param[in]   p_queue             Pointer to the queue instance.
+ * @param[in]   p_data              Pointer to the buffer with elements to write.
+ * @param[in]   element_count       Maximum number of elements to write.
+ * @param[in]   min_count           If there is no room for that many elements, none are written.
+ *
+ * @return      The number of added elements.
+ */
+static size_t spsc_in(nrf_queue_t const * p_queue,
+                      void const        * p_data,
+                      size_t              element_count,
+                      size_t              min_count)
+{
+    size_t back  = p_queue->p_cb->back;
+    size_t front = p_queue->p_cb->front;
+
+    // Do not overwrite elements before the consumer has finished reading them.
+    __DMB();
+
+    size_t utilization = (back >= front) ? (back - front) : (p_queue->size + 1 - front + back);
+    size_t available   = p_queue->size - utilization;
+
+    if (available < min_count)
+    {
+        return 0;
+    }
+
+    element_count = MIN(element_count, available);
+    back          = buffer_write(p_queue, back, p_data, element_count);
+
+    // Publish the elements only once they have been written.
+    __DMB();
+    p_queue->p_cb->back = back;
+
+    // Update utilization.
+    utilization += element_count;
+    if (p_queue->p_cb->max_utilization < utilization)
+    {
+        p_queue->p_cb->max_utilization = utilization;
+    }
+
+    return element_count;
+}
+
+/**@brief Remove elements from a queue in @ref NRF_QUEUE_MODE_SPSC.
+ *
+ * @details Must only be called by the consumer.
+ *
+ * @param[in]   p_queue             Pointer to the queue instance.
+ * @param[out]  p_data              Pointer to the buffer where elements will be copied.
+ * @param[in]   element_count       Maximum number of elements to read.
+ * @param[in]   min_count           If there are fewer elements in the queue, none are read.
+ * @param[in]   just_peek           If true, the elements will not be removed from queue.
+ *
+ * @return      The number of read elements.
+ */
+static size_t spsc_out(nrf_queue_t const * p_queue,
+                       void              * p_data,
+                       size_t              element_count,
+                       size_t              min_count,
+                       bool                just_peek)
+{
+    size_t front = p_queue->p_cb->front;
+    size_t back  = p_queue->p_cb->back;
+
+    // Do not read elements before the producer has finished writing them.
+    __DMB();
+
+    size_t utilization = (back >= front) ? (back - front) : (p_queue->size + 1 - front + back);
+
+    if (utilization < min_count)
+    {
+        return 0;
+    }
+
+    element_count = MIN(element_count, utilization);
+    front         = buffer_read(p_queue, front, p_data, element_count);
+
+    if (!just_peek)
+    {
+        // Release the elements only once they have been read.
+        __DMB();
+        p_queue->p_cb->front = front;
+    }
+
+    return element_count;
+}
+
 bool nrf_queue_is_full(nrf_queue_t const * p_queue)
 {
     ASSERT(p_queue != NULL);
@@ -84,6 +318,11 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
     ASSERT(p_queue != NULL);
     ASSERT(p_element != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        return (spsc_in(p_queue, p_element, 1, 1) == 1) ? NRF_SUCCESS : NRF_ERROR_NO_MEM;
+    }
+
     CRITICAL_REGION_ENTER();
     bool is_full = nrf_queue_is_full(p_queue);
 
@@ -99,30 +338,7 @@ ret_code_t nrf_queue_push(nrf_queue_t const * p_queue, void const * p_element)
         }
 
         // Write a new element.
-        switch (p_queue->element_size)
-        {
-            case sizeof(uint8_t):
-                ((uint8_t *)p_queue->p_buffer)[write_pos] = *((uint8_t *)p_element);
-                break;
-
-            case sizeof(uint16_t):
-                ((uint16_t *)p_queue->p_buffer)[write_pos] = *((uint16_t *)p_element);
-                break;
-
-            case sizeof(uint32_t):
-                ((uint32_t *)p_queue->p_buffer)[write_pos] = *((uint32_t *)p_element);
-                break;
-
-            case sizeof(uint64_t):
-                ((uint64_t *)p_queue->p_buffer)[write_pos] = *((uint64_t *)p_element);
-                break;
-
-            default:
-                memcpy((void *)((size_t)p_queue->p_buffer + write_pos * p_queue->element_size),
-                       p_element,
-                       p_queue->element_size);
-                break;
-        }
+        element_write(p_queue, write_pos, p_element);
 
         // Update utilization.
         size_t utilization = queue_utilization_get(p_queue);
@@ -150,6 +366,12 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
     ASSERT(p_queue      != NULL);
     ASSERT(p_element    != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        return (spsc_out(p_queue, p_element, 1, 1, just_peek) == 1) ? NRF_SUCCESS
+                                                                    : NRF_ERROR_NOT_FOUND;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (!nrf_queue_is_empty(p_queue))
@@ -164,30 +386,7 @@ ret_code_t nrf_queue_generic_pop(nrf_queue_t const * p_queue,
         }
 
         // Read element.
-        switch (p_queue->element_size)
-        {
-            case sizeof(uint8_t):
-                *((uint8_t *)p_element) = ((uint8_t *)p_queue->p_buffer)[read_pos];
-                break;
-
-            case sizeof(uint16_t):
-                *((uint16_t *)p_element) = ((uint16_t *)p_queue->p_buffer)[read_pos];
-                break;
-
-            case sizeof(uint32_t):
-                *((uint32_t *)p_element) = ((uint32_t *)p_queue->p_buffer)[read_pos];
-                break;
-
-            case sizeof(uint64_t):
-                *((uint64_t *)p_element) = ((uint64_t *)p_queue->p_buffer)[read_pos];
-                break;
-
-            default:
-                memcpy(p_element,
-                       (void const *)((size_t)p_queue->p_buffer + read_pos * p_queue->element_size),
-                       p_queue->element_size);
-                break;
-        }
+        element_read(p_queue, read_pos, p_element);
     }
     else
     {
@@ -265,6 +464,12 @@ ret_code_t nrf_queue_write(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        return (spsc_in(p_queue, p_data, element_count, element_count) == element_count)
+               ? NRF_SUCCESS : NRF_ERROR_NO_MEM;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if ((nrf_queue_available_get(p_queue) >= element_count)
@@ -295,6 +500,11 @@ size_t nrf_queue_in(nrf_queue_t const * p_queue,
         return 0;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        return spsc_in(p_queue, p_data, element_count, 0);
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (p_queue->mode == NRF_QUEUE_MODE_OVERFLOW)
@@ -369,6 +579,12 @@ ret_code_t nrf_queue_read(nrf_queue_t const * p_queue,
         return NRF_SUCCESS;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        return (spsc_out(p_queue, p_data, element_count, element_count, false) == element_count)
+               ? NRF_SUCCESS : NRF_ERROR_NOT_FOUND;
+    }
+
     CRITICAL_REGION_ENTER();
 
     if (element_count <= queue_utilization_get(p_queue))
@@ -397,6 +613,11 @@ size_t nrf_queue_out(nrf_queue_t const * p_queue,
         return 0;
     }
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        return spsc_out(p_queue, p_data, element_count, 0, false);
+    }
+
     CRITICAL_REGION_ENTER();
 
     size_t utilization = queue_utilization_get(p_queue);
@@ -425,6 +646,12 @@ size_t nrf_queue_utilization_get(nrf_queue_t const * p_queue)
     size_t utilization;
     ASSERT(p_queue != NULL);
 
+    if (p_queue->mode == NRF_QUEUE_MODE_SPSC)
+    {
+        // Each index is read atomically, the result is a snapshot.
+        return queue_utilization_get(p_queue);
+    }
+
     CRITICAL_REGION_ENTER();
 
     utilization = queue_utilization_get(p_queue);
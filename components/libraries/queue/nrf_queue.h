@@ -72,6 +72,10 @@ typedef enum
 {
     NRF_QUEUE_MODE_OVERFLOW,        //!< If the queue is full, new element will overwrite the oldest.
     NRF_QUEUE_MODE_NO_OVERFLOW,     //!< If the queue is full, new element will not be accepted.
+    NRF_QUEUE_MODE_SPSC,            //!< Single producer, single consumer. If the queue is full, new
+                                    //!< element will not be accepted. Elements are added and removed
+                                    //!< without critical regions, so only one context may push/write
+                                    //!< and only one context may pop/read.
 } nrf_queue_mode_t;
 
 /**@brief Instance of the queue. */
@@ -386,6 +390,9 @@ size_t nrf_queue_available_get(nrf_queue_t const * p_queue);
 size_t nrf_queue_max_utilization_get(nrf_queue_t const * p_queue);
 
 /**@brief Function for resetting the queue state.
+ *
+ * @note In @ref NRF_QUEUE_MODE_SPSC, neither the producer nor the consumer may access the queue
+ *       during the reset.
  *
  * @param[in]   p_queue     Pointer to the queue instance.
  */
@@ -47,24 +47,45 @@
 #include "nrf_assert.h"
 #include "app_util_platform.h"
 
+#define EVENT_INDEX_NONE    0xFF    /**< Index marking the end of a list of queue entries. */
+
 /**@brief Structure for holding a scheduled event header. */
 typedef struct
 {
     app_sched_event_handler_t handler;          /**< Pointer to event handler to receive the event. */
     uint16_t                  event_data_size;  /**< Size of event data. */
+    uint8_t                   next;             /**< Index of the next queue entry in the same list. */
+    uint8_t                   is_ref;           /**< True if the queue entry holds a reference to the event data. */
 } event_header_t;
 
 STATIC_ASSERT(sizeof(event_header_t) <= APP_SCHED_EVENT_HEADER_SIZE);
 
+/**@brief Structure held in the event data of a queue entry for events scheduled by reference. */
+typedef struct
+{
+    void                    * p_event_data;     /**< Pointer to the event data. */
+    app_sched_event_release_t release;          /**< Function to be called once the event has been handled. */
+} event_ref_t;
+
+/**@brief Structure for holding a list of queue entries. */
+typedef struct
+{
+    uint8_t  head;                              /**< Index of the first queue entry in the list. */
+    uint8_t  tail;                              /**< Index of the last queue entry in the list. */
+    uint16_t count;                             /**< Number of queue entries in the list. */
+} event_list_t;
+
 static event_header_t * m_queue_event_headers;  /**< Array for holding the queue event headers. */
 static uint8_t        * m_queue_event_data;     /**< Array for holding the queue event data. */
-static volatile uint8_t m_queue_start_index;    /**< Index of queue entry at the start of the queue. */
-static volatile uint8_t m_queue_end_index;      /**< Index of queue entry at the end of the queue. */
 static uint16_t         m_queue_event_size;     /**< Maximum event size in queue. */
 static uint16_t         m_queue_size;           /**< Number of queue entries. */
 
+static event_list_t volatile m_free_list;                                   /**< Queue entries not in use. */
+static event_list_t volatile m_event_list[APP_SCHEDULER_PRIORITY_LEVELS];   /**< Scheduled events, per priority. */
+
 #if APP_SCHEDULER_WITH_PROFILER
-static uint16_t m_max_queue_utilization;    /**< Maximum observed queue utilization. */
+static uint16_t m_max_queue_utilization;                                    /**< Maximum observed queue utilization. */
+static uint16_t m_max_level_utilization[APP_SCHEDULER_PRIORITY_LEVELS];     /**< Maximum observed queue utilization, per priority. */
 #endif
 
 #if APP_SCHEDULER_WITH_PAUSE
@@ -72,37 +93,6 @@ static uint32_t m_scheduler_paused_counter = 0; /**< Counter storing the differe
                                                      and resuming the scheduler. */
 #endif
 
-/**@brief Function for incrementing a queue index, and handle wrap-around.
- *
- * @param[in]   index   Old index.
- *
- * @return      New (incremented) index.
- */
-static __INLINE uint8_t next_index(uint8_t index)
-{
-    return (index < m_queue_size) ? (index + 1) : 0;
-}
-
-
-static __INLINE uint8_t app_sched_queue_full()
-{
-  uint8_t tmp = m_queue_start_index;
-  return next_index(m_queue_end_index) == tmp;
-}
-
-/**@brief Macro for checking if a queue is full. */
-#define APP_SCHED_QUEUE_FULL() app_sched_queue_full()
-
-
-static __INLINE uint8_t app_sched_queue_empty()
-{
-  uint8_t tmp = m_queue_start_index;
-  return m_queue_end_index == tmp;
-}
-
-/**@brief Macro for checking if a queue is empty. */
-#define APP_SCHED_QUEUE_EMPTY() app_sched_queue_empty()
-
 
 uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event_buffer)
 {
@@ -114,16 +104,36 @@ uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event
         return NRF_ERROR_INVALID_PARAM;
     }
 
+    // Queue entries are linked by 8-bit indexes.
+    if (queue_size >= EVENT_INDEX_NONE)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
     // Initialize event scheduler
     m_queue_event_headers = p_event_buffer;
     m_queue_event_data    = &((uint8_t *)p_event_buffer)[data_start_index];
-    m_queue_end_index     = 0;
-    m_queue_start_index   = 0;
     m_queue_event_size    = event_size;
     m_queue_size          = queue_size;
 
+    for (uint16_t i = 0; i < queue_size; i++)
+    {
+        m_queue_event_headers[i].next = (i + 1 < queue_size) ? (i + 1) : EVENT_INDEX_NONE;
+    }
+
+    m_free_list.head  = (queue_size > 0) ? 0 : EVENT_INDEX_NONE;
+    m_free_list.count = queue_size;
+
+    for (uint32_t i = 0; i < APP_SCHEDULER_PRIORITY_LEVELS; i++)
+    {
+        m_event_list[i].head  = EVENT_INDEX_NONE;
+        m_event_list[i].tail  = EVENT_INDEX_NONE;
+        m_event_list[i].count = 0;
+    }
+
 #if APP_SCHEDULER_WITH_PROFILER
     m_max_queue_utilization = 0;
+    memset(m_max_level_utilization, 0x00, sizeof(m_max_level_utilization));
 #endif
 
     return NRF_SUCCESS;
@@ -132,91 +142,174 @@ uint32_t app_sched_init(uint16_t event_size, uint16_t queue_size, void * p_event
 
 uint16_t app_sched_queue_space_get()
 {
-    uint16_t start = m_queue_start_index;
-    uint16_t end   = m_queue_end_index;
-    uint16_t free_space = m_queue_size - ((end >= start) ?
-                           (end - start) : (m_queue_size + 1 - start + end));
-    return free_space;
+    return m_free_list.count;
 }
 
 
 #if APP_SCHEDULER_WITH_PROFILER
-static void queue_utilization_check(void)
+static void queue_utilization_check(uint8_t priority)
 {
-    uint16_t start = m_queue_start_index;
-    uint16_t end   = m_queue_end_index;
-    uint16_t queue_utilization = (end >= start) ? (end - start) :
-        (m_queue_size + 1 - start + end);
+    uint16_t queue_utilization = m_queue_size - m_free_list.count;
 
     if (queue_utilization > m_max_queue_utilization)
     {
         m_max_queue_utilization = queue_utilization;
     }
+
+    if (m_event_list[priority].count > m_max_level_utilization[priority])
+    {
+        m_max_level_utilization[priority] = m_event_list[priority].count;
+    }
 }
 
 uint16_t app_sched_queue_utilization_get(void)
 {
     return m_max_queue_utilization;
 }
+
+uint16_t app_sched_queue_level_utilization_get(uint8_t priority)
+{
+    return (priority < APP_SCHEDULER_PRIORITY_LEVELS) ? m_max_level_utilization[priority] : 0;
+}
 #endif // APP_SCHEDULER_WITH_PROFILER
 
 
-uint32_t app_sched_event_put(void const              * p_event_data,
-                             uint16_t                  event_data_size,
-                             app_sched_event_handler_t handler)
+/**@brief Function for scheduling an event.
+ *
+ * @details A queue entry is taken from the free list and filled in outside the critical region,
+ *          then appended to the list of its priority. The event consumer only sees the entry
+ *          once it is complete.
+ *
+ * @param[in]   p_event_data     Pointer to event data to be copied, or NULL.
+ * @param[in]   event_data_size  Size of event data.
+ * @param[in]   handler          Event handler to receive the event.
+ * @param[in]   p_ref            Reference to the event data, or NULL to copy the event data.
+ * @param[in]   priority         Priority of the event.
+ *
+ * @return      NRF_SUCCESS on success, otherwise an error code.
+ */
+static uint32_t event_put(void const              * p_event_data,
+                          uint16_t                  event_data_size,
+                          app_sched_event_handler_t handler,
+                          event_ref_t const       * p_ref,
+                          uint8_t                   priority)
 {
-    uint32_t err_code;
+    uint8_t event_index;
 
-    if (event_data_size <= m_queue_event_size)
+    if (priority >= APP_SCHEDULER_PRIORITY_LEVELS)
     {
-        uint16_t event_index = 0xFFFF;
+        return NRF_ERROR_INVALID_PARAM;
+    }
 
-        CRITICAL_REGION_ENTER();
+    CRITICAL_REGION_ENTER();
 
-        if (!APP_SCHED_QUEUE_FULL())
-        {
-            event_index       = m_queue_end_index;
-            m_queue_end_index = next_index(m_queue_end_index);
-
-        #if APP_SCHEDULER_WITH_PROFILER
-            // This function call must be protected with critical region because
-            // it modifies 'm_max_queue_utilization'.
-            queue_utilization_check();
-        #endif
-        }
+    event_index = m_free_list.head;
+    if (event_index != EVENT_INDEX_NONE)
+    {
+        m_free_list.head = m_queue_event_headers[event_index].next;
+        m_free_list.count--;
+    }
 
-        CRITICAL_REGION_EXIT();
+    CRITICAL_REGION_EXIT();
 
-        if (event_index != 0xFFFF)
-        {
-            // NOTE: This can be done outside the critical region since the event consumer will
-            //       always be called from the main loop, and will thus never interrupt this code.
-            m_queue_event_headers[event_index].handler = handler;
-            if ((p_event_data != NULL) && (event_data_size > 0))
-            {
-                memcpy(&m_queue_event_data[event_index * m_queue_event_size],
-                       p_event_data,
-                       event_data_size);
-                m_queue_event_headers[event_index].event_data_size = event_data_size;
-            }
-            else
-            {
-                m_queue_event_headers[event_index].event_data_size = 0;
-            }
+    if (event_index == EVENT_INDEX_NONE)
+    {
+        return NRF_ERROR_NO_MEM;
+    }
 
-            err_code = NRF_SUCCESS;
-        }
-        else
-        {
-            err_code = NRF_ERROR_NO_MEM;
-        }
+    event_header_t * const p_header = &m_queue_event_headers[event_index];
+    uint8_t        * const p_data   = &m_queue_event_data[event_index * m_queue_event_size];
+
+    p_header->handler = handler;
+    p_header->next    = EVENT_INDEX_NONE;
+    p_header->is_ref  = (p_ref != NULL);
+
+    if (p_ref != NULL)
+    {
+        memcpy(p_data, p_ref, sizeof(event_ref_t));
+        p_header->event_data_size = event_data_size;
+    }
+    else if ((p_event_data != NULL) && (event_data_size > 0))
+    {
+        memcpy(p_data, p_event_data, event_data_size);
+        p_header->event_data_size = event_data_size;
+    }
+    else
+    {
+        p_header->event_data_size = 0;
+    }
+
+    CRITICAL_REGION_ENTER();
+
+    event_list_t volatile * const p_list = &m_event_list[priority];
+
+    if (p_list->tail != EVENT_INDEX_NONE)
+    {
+        m_queue_event_headers[p_list->tail].next = event_index;
     }
     else
     {
-        err_code = NRF_ERROR_INVALID_LENGTH;
+        p_list->head = event_index;
+    }
+    p_list->tail = event_index;
+    p_list->count++;
+
+#if APP_SCHEDULER_WITH_PROFILER
+    // This function call must be protected with critical region because
+    // it modifies 'm_max_queue_utilization'.
+    queue_utilization_check(priority);
+#endif
+
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+
+uint32_t app_sched_event_put(void const              * p_event_data,
+                             uint16_t                  event_data_size,
+                             app_sched_event_handler_t handler)
+{
+    return app_sched_event_put_prio(p_event_data,
+                                    event_data_size,
+                                    handler,
+                                    APP_SCHED_PRIORITY_LOWEST);
+}
+
+
+uint32_t app_sched_event_put_prio(void const              * p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    if (event_data_size > m_queue_event_size)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
+    }
+
+    return event_put(p_event_data, event_data_size, handler, NULL, priority);
+}
+
+
+uint32_t app_sched_event_ref_put(void                    * p_event_data,
+                                 uint16_t                  event_data_size,
+                                 app_sched_event_handler_t handler,
+                                 app_sched_event_release_t release,
+                                 uint8_t                   priority)
+{
+    event_ref_t const ref =
+    {
+        .p_event_data = p_event_data,
+        .release      = release
+    };
+
+    // The reference is held in the event data of the queue entry.
+    if (sizeof(event_ref_t) > m_queue_event_size)
+    {
+        return NRF_ERROR_INVALID_LENGTH;
     }
 
-    return err_code;
+    return event_put(NULL, event_data_size, handler, &ref, priority);
 }
 
 
@@ -260,29 +353,77 @@ static __INLINE bool is_app_sched_paused(void)
 }
 
 
+/**@brief Function for taking the next event to be executed out of the queue.
+ *
+ * @return    Index of the queue entry holding the event, or EVENT_INDEX_NONE if the queue is empty.
+ */
+static uint8_t event_get(void)
+{
+    uint8_t event_index = EVENT_INDEX_NONE;
+
+    CRITICAL_REGION_ENTER();
+
+    for (uint32_t priority = 0; priority < APP_SCHEDULER_PRIORITY_LEVELS; priority++)
+    {
+        event_list_t volatile * const p_list = &m_event_list[priority];
+
+        event_index = p_list->head;
+        if (event_index != EVENT_INDEX_NONE)
+        {
+            p_list->head = m_queue_event_headers[event_index].next;
+            if (p_list->head == EVENT_INDEX_NONE)
+            {
+                p_list->tail = EVENT_INDEX_NONE;
+            }
+            p_list->count--;
+            break;
+        }
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    return event_index;
+}
+
+
 void app_sched_execute(void)
 {
-    while (!is_app_sched_paused() && !APP_SCHED_QUEUE_EMPTY())
+    while (!is_app_sched_paused())
     {
-        // Since this function is only called from the main loop, there is no
-        // need for a critical region here, however a special care must be taken
-        // regarding update of the queue start index (see the end of the loop).
-        uint16_t event_index = m_queue_start_index;
+        // The highest priority event is taken each time, so that events scheduled while
+        // a lower priority event is handled do not wait for the rest of the lower priority events.
+        uint8_t const event_index = event_get();
+
+        if (event_index == EVENT_INDEX_NONE)
+        {
+            break;
+        }
+
+        event_header_t const * const p_header = &m_queue_event_headers[event_index];
+        void                 * const p_data   = &m_queue_event_data[event_index * m_queue_event_size];
 
-        void * p_event_data;
-        uint16_t event_data_size;
-        app_sched_event_handler_t event_handler;
+        if (p_header->is_ref)
+        {
+            event_ref_t const * const p_ref = (event_ref_t const *)p_data;
 
-        p_event_data = &m_queue_event_data[event_index * m_queue_event_size];
-        event_data_size = m_queue_event_headers[event_index].event_data_size;
-        event_handler   = m_queue_event_headers[event_index].handler;
+            p_header->handler(p_ref->p_event_data, p_header->event_data_size);
 
-        event_handler(p_event_data, event_data_size);
+            if (p_ref->release != NULL)
+            {
+                p_ref->release(p_ref->p_event_data, p_header->event_data_size);
+            }
+        }
+        else
+        {
+            p_header->handler(p_data, p_header->event_data_size);
+        }
 
-        // Event processed, now it is safe to move the queue start index,
-        // so the queue entry occupied by this event can be used to store
-        // a next one.
-        m_queue_start_index = next_index(m_queue_start_index);
+        // Event processed, now it is safe to free the queue entry occupied by this event.
+        CRITICAL_REGION_ENTER();
+        m_queue_event_headers[event_index].next = m_free_list.head;
+        m_free_list.head = event_index;
+        m_free_list.count++;
+        CRITICAL_REGION_EXIT();
     }
 }
 #endif //NRF_MODULE_ENABLED(APP_SCHEDULER)
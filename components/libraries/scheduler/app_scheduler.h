@@ -88,6 +88,17 @@ extern "C" {
 
 #define APP_SCHED_EVENT_HEADER_SIZE 8       /**< Size of app_scheduler.event_header_t (only for use inside APP_SCHED_BUF_SIZE()). */
 
+#ifndef APP_SCHEDULER_PRIORITY_LEVELS
+#define APP_SCHEDULER_PRIORITY_LEVELS 1
+#endif
+
+#if (APP_SCHEDULER_PRIORITY_LEVELS < 1) || (APP_SCHEDULER_PRIORITY_LEVELS > 4)
+#error "APP_SCHEDULER_PRIORITY_LEVELS must be between 1 and 4."
+#endif
+
+#define APP_SCHED_PRIORITY_HIGHEST  0                                   /**< Highest event priority. */
+#define APP_SCHED_PRIORITY_LOWEST   (APP_SCHEDULER_PRIORITY_LEVELS - 1) /**< Lowest event priority, used by @ref app_sched_event_put. */
+
 /**@brief Compute number of bytes required to hold the scheduler buffer.
  *
  * @param[in] EVENT_SIZE   Maximum size of events to be passed through the scheduler.
@@ -102,6 +113,13 @@ extern "C" {
 /**@brief Scheduler event handler type. */
 typedef void (*app_sched_event_handler_t)(void * p_event_data, uint16_t event_size);
 
+/**@brief Scheduler event release function type.
+ *
+ * @details Called after the event handler has returned, for events scheduled with
+ *          @ref app_sched_event_ref_put. The event data may be reused from then on.
+ */
+typedef void (*app_sched_event_release_t)(void * p_event_data, uint16_t event_size);
+
 /**@brief Macro for initializing the event scheduler.
  *
  * @details It will also handle dimensioning and allocation of the memory buffer required by the
@@ -139,20 +157,21 @@ typedef void (*app_sched_event_handler_t)(void * p_event_data, uint16_t event_si
  *
  * @retval      NRF_SUCCESS               Successful initialization.
  * @retval      NRF_ERROR_INVALID_PARAM   Invalid parameter (buffer not aligned to a 4 byte
- *                                        boundary).
+ *                                        boundary, or queue_size of 255 or more).
  */
 uint32_t app_sched_init(uint16_t max_event_size, uint16_t queue_size, void * p_evt_buffer);
 
 /**@brief Function for executing all scheduled events.
  *
  * @details This function must be called from within the main loop. It will execute all events
- *          scheduled since the last time it was called.
+ *          scheduled since the last time it was called. Events of a higher priority are
+ *          executed first, events of the same priority in the order they were scheduled.
  */
 void app_sched_execute(void);
 
 /**@brief Function for scheduling an event.
  *
- * @details Puts an event into the event queue.
+ * @details Puts an event into the event queue, with the lowest priority.
  *
  * @param[in]   p_event_data   Pointer to event data to be scheduled.
  * @param[in]   event_size     Size of event data to be scheduled.
@@ -164,6 +183,55 @@ uint32_t app_sched_event_put(void const *              p_event_data,
                              uint16_t                  event_size,
                              app_sched_event_handler_t handler);
 
+/**@brief Function for scheduling an event with a given priority.
+ *
+ * @details Puts an event into the event queue. The event is executed before any event of a lower
+ *          priority, regardless of when those were scheduled.
+ *
+ * @param[in]   p_event_data   Pointer to event data to be scheduled.
+ * @param[in]   event_size     Size of event data to be scheduled.
+ * @param[in]   handler        Event handler to receive the event.
+ * @param[in]   priority       Event priority, from @ref APP_SCHED_PRIORITY_HIGHEST to
+ *                             @ref APP_SCHED_PRIORITY_LOWEST.
+ *
+ * @retval      NRF_SUCCESS               Event scheduled.
+ * @retval      NRF_ERROR_INVALID_LENGTH  Event data larger than the maximum event size.
+ * @retval      NRF_ERROR_INVALID_PARAM   Invalid priority.
+ * @retval      NRF_ERROR_NO_MEM          Queue full.
+ */
+uint32_t app_sched_event_put_prio(void const *              p_event_data,
+                                  uint16_t                  event_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority);
+
+/**@brief Function for scheduling an event without copying its data.
+ *
+ * @details Only a reference to the event data is put into the event queue, so the event size is
+ *          not limited by the maximum event size of the queue. The data must stay valid until
+ *          the release function has been called, which happens right after the event handler
+ *          has returned.
+ *
+ * @note The maximum event size of the queue must be at least the size of two pointers.
+ *
+ * @param[in]   p_event_data   Pointer to event data to be scheduled.
+ * @param[in]   event_size     Size of event data to be scheduled.
+ * @param[in]   handler        Event handler to receive the event.
+ * @param[in]   release        Function to be called once the event has been handled, or NULL.
+ * @param[in]   priority       Event priority, from @ref APP_SCHED_PRIORITY_HIGHEST to
+ *                             @ref APP_SCHED_PRIORITY_LOWEST.
+ *
+ * @retval      NRF_SUCCESS               Event scheduled.
+ * @retval      NRF_ERROR_INVALID_LENGTH  Maximum event size of the queue too small to hold the
+ *                                        reference.
+ * @retval      NRF_ERROR_INVALID_PARAM   Invalid priority.
+ * @retval      NRF_ERROR_NO_MEM          Queue full.
+ */
+uint32_t app_sched_event_ref_put(void *                    p_event_data,
+                                 uint16_t                  event_size,
+                                 app_sched_event_handler_t handler,
+                                 app_sched_event_release_t release,
+                                 uint8_t                   priority);
+
 /**@brief Function for getting the maximum observed queue utilization.
  *
  * Function for tuning the module and determining QUEUE_SIZE value and thus module RAM usage.
@@ -174,6 +242,16 @@ uint32_t app_sched_event_put(void const *              p_event_data,
  */
 uint16_t app_sched_queue_utilization_get(void);
 
+/**@brief Function for getting the maximum observed number of queued events of a given priority.
+ *
+ * @note @ref APP_SCHEDULER_WITH_PROFILER must be enabled to use this functionality.
+ *
+ * @param[in]   priority       Event priority.
+ *
+ * @return Maximum number of events of the given priority in queue observed so far.
+ */
+uint16_t app_sched_queue_level_utilization_get(uint8_t priority);
+
 /**@brief Function for getting the current amount of free space in the queue.
  *
  * @details The real amount of free space may be less if entries are being added from an interrupt.
@@ -214,6 +214,31 @@ uint32_t app_sched_event_put(void *                    p_event_data,
 }
 
 
+uint32_t app_sched_event_put_prio(void const *              p_event_data,
+                                  uint16_t                  event_data_size,
+                                  app_sched_event_handler_t handler,
+                                  uint8_t                   priority)
+{
+    // This implementation has a single queue, the priority is ignored.
+    UNUSED_PARAMETER(priority);
+    return app_sched_event_put((void *)p_event_data, event_data_size, handler);
+}
+
+
+uint32_t app_sched_event_ref_put(void *                    p_event_data,
+                                 uint16_t                  event_data_size,
+                                 app_sched_event_handler_t handler,
+                                 app_sched_event_release_t release,
+                                 uint8_t                   priority)
+{
+    UNUSED_PARAMETER(p_event_data);
+    UNUSED_PARAMETER(event_data_size);
+    UNUSED_PARAMETER(handler);
+    UNUSED_PARAMETER(release);
+    UNUSED_PARAMETER(priority);
+    return NRF_ERROR_NOT_SUPPORTED;
+}
+
 /**@brief Function for reading the next event from specified event queue.
  *
  * @param[out]  pp_event_data       Pointer to pointer to event data.
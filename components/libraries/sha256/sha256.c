@@ -66,19 +66,83 @@ static const uint32_t k[64] = {
 };
 
 
+#if defined(__CORTEX_M)
+#define BSWAP32(x) __REV(x)
+#else
+#define BSWAP32(x) ((((x) & 0x000000FF) << 24) | (((x) & 0x0000FF00) << 8) | \
+                    (((x) & 0x00FF0000) >> 8)  | (((x) & 0xFF000000) >> 24))
+#endif
+
+/**@brief Macro for one round, with the working variables passed in their rotated order. */
+#define ROUND(a,b,c,d,e,f,g,h,i,w)                          \
+    do                                                      \
+    {                                                       \
+        uint32_t t1 = (h) + EP1(e) + CH(e,f,g) + k[i] + (w); \
+        (d) += t1;                                          \
+        (h)  = t1 + EP0(a) + MAJ(a,b,c);                    \
+    } while (0)
+
+/**@brief Macro for the next message schedule word, kept in a 16-word circular buffer. */
+#define SCHEDULE(m,j)                                                               \
+    ((m)[(j) & 15] += SIG1((m)[((j) + 14) & 15]) + (m)[((j) + 9) & 15] + SIG0((m)[((j) + 1) & 15]))
+
+/**@brief Macro for 16 rounds. j selects the circular buffer word, i + j is the round number. */
+#define ROUNDS_16(W)                                            \
+    do                                                          \
+    {                                                           \
+        ROUND(a,b,c,d,e,f,g,h, i +  0, W(0));                   \
+        ROUND(h,a,b,c,d,e,f,g, i +  1, W(1));                   \
+        ROUND(g,h,a,b,c,d,e,f, i +  2, W(2));                   \
+        ROUND(f,g,h,a,b,c,d,e, i +  3, W(3));                   \
+        ROUND(e,f,g,h,a,b,c,d, i +  4, W(4));                   \
+        ROUND(d,e,f,g,h,a,b,c, i +  5, W(5));                   \
+        ROUND(c,d,e,f,g,h,a,b, i +  6, W(6));                   \
+        ROUND(b,c,d,e,f,g,h,a, i +  7, W(7));                   \
+        ROUND(a,b,c,d,e,f,g,h, i +  8, W(8));                   \
+        ROUND(h,a,b,c,d,e,f,g, i +  9, W(9));                   \
+        ROUND(g,h,a,b,c,d,e,f, i + 10, W(10));                  \
+        ROUND(f,g,h,a,b,c,d,e, i + 11, W(11));                  \
+        ROUND(e,f,g,h,a,b,c,d, i + 12, W(12));                  \
+        ROUND(d,e,f,g,h,a,b,c, i + 13, W(13));                  \
+        ROUND(c,d,e,f,g,h,a,b, i + 14, W(14));                  \
+        ROUND(b,c,d,e,f,g,h,a, i + 15, W(15));                  \
+    } while (0)
+
+#define W_LOAD(j)     (m[j])
+#define W_SCHEDULE(j) SCHEDULE(m, j)
+
+
 /**@brief Function for calculating the hash of a 64-byte section of data.
+ *
+ * @details The message schedule is computed on the fly in a 16-word circular buffer. The rounds
+ *          are unrolled 16 at a time, so that all schedule indexes are constants and the working
+ *          variables never have to be shuffled.
  *
  * @param[in,out] ctx   Hash instance.
- * @param[in]     data  Aray with data to be hashed. Assumed to be 64 bytes long.
+ * @param[in]     data  Aray with data to be hashed. Assumed to be 64 bytes long. Can be unaligned
+ *                      and located in flash.
  */
 void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
 {
-    uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
+    uint32_t a, b, c, d, e, f, g, h, i, m[16];
 
-    for (i = 0, j = 0; i < 16; ++i, j += 4)
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | (data[j + 3]);
-    for ( ; i < 64; ++i)
-        m[i] = SIG1(m[i - 2]) + m[i - 7] + SIG0(m[i - 15]) + m[i - 16];
+    if (((uintptr_t)data & 3) == 0)
+    {
+        uint32_t const * p_words = (uint32_t const *)data;
+
+        for (i = 0; i < 16; ++i)
+        {
+            m[i] = BSWAP32(p_words[i]);
+        }
+    }
+    else
+    {
+        for (i = 0; i < 16; ++i, data += 4)
+        {
+            m[i] = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+                   ((uint32_t)data[2] << 8)  | ((uint32_t)data[3]);
+        }
+    }
 
     a = ctx->state[0];
     b = ctx->state[1];
@@ -89,17 +153,12 @@ void sha256_transform(sha256_context_t *ctx, const uint8_t * data)
     g = ctx->state[6];
     h = ctx->state[7];
 
-    for (i = 0; i < 64; ++i) {
-        t1 = h + EP1(e) + CH(e,f,g) + k[i] + m[i];
-        t2 = EP0(a) + MAJ(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
+    i = 0;
+    ROUNDS_16(W_LOAD);
+
+    for (i = 16; i < 64; i += 16)
+    {
+        ROUNDS_16(W_SCHEDULE);
     }
 
     ctx->state[0] += a;
@@ -140,18 +199,37 @@ ret_code_t sha256_update(sha256_context_t *ctx, const uint8_t * data, size_t len
         return NRF_ERROR_NULL;
     }
 
-    uint32_t i;
+    // Complete a partially filled block first.
+    if (ctx->datalen != 0)
+    {
+        size_t fill = MIN(len, 64 - ctx->datalen);
 
-    for (i = 0; i < len; ++i) {
-        ctx->data[ctx->datalen] = data[i];
-        ctx->datalen++;
-        if (ctx->datalen == 64) {
-            sha256_transform(ctx, ctx->data);
-            ctx->bitlen += 512;
-            ctx->datalen = 0;
+        memcpy(&ctx->data[ctx->datalen], data, fill);
+        ctx->datalen += fill;
+        data         += fill;
+        len          -= fill;
+
+        if (ctx->datalen < 64)
+        {
+            return NRF_SUCCESS;
         }
+        sha256_transform(ctx, ctx->data);
+        ctx->bitlen += 512;
+        ctx->datalen = 0;
+    }
+
+    // Hash whole blocks directly from the caller's buffer.
+    while (len >= 64)
+    {
+        sha256_transform(ctx, data);
+        ctx->bitlen += 512;
+        data        += 64;
+        len         -= 64;
     }
 
+    memcpy(ctx->data, data, len);
+    ctx->datalen = len;
+
     return NRF_SUCCESS;
 }
 
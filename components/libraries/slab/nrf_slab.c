@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(NRF_SLAB)
+#include "nrf_slab.h"
+#include "app_util_platform.h"
+
+/**@brief Get the number of blocks of a pool.
+ *
+ * @param[in]   p_pool  Pointer to the memory pool.
+ *
+ * @return      Number of blocks.
+ */
+__STATIC_INLINE uint8_t pool_size_get(nrf_balloc_t const * p_pool)
+{
+    return p_pool->p_stack_limit - p_pool->p_stack_base;
+}
+
+/**@brief Check if a block belongs to a pool.
+ *
+ * @param[in]   p_pool  Pointer to the memory pool.
+ * @param[in]   p_block Pointer to the block.
+ *
+ * @return      True if the block lies within the memory of the pool.
+ */
+__STATIC_INLINE bool pool_owns(nrf_balloc_t const * p_pool, void const * p_block)
+{
+    uint8_t const * p_begin = p_pool->p_memory_begin;
+    uint8_t const * p_end   = p_begin + (size_t)pool_size_get(p_pool) * p_pool->block_size;
+
+    return ((uint8_t const *)p_block >= p_begin) && ((uint8_t const *)p_block < p_end);
+}
+
+ret_code_t nrf_slab_init(nrf_slab_t const * p_slab)
+{
+    ret_code_t err_code;
+    size_t     element_size = 0;
+    uint8_t    class_idx    = 0;
+
+    VERIFY_PARAM_NOT_NULL(p_slab);
+
+    for (uint8_t i = 0; i < p_slab->class_count; i++)
+    {
+        nrf_balloc_t const * p_pool = p_slab->p_classes[i];
+
+        if (NRF_BALLOC_ELEMENT_SIZE(p_pool) <= element_size)
+        {
+            return NRF_ERROR_INVALID_PARAM;
+        }
+        element_size = NRF_BALLOC_ELEMENT_SIZE(p_pool);
+
+        err_code = nrf_balloc_init(p_pool);
+        VERIFY_SUCCESS(err_code);
+    }
+
+    if (element_size < p_slab->max_size)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Entry n serves requests of (n * NRF_SLAB_GRANULARITY + 1) up to
+    // ((n + 1) * NRF_SLAB_GRANULARITY) bytes.
+    for (size_t n = 0; n < CEIL_DIV(p_slab->max_size, NRF_SLAB_GRANULARITY); n++)
+    {
+        while (NRF_BALLOC_ELEMENT_SIZE(p_slab->p_classes[class_idx])
+               < MIN((n + 1) * NRF_SLAB_GRANULARITY, p_slab->max_size))
+        {
+            class_idx++;
+        }
+        p_slab->p_lut[n] = class_idx;
+    }
+
+    memset(p_slab->p_class_cb, 0, p_slab->class_count * sizeof(nrf_slab_class_cb_t));
+
+    return NRF_SUCCESS;
+}
+
+void * nrf_slab_alloc(nrf_slab_t const * p_slab, size_t size)
+{
+    ASSERT(p_slab != NULL);
+
+    if ((size == 0) || (size > p_slab->max_size))
+    {
+        return NULL;
+    }
+
+    uint8_t const class_idx = p_slab->p_lut[(size - 1) / NRF_SLAB_GRANULARITY];
+    void        * p_block   = nrf_balloc_alloc(p_slab->p_classes[class_idx]);
+
+    if (p_block != NULL)
+    {
+        return p_block;
+    }
+
+    // Borrow from the larger classes.
+    for (uint8_t i = class_idx + 1; (i < p_slab->class_count) && (p_block == NULL); i++)
+    {
+        p_block = nrf_balloc_alloc(p_slab->p_classes[i]);
+
+        if (p_block != NULL)
+        {
+            CRITICAL_REGION_ENTER();
+            p_slab->p_class_cb[i].borrowed++;
+            CRITICAL_REGION_EXIT();
+        }
+    }
+
+    CRITICAL_REGION_ENTER();
+    p_slab->p_class_cb[class_idx].exhausted++;
+    if (p_block == NULL)
+    {
+        p_slab->p_class_cb[class_idx].failed++;
+    }
+    CRITICAL_REGION_EXIT();
+
+    return p_block;
+}
+
+void nrf_slab_free(nrf_slab_t const * p_slab, void * p_block)
+{
+    ASSERT(p_slab != NULL);
+    ASSERT(p_block != NULL);
+
+    for (uint8_t i = 0; i < p_slab->class_count; i++)
+    {
+        if (pool_owns(p_slab->p_classes[i], p_block))
+        {
+            nrf_balloc_free(p_slab->p_classes[i], p_block);
+            return;
+        }
+    }
+
+    // The block does not belong to this allocator.
+    ASSERT(false);
+}
+
+ret_code_t nrf_slab_class_info_get(nrf_slab_t const      * p_slab,
+                                   uint8_t                 class_idx,
+                                   nrf_slab_class_info_t * p_info)
+{
+    VERIFY_PARAM_NOT_NULL(p_slab);
+    VERIFY_PARAM_NOT_NULL(p_info);
+
+    if (class_idx >= p_slab->class_count)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    nrf_balloc_t const * p_pool = p_slab->p_classes[class_idx];
+
+    CRITICAL_REGION_ENTER();
+
+    p_info->element_size    = NRF_BALLOC_ELEMENT_SIZE(p_pool);
+    p_info->pool_size       = pool_size_get(p_pool);
+    p_info->utilization     = p_pool->p_stack_limit - p_pool->p_cb->p_stack_pointer;
+    p_info->max_utilization = nrf_balloc_max_utilization_get(p_pool);
+    p_info->exhausted       = p_slab->p_class_cb[class_idx].exhausted;
+    p_info->borrowed        = p_slab->p_class_cb[class_idx].borrowed;
+    p_info->failed          = p_slab->p_class_cb[class_idx].failed;
+
+    CRITICAL_REGION_EXIT();
+
+    return NRF_SUCCESS;
+}
+
+#endif // NRF_MODULE_ENABLED(NRF_SLAB)
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+/**
+ * @defgroup nrf_slab Size-class slab allocator
+ * @{
+ * @ingroup app_common
+ * @brief Allocator serving variable-size requests from a set of @ref nrf_balloc pools.
+ *
+ * @details Each pool is a size class. A request is routed in constant time, through a lookup
+ *          table built at initialization, to the smallest class that fits it. If that class is
+ *          exhausted, the request is served by the next larger class that has a free block.
+ *
+ * @code
+ * NRF_BALLOC_DEF(m_frame_small,  32,  16);
+ * NRF_BALLOC_DEF(m_frame_medium, 128, 8);
+ * NRF_BALLOC_DEF(m_frame_large,  256, 4);
+ * NRF_SLAB_DEF(m_frames, 256, &m_frame_small, &m_frame_medium, &m_frame_large);
+ * @endcode
+ */
+
+#ifndef NRF_SLAB_H__
+#define NRF_SLAB_H__
+
+#include <stdint.h>
+#include "sdk_errors.h"
+#include "nrf_balloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_SLAB_GRANULARITY    sizeof(uint32_t)    /**< Size resolution of the class lookup table. */
+
+/**@brief Size class statistics. */
+typedef struct
+{
+    uint32_t exhausted;                 //!< Number of requests routed to this class while it had no free block.
+    uint32_t borrowed;                  //!< Number of requests served by this class on behalf of a smaller class.
+    uint32_t failed;                    //!< Number of requests routed to this class that could not be served at all.
+} nrf_slab_class_cb_t;
+
+/**@brief Slab allocator instance. */
+typedef struct
+{
+    nrf_balloc_t const * const * p_classes;     //!< Pools, ordered by increasing element size.
+    nrf_slab_class_cb_t        * p_class_cb;    //!< Statistics of each pool.
+    uint8_t                    * p_lut;         //!< Class index for each multiple of @ref NRF_SLAB_GRANULARITY.
+    uint16_t                     max_size;      //!< Largest request size supported.
+    uint8_t                      class_count;   //!< Number of pools.
+} nrf_slab_t;
+
+/**@brief Size class information returned by @ref nrf_slab_class_info_get. */
+typedef struct
+{
+    uint16_t element_size;              //!< Size of the blocks of the class.
+    uint8_t  pool_size;                 //!< Number of blocks of the class.
+    uint8_t  utilization;               //!< Number of blocks currently allocated.
+    uint8_t  max_utilization;           //!< Maximum number of blocks allocated at once (high-water mark).
+    uint32_t exhausted;                 //!< See @ref nrf_slab_class_cb_t.
+    uint32_t borrowed;                  //!< See @ref nrf_slab_class_cb_t.
+    uint32_t failed;                    //!< See @ref nrf_slab_class_cb_t.
+} nrf_slab_class_info_t;
+
+/**@brief Create a slab allocator instance.
+ *
+ * @note  This macro reserves memory for the given slab allocator instance. The pools must be
+ *        defined with @ref NRF_BALLOC_DEF, listed by increasing element size, and must not be
+ *        used directly.
+ *
+ * @param[in]   _name       Name of the allocator.
+ * @param[in]   _max_size   Largest request size supported. Must not be larger than the element
+ *                          size of the last pool.
+ * @param[in]   ...         Pointers to the pools.
+ */
+#define NRF_SLAB_DEF(_name, _max_size, ...)                                                        \
+    static nrf_balloc_t const * const _name##_nrf_slab_classes[] = { __VA_ARGS__ };                \
+    STATIC_ASSERT(ARRAY_SIZE(_name##_nrf_slab_classes) <= UINT8_MAX);                              \
+    static nrf_slab_class_cb_t  _name##_nrf_slab_class_cb[ARRAY_SIZE(_name##_nrf_slab_classes)];   \
+    static uint8_t              _name##_nrf_slab_lut[CEIL_DIV((_max_size), NRF_SLAB_GRANULARITY)]; \
+    static const nrf_slab_t     _name =                                                            \
+        {                                                                                          \
+            .p_classes   = _name##_nrf_slab_classes,                                               \
+            .p_class_cb  = _name##_nrf_slab_class_cb,                                              \
+            .p_lut       = _name##_nrf_slab_lut,                                                   \
+            .max_size    = (_max_size),                                                            \
+            .class_count = ARRAY_SIZE(_name##_nrf_slab_classes),                                   \
+        }
+
+/**@brief Function for initializing a slab allocator and its pools.
+ *
+ * @param[in]   p_slab  Pointer to the allocator instance.
+ *
+ * @retval  NRF_SUCCESS             Allocator initialized.
+ * @retval  NRF_ERROR_INVALID_PARAM Pools not ordered by increasing element size, or the last pool
+ *                                  too small for the largest request size.
+ */
+ret_code_t nrf_slab_init(nrf_slab_t const * p_slab);
+
+/**@brief Function for allocating a block of at least the given size.
+ *
+ * @note    This module guarantees that the returned memory is aligned to 4.
+ *
+ * @param[in]   p_slab  Pointer to the allocator instance.
+ * @param[in]   size    Requested size, in bytes.
+ *
+ * @return      Allocated block or NULL if the size is not supported or all fitting pools are empty.
+ */
+void * nrf_slab_alloc(nrf_slab_t const * p_slab, size_t size);
+
+/**@brief Function for freeing a block back to the pool it was allocated from.
+ *
+ * @param[in]   p_slab      Pointer to the allocator instance.
+ * @param[in]   p_block     Block to be freed.
+ */
+void nrf_slab_free(nrf_slab_t const * p_slab, void * p_block);
+
+/**@brief Function for getting the usage of a size class.
+ *
+ * @param[in]   p_slab      Pointer to the allocator instance.
+ * @param[in]   class_idx   Index of the class, in the order given to @ref NRF_SLAB_DEF.
+ * @param[out]  p_info      Class information.
+ *
+ * @retval  NRF_SUCCESS             Information returned.
+ * @retval  NRF_ERROR_INVALID_PARAM Invalid class index.
+ */
+ret_code_t nrf_slab_class_info_get(nrf_slab_t const      * p_slab,
+                                   uint8_t                 class_idx,
+                                   nrf_slab_class_info_t * p_info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // NRF_SLAB_H__
+/** @} */
@@ -83,6 +83,7 @@ typedef struct
     uint32_t                    ticks_at_start;                             /**< Current RTC counter value when the timer was started. */
     uint32_t                    ticks_first_interval;                       /**< Number of ticks in the first timer interval. */
     uint32_t                    ticks_periodic_interval;                    /**< Timer period (for repeating timers). */
+    uint32_t                    ticks_slack;                                /**< Number of ticks the timer may expire after its deadline. */
     bool                        is_running;                                 /**< True if timer is running, False otherwise. */
     app_timer_mode_t            mode;                                       /**< Timer mode. */
     app_timer_timeout_handler_t p_timeout_handler;                          /**< Pointer to function to be executed when the timer expires. */
@@ -107,6 +108,7 @@ typedef struct
     uint32_t ticks_at_start;                                                /**< Current RTC counter value when the timer was started. */
     uint32_t ticks_first_interval;                                          /**< Number of ticks in the first timer interval. */
     uint32_t ticks_periodic_interval;                                       /**< Timer period (for repeating timers). */
+    uint32_t ticks_slack;                                                   /**< Number of ticks the timer may expire after its deadline. */
     void *   p_context;                                                     /**< General purpose pointer. Will be passed to the timeout handler when the timer expires. */
 } timer_user_op_start_t;
 
@@ -141,6 +143,7 @@ STATIC_ASSERT(sizeof(timer_op_queue_t) % 4 == 0);
 static timer_op_queue_t              m_op_queue;                                /**< Timer operations queue. */
 static timer_node_t *                mp_timer_id_head;                          /**< First timer in list of running timers. */
 static uint32_t                      m_ticks_latest;                            /**< Last known RTC counter value. */
+static uint32_t                      m_ticks_wakeup;                            /**< Number of ticks from m_ticks_latest to the Capture Compare register value. */
 static uint32_t                      m_ticks_elapsed[CONTEXT_QUEUE_SIZE_MAX];   /**< Timer internal elapsed ticks queue. */
 static uint8_t                       m_ticks_elapsed_q_read_ind;                /**< Timer internal elapsed ticks queue read index. */
 static uint8_t                       m_ticks_elapsed_q_write_ind;               /**< Timer internal elapsed ticks queue write index. */
@@ -149,6 +152,7 @@ static bool                          m_rtc1_reset;
 
 #if APP_TIMER_WITH_PROFILER
 static uint8_t                       m_max_user_op_queue_utilization;           /**< Maximum observed timer user operations queue utilization. */
+static uint32_t                      m_wakeup_cnt;                              /**< Number of RTC1 interrupts. */
 #endif
 
 /**@brief Function for initializing the RTC1 counter.
@@ -618,6 +622,7 @@ static bool list_insertions_handler(timer_node_t * p_restart_list_head)
             p_timer->ticks_at_start          = p_user_op->params.start.ticks_at_start;
             p_timer->ticks_first_interval    = p_user_op->params.start.ticks_first_interval;
             p_timer->ticks_periodic_interval = p_user_op->params.start.ticks_periodic_interval;
+            p_timer->ticks_slack             = p_user_op->params.start.ticks_slack;
             p_timer->p_context               = p_user_op->params.start.p_context;
 
             if (m_rtc1_reset)
@@ -656,6 +661,12 @@ static bool list_insertions_handler(timer_node_t * p_restart_list_head)
         p_timer->is_running           = true;
         p_timer->next                 = NULL;
 
+        // The timer must expire before the current wakeup, even if it is not first in the list.
+        if (p_timer->ticks_to_expire + p_timer->ticks_slack < m_ticks_wakeup)
+        {
+            compare_update = true;
+        }
+
         // Insert into list
         timer_list_insert(p_timer);
     }
@@ -664,6 +675,47 @@ static bool list_insertions_handler(timer_node_t * p_restart_list_head)
 }
 
 
+/**@brief Function for computing the number of ticks until the timers must be checked for expiry.
+ *
+ * @details Timers may expire up to their slack after their deadline. The check is delayed to the
+ *          latest tick which is within the slack of every timer whose deadline comes before it,
+ *          so that these timers expire together. Only the timers up to that tick are visited.
+ *
+ * @return     Number of ticks from the last known RTC counter value, at most half the RTC range.
+ */
+static uint32_t timer_list_wakeup_get(void)
+{
+    timer_node_t * p_timer  = mp_timer_id_head;
+    uint32_t       deadline = 0;
+    uint32_t       wakeup   = UINT32_MAX;
+
+    while (p_timer != NULL)
+    {
+        deadline += p_timer->ticks_to_expire;
+
+        if (deadline > wakeup)
+        {
+            break;
+        }
+
+        if (deadline + p_timer->ticks_slack < wakeup)
+        {
+            wakeup = deadline + p_timer->ticks_slack;
+        }
+
+        p_timer = p_timer->next;
+    }
+
+    // The RTC counter only wraps safely within half its range.
+    if (wakeup > (MAX_RTC_COUNTER_VAL / 2))
+    {
+        wakeup = (MAX_RTC_COUNTER_VAL / 2);
+    }
+
+    return wakeup;
+}
+
+
 /**@brief Function for updating the Capture Compare register.
  */
 static void compare_reg_update(timer_node_t * p_timer_id_head_old)
@@ -671,7 +723,7 @@ static void compare_reg_update(timer_node_t * p_timer_id_head_old)
     // Setup the timeout for timers on the head of the list
     if (mp_timer_id_head != NULL)
     {
-        uint32_t ticks_to_expire = mp_timer_id_head->ticks_to_expire;
+        uint32_t ticks_to_expire = timer_list_wakeup_get();
         uint32_t pre_counter_val = rtc1_counter_get();
         uint32_t cc              = m_ticks_latest;
         uint32_t ticks_elapsed   = ticks_diff_get(pre_counter_val, cc) + RTC_COMPARE_OFFSET_MIN;
@@ -682,7 +734,9 @@ static void compare_reg_update(timer_node_t * p_timer_id_head_old)
             rtc1_start();
         }
 
-        cc += (ticks_elapsed < ticks_to_expire) ? ticks_to_expire : ticks_elapsed;
+        m_ticks_wakeup = (ticks_elapsed < ticks_to_expire) ? ticks_to_expire : ticks_elapsed;
+
+        cc += m_ticks_wakeup;
         cc &= MAX_RTC_COUNTER_VAL;
 
         rtc1_compare0_set(cc);
@@ -816,6 +870,7 @@ static timer_user_op_t * user_op_alloc( uint8_t * p_last_index)
  * @param[in]  timer_id          Id of timer to start.
  * @param[in]  timeout_initial   Time (in ticks) to first timer expiry.
  * @param[in]  timeout_periodic  Time (in ticks) between periodic expiries.
+ * @param[in]  slack             Time (in ticks) the timer may expire after each deadline.
  * @param[in]  p_context         General purpose pointer. Will be passed to the timeout handler when
  *                               the timer expires.
  * @return     NRF_SUCCESS on success, otherwise an error code.
@@ -824,6 +879,7 @@ static timer_user_op_t * user_op_alloc( uint8_t * p_last_index)
 static uint32_t timer_start_op_schedule(timer_node_t * p_node,
                                         uint32_t        timeout_initial,
                                         uint32_t        timeout_periodic,
+                                        uint32_t        slack,
                                         void *          p_context)
 {
     uint8_t last_index;
@@ -842,6 +898,7 @@ static uint32_t timer_start_op_schedule(timer_node_t * p_node,
         p_user_op->params.start.ticks_at_start          = rtc1_counter_get();
         p_user_op->params.start.ticks_first_interval    = timeout_initial;
         p_user_op->params.start.ticks_periodic_interval = timeout_periodic;
+        p_user_op->params.start.ticks_slack             = slack;
         p_user_op->params.start.p_context               = p_context;
 
         user_op_enque(last_index);
@@ -908,6 +965,10 @@ void RTC1_IRQHandler(void)
     NRF_RTC1->EVENTS_TICK       = 0;
     NRF_RTC1->EVENTS_OVRFLW     = 0;
 
+#if APP_TIMER_WITH_PROFILER
+    m_wakeup_cnt++;
+#endif
+
     // Check for expired timers
     timer_timeouts_check();
 }
@@ -939,6 +1000,7 @@ ret_code_t app_timer_init(void)
 
 #if APP_TIMER_WITH_PROFILER
     m_max_user_op_queue_utilization   = 0;
+    m_wakeup_cnt                      = 0;
 #endif
 
     NVIC_ClearPendingIRQ(SWI_IRQn);
@@ -981,6 +1043,15 @@ ret_code_t app_timer_create(app_timer_id_t const *      p_timer_id,
 }
 
 ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    return app_timer_start_with_slack(timer_id, timeout_ticks, 0, p_context);
+}
+
+
+ret_code_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                      uint32_t       timeout_ticks,
+                                      uint32_t       slack_ticks,
+                                      void *         p_context)
 {
     uint32_t timeout_periodic;
     timer_node_t * p_node = (timer_node_t*)timer_id;
@@ -996,10 +1067,19 @@ ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void
     {
         return NRF_ERROR_INVALID_PARAM;
     }
+    if (slack_ticks > (MAX_RTC_COUNTER_VAL / 2))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
     if (p_node->p_timeout_handler == NULL)
     {
         return NRF_ERROR_INVALID_STATE;
     }
+    if ((p_node->mode == APP_TIMER_MODE_REPEATED) && (slack_ticks >= timeout_ticks))
+    {
+        // Otherwise the next deadline could pass before the current one expires.
+        return NRF_ERROR_INVALID_PARAM;
+    }
 
     // Schedule timer start operation
     timeout_periodic = (p_node->mode == APP_TIMER_MODE_REPEATED) ? timeout_ticks : 0;
@@ -1007,6 +1087,7 @@ ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void
     return timer_start_op_schedule(p_node,
                                    timeout_ticks,
                                    timeout_periodic,
+                                   slack_ticks,
                                    p_context);
 }
 
@@ -1055,6 +1136,12 @@ uint8_t app_timer_op_queue_utilization_get(void)
 {
     return m_max_user_op_queue_utilization;
 }
+
+
+uint32_t app_timer_wakeup_cnt_get(void)
+{
+    return m_wakeup_cnt;
+}
 #endif
 
 void app_timer_pause(void)
@@ -62,6 +62,12 @@
  *          @ref app_scheduler should be used or not. Even if the scheduler is
  *          not used, app_timer.h will include app_scheduler.h, so when
  *          compiling, app_scheduler.h must be available in one of the compiler include paths.
+ *
+ * @details Two implementations based on RTC1 are available. app_timer.c keeps the running timers
+ *          in a list sorted by expiry, so starting and stopping a timer takes time proportional
+ *          to the number of running timers. app_timer_wheel.c keeps them in a hierarchical timing
+ *          wheel, in which starting and stopping a timer takes constant time. Select one of them
+ *          by compiling it instead of the other. They use the same configuration.
  */
 
 #ifndef APP_TIMER_H__
@@ -85,7 +91,7 @@ extern "C" {
 #ifdef RTX
 #define APP_TIMER_NODE_SIZE             40                        /**< Size of app_timer.timer_node_t (used to allocate data). */
 #else
-#define APP_TIMER_NODE_SIZE             32                        /**< Size of app_timer.timer_node_t (used to allocate data). */
+#define APP_TIMER_NODE_SIZE             36                        /**< Size of app_timer.timer_node_t (used to allocate data). */
 #endif // RTX
 
 #define APP_TIMER_SCHED_EVENT_DATA_SIZE sizeof(app_timer_event_t) /**< Size of event data when scheduler is used. */
@@ -192,6 +198,36 @@ ret_code_t app_timer_create(app_timer_id_t const *      p_timer_id,
  */
 ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context);
 
+/**@brief Function for starting a timer which may expire later than its deadline.
+ *
+ * @details The timer expires at any time from timeout_ticks to (timeout_ticks + slack_ticks) after
+ *          it is started. Within that window, the expiry is delayed so that it coincides with the
+ *          expiry of other timers, and the CPU is woken up less often. Repeating timers keep their
+ *          period: each deadline is counted from the previous deadline, not from the actual expiry.
+ *
+ *          Use this function for timers without a strict deadline, for example periodic
+ *          housekeeping or LED blinking. app_timer_start() starts a timer without slack.
+ *
+ * @param[in]       timer_id      Timer identifier.
+ * @param[in]       timeout_ticks Number of ticks (of RTC1, including prescaling) to the deadline.
+ * @param[in]       slack_ticks   Number of ticks the timer may expire after its deadline. At most half the
+ *                                RTC counter range, and less than timeout_ticks for a repeated timer.
+ * @param[in]       p_context     General purpose pointer. Will be passed to the time-out handler when
+ *                                the timer expires.
+ *
+ * @retval     NRF_SUCCESS               If the timer was successfully started.
+ * @retval     NRF_ERROR_INVALID_PARAM   If a parameter was invalid.
+ * @retval     NRF_ERROR_INVALID_STATE   If the application timer module has not been initialized or the timer
+ *                                       has not been created.
+ * @retval     NRF_ERROR_NO_MEM          If the timer operations queue was full.
+ *
+ * @note The FreeRTOS and RTX app_timer implementations ignore the slack.
+ */
+ret_code_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                      uint32_t       timeout_ticks,
+                                      uint32_t       slack_ticks,
+                                      void *         p_context);
+
 /**@brief Function for stopping the specified timer.
  *
  * @param[in]  timer_id                  Timer identifier.
@@ -239,6 +275,17 @@ uint32_t app_timer_cnt_diff_compute(uint32_t   ticks_to,
  */
 uint8_t app_timer_op_queue_utilization_get(void);
 
+/**@brief Function for getting the number of RTC1 interrupts since the module was initialized.
+ *
+ * Each RTC1 interrupt wakes up the CPU to expire timers. Read the counter at a known interval,
+ * measured with app_timer_cnt_get(), to compute the number of wakeups per second.
+ *
+ * @note APP_TIMER_WITH_PROFILER must be enabled to use this functionality.
+ *
+ * @return Number of RTC1 interrupts.
+ */
+uint32_t app_timer_wakeup_cnt_get(void);
+
 /**
  * @brief Function for pausing RTC activity which drives app_timer.
  *
@@ -209,6 +209,17 @@ uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void *
 }
 
 
+uint32_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                    uint32_t       timeout_ticks,
+                                    uint32_t       slack_ticks,
+                                    void *         p_context)
+{
+    // The OS timers do not support slack: the timer expires at its deadline.
+    UNUSED_PARAMETER(slack_ticks);
+    return app_timer_start(timer_id, timeout_ticks, p_context);
+}
+
+
 uint32_t app_timer_stop(app_timer_id_t timer_id)
 {
     app_timer_info_t * pinfo = (app_timer_info_t*)(timer_id);
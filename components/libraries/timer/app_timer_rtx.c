@@ -208,6 +208,16 @@ ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void
     }
 }
 
+ret_code_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                      uint32_t       timeout_ticks,
+                                      uint32_t       slack_ticks,
+                                      void *         p_context)
+{
+    // The OS timers do not support slack: the timer expires at its deadline.
+    UNUSED_PARAMETER(slack_ticks);
+    return app_timer_start(timer_id, timeout_ticks, p_context);
+}
+
 ret_code_t app_timer_stop(app_timer_id_t timer_id)
 {
     app_timer_info_t * p_timer_info = (app_timer_info_t *)timer_id;
@@ -0,0 +1,1097 @@
+/**
+ * Copyright (c) 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+#include "sdk_common.h"
+#if NRF_MODULE_ENABLED(APP_TIMER)
+#include "app_timer.h"
+#include <stdlib.h>
+#include <string.h>
+#include "nrf.h"
+#include "nrf_soc.h"
+#include "app_error.h"
+#include "nrf_delay.h"
+#include "app_util_platform.h"
+#if APP_TIMER_CONFIG_USE_SCHEDULER
+#include "app_scheduler.h"
+#endif
+
+/* This file is an alternative to app_timer.c and implements the same API. Instead of a sorted list
+ * of running timers, the timers are kept in a hierarchical timing wheel, so that starting and
+ * stopping a timer takes constant time regardless of the number of running timers.
+ *
+ * Time is counted in 32-bit ticks, extended from the 24-bit RTC1 counter. Level 0 of the wheel
+ * has one slot per tick; each slot of level n spans all the slots of level n - 1. A timer is placed
+ * on the lowest level whose span covers its remaining time, and moved down ("cascaded") when the
+ * wheel reaches its slot. The RTC1 Capture Compare register is set to the tick at which the next
+ * timers must expire, so the RTC does not need to interrupt on every tick. Slots reached in between
+ * are cascaded when the wheel is advanced to that tick.
+ */
+
+#define RTC1_IRQ_PRI            APP_TIMER_CONFIG_IRQ_PRIORITY               /**< Priority of the RTC1 interrupt (used for checking for timeouts and executing timeout handlers). */
+#define SWI_IRQ_PRI             APP_TIMER_CONFIG_IRQ_PRIORITY               /**< Priority of the SWI  interrupt (used for updating the timing wheel). */
+
+// The current design assumes that both interrupt handlers run at the same interrupt level.
+// Both of them process the timing wheel, and must therefore not interrupt each other.
+STATIC_ASSERT(RTC1_IRQ_PRI == SWI_IRQ_PRI);
+
+#define MAX_RTC_COUNTER_VAL     0x00FFFFFF                                  /**< Maximum value of the RTC counter. */
+
+#define RTC_COMPARE_OFFSET_MIN  3                                           /**< Minimum offset between the current RTC counter value and the Capture Compare register. Although the nRF51 Series User Specification recommends this value to be 2, we use 3 to be safer.*/
+
+#define MAX_RTC_TASKS_DELAY     47                                          /**< Maximum delay until an RTC task is executed. */
+
+#if (APP_TIMER_CONFIG_SWI_NUMBER == 0)
+#define SWI_IRQn SWI0_IRQn
+#define SWI_IRQHandler SWI0_IRQHandler
+#elif (APP_TIMER_CONFIG_SWI_NUMBER == 1)
+#define SWI_IRQn SWI1_IRQn
+#define SWI_IRQHandler SWI1_IRQHandler
+#else
+#error "Unsupported SWI number."
+#endif
+
+#define WHEEL_LEVELS            5                                           /**< Number of levels of the timing wheel. */
+#define WHEEL_SLOT_BITS         5                                           /**< Number of tick bits indexing the slots of one level. */
+#define WHEEL_SLOTS             (1UL << WHEEL_SLOT_BITS)                    /**< Number of slots in one level. One bit of a 32-bit word per slot. */
+#define WHEEL_SLOT_MASK         (WHEEL_SLOTS - 1)
+#define WHEEL_SPAN              (1UL << (WHEEL_LEVELS * WHEEL_SLOT_BITS))   /**< Number of ticks covered by the timing wheel. */
+#define WHEEL_SLOT_NONE         0xFFFF                                      /**< Slot of a timer which is not in the timing wheel. */
+#define WHEEL_EVENT_NONE        0xFFFFFFFF                                  /**< Distance to the next event when the timing wheel is empty. */
+
+// The Capture Compare register is set at most half the range of the RTC counter ahead,
+// so that the extended tick count is updated before the counter wraps around.
+STATIC_ASSERT(WHEEL_SPAN > (MAX_RTC_COUNTER_VAL / 2));
+
+#define MODULE_INITIALIZED (m_op_queue.size != 0)                           /**< Macro designating whether the module has been initialized properly. */
+
+/**@brief Timer node type. The nodes are linked in the slots of the timing wheel. */
+typedef struct
+{
+    uint32_t                    ticks_expire;                               /**< Extended tick count at which the timer expires. */
+    uint32_t                    ticks_periodic_interval;                    /**< Timer period (for repeating timers). */
+    uint32_t                    ticks_slack;                                /**< Number of ticks the timer may expire after its deadline. */
+    app_timer_timeout_handler_t p_timeout_handler;                          /**< Pointer to function to be executed when the timer expires. */
+    void *                      p_context;                                  /**< General purpose pointer. Will be passed to the timeout handler when the timer expires. */
+    void *                      next;                                       /**< Pointer to the next node in the slot. */
+    void *                      prev;                                       /**< Pointer to the previous node in the slot. */
+    uint16_t                    slot;                                       /**< Slot holding the timer, or WHEEL_SLOT_NONE. */
+    bool                        is_running;                                 /**< True if timer is running, False otherwise. */
+    uint8_t                     mode;                                       /**< Timer mode. */
+} timer_node_t;
+
+STATIC_ASSERT(sizeof(timer_node_t) <= APP_TIMER_NODE_SIZE);
+
+/**@brief Set of available timer operation types. */
+typedef enum
+{
+    TIMER_USER_OP_TYPE_NONE,                                                /**< Invalid timer operation type. */
+    TIMER_USER_OP_TYPE_START,                                               /**< Timer operation type Start. */
+    TIMER_USER_OP_TYPE_STOP,                                                /**< Timer operation type Stop. */
+    TIMER_USER_OP_TYPE_STOP_ALL                                             /**< Timer operation type Stop All. */
+} timer_user_op_type_t;
+
+/**@brief Structure describing a timer start operation. */
+typedef struct
+{
+    uint32_t ticks_at_start;                                                /**< Current RTC counter value when the timer was started. */
+    uint32_t ticks_first_interval;                                          /**< Number of ticks in the first timer interval. */
+    uint32_t ticks_periodic_interval;                                       /**< Timer period (for repeating timers). */
+    uint32_t ticks_slack;                                                   /**< Number of ticks the timer may expire after its deadline. */
+    void *   p_context;                                                     /**< General purpose pointer. Will be passed to the timeout handler when the timer expires. */
+} timer_user_op_start_t;
+
+/**@brief Structure describing a timer operation. */
+typedef struct
+{
+    timer_user_op_type_t op_type;                                           /**< Type of the operation. */
+    timer_node_t *       p_node;                                            /**< Timer on which the operation is to be performed. */
+    union
+    {
+        timer_user_op_start_t start;                                        /**< Structure describing a timer start operation. */
+    } params;
+} timer_user_op_t;
+
+/**@brief Structure describing a timer operations queue.
+ *
+ * @details This queue will hold timer operations issued by the application
+ *          until the timer interrupt handler processes these operations.
+ */
+typedef struct
+{
+    uint8_t           first;                                                /**< Index of first entry to have been inserted in the queue (i.e. the next entry to be executed). */
+    uint8_t           last;                                                 /**< Index of last entry to have been inserted in the queue. */
+    uint8_t           size;                                                 /**< Queue size. */
+    timer_user_op_t   user_op_queue[APP_TIMER_CONFIG_OP_QUEUE_SIZE+1];      /**< Queue buffer. */
+} timer_op_queue_t;
+
+STATIC_ASSERT(sizeof(timer_op_queue_t) % 4 == 0);
+
+static timer_op_queue_t              m_op_queue;                            /**< Timer operations queue. */
+static timer_node_t *                m_wheel[WHEEL_LEVELS * WHEEL_SLOTS];   /**< Lists of the timers in each slot of the timing wheel. */
+static uint32_t                      m_wheel_map[WHEEL_LEVELS];             /**< Slots which hold timers, one bit per slot, slot 0 in the most significant bit. */
+static uint32_t                      m_wheel_pos;                           /**< Next tick to be processed by the timing wheel. */
+static uint32_t                      m_ticks_ext;                           /**< Extended tick count at the last known RTC counter value. */
+static uint32_t                      m_ticks_latest;                        /**< Last known RTC counter value. */
+static bool                          m_rtc1_running;                        /**< Boolean indicating if RTC1 is running. */
+
+#if APP_TIMER_WITH_PROFILER
+static uint8_t                       m_max_user_op_queue_utilization;       /**< Maximum observed timer user operations queue utilization. */
+static uint32_t                      m_wakeup_cnt;                          /**< Number of RTC1 interrupts. */
+#endif
+
+/**@brief Function for initializing the RTC1 counter.
+ *
+ * @param[in] prescaler   Value of the RTC1 PRESCALER register. Set to 0 for no prescaling.
+ */
+static void rtc1_init(uint32_t prescaler)
+{
+    NRF_RTC1->PRESCALER = prescaler;
+    NVIC_SetPriority(RTC1_IRQn, RTC1_IRQ_PRI);
+}
+
+
+/**@brief Function for starting the RTC1 timer.
+ */
+static void rtc1_start(void)
+{
+    NRF_RTC1->EVTENSET = RTC_EVTEN_COMPARE0_Msk;
+    NRF_RTC1->INTENSET = RTC_INTENSET_COMPARE0_Msk;
+
+    NVIC_ClearPendingIRQ(RTC1_IRQn);
+    NVIC_EnableIRQ(RTC1_IRQn);
+
+    NRF_RTC1->TASKS_START = 1;
+    nrf_delay_us(MAX_RTC_TASKS_DELAY);
+
+    m_rtc1_running = true;
+}
+
+
+/**@brief Function for stopping the RTC1 timer.
+ */
+static void rtc1_stop(void)
+{
+    NVIC_DisableIRQ(RTC1_IRQn);
+
+    NRF_RTC1->EVTENCLR = RTC_EVTEN_COMPARE0_Msk;
+    NRF_RTC1->INTENCLR = RTC_INTENSET_COMPARE0_Msk;
+
+    NRF_RTC1->TASKS_STOP = 1;
+    nrf_delay_us(MAX_RTC_TASKS_DELAY);
+
+    NRF_RTC1->TASKS_CLEAR = 1;
+    m_ticks_latest        = 0;
+    nrf_delay_us(MAX_RTC_TASKS_DELAY);
+
+    m_rtc1_running = false;
+}
+
+
+/**@brief Function for returning the current value of the RTC1 counter.
+ *
+ * @return     Current value of the RTC1 counter.
+ */
+static __INLINE uint32_t rtc1_counter_get(void)
+{
+    return NRF_RTC1->COUNTER;
+}
+
+
+/**@brief Function for computing the difference between two RTC1 counter values.
+ *
+ * @return     Number of ticks elapsed from ticks_old to ticks_now.
+ */
+static __INLINE uint32_t ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old)
+{
+    return ((ticks_now - ticks_old) & MAX_RTC_COUNTER_VAL);
+}
+
+
+/**@brief Function for setting the RTC1 Capture Compare register 0, and enabling the corresponding
+ *        event.
+ *
+ * @param[in] value   New value of Capture Compare register 0.
+ */
+static __INLINE void rtc1_compare0_set(uint32_t value)
+{
+    NRF_RTC1->CC[0] = value;
+}
+
+
+/**@brief Function for updating the extended tick count from the RTC1 counter.
+ */
+static void ticks_ext_update(void)
+{
+    uint32_t const counter = rtc1_counter_get();
+
+    m_ticks_ext   += ticks_diff_get(counter, m_ticks_latest);
+    m_ticks_latest = counter;
+}
+
+
+/**@brief Function for inserting a timer in the timing wheel.
+ *
+ * @details The timer is placed on the lowest level whose slots span the time remaining until it
+ *          expires. Timers which have already expired are placed in the slot of the next tick to be
+ *          processed, and timers beyond the span of the wheel in its last slot, from which they are
+ *          inserted again when it is reached.
+ *
+ * @param[in]  p_timer   Timer to insert.
+ */
+static void wheel_insert(timer_node_t * p_timer)
+{
+    uint32_t delta = p_timer->ticks_expire - m_wheel_pos;
+    uint32_t level = 0;
+
+    if (delta > (UINT32_MAX / 2))
+    {
+        // Already expired.
+        delta = 0;
+    }
+    else if (delta >= WHEEL_SPAN)
+    {
+        delta = WHEEL_SPAN - 1;
+    }
+
+    if (delta >= WHEEL_SLOTS)
+    {
+        level = (31 - __CLZ(delta)) / WHEEL_SLOT_BITS;
+    }
+
+    uint32_t const index = ((m_wheel_pos + delta) >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+    uint32_t const slot  = (level * WHEEL_SLOTS) + index;
+
+    p_timer->slot = slot;
+    p_timer->prev = NULL;
+    p_timer->next = m_wheel[slot];
+
+    if (m_wheel[slot] != NULL)
+    {
+        m_wheel[slot]->prev = p_timer;
+    }
+
+    m_wheel[slot]       = p_timer;
+    m_wheel_map[level] |= (0x80000000 >> index);
+}
+
+
+/**@brief Function for removing a timer from the timing wheel.
+ *
+ * @param[in]  p_timer   Timer to remove. Nothing is done if the timer is not in the wheel.
+ */
+static void wheel_remove(timer_node_t * p_timer)
+{
+    uint32_t const slot = p_timer->slot;
+
+    if (slot == WHEEL_SLOT_NONE)
+    {
+        return;
+    }
+
+    timer_node_t * const p_next = p_timer->next;
+    timer_node_t * const p_prev = p_timer->prev;
+
+    if (p_next != NULL)
+    {
+        p_next->prev = p_prev;
+    }
+
+    if (p_prev != NULL)
+    {
+        p_prev->next = p_next;
+    }
+    else
+    {
+        m_wheel[slot] = p_next;
+
+        if (p_next == NULL)
+        {
+            m_wheel_map[slot / WHEEL_SLOTS] &= ~(0x80000000 >> (slot % WHEEL_SLOTS));
+        }
+    }
+
+    p_timer->slot = WHEEL_SLOT_NONE;
+}
+
+
+/**@brief Function for taking all timers out of a slot of the timing wheel.
+ *
+ * @param[in]  level   Level of the slot.
+ * @param[in]  index   Index of the slot in the level.
+ *
+ * @return     List of the timers which were in the slot, linked by their next pointers.
+ */
+static timer_node_t * wheel_slot_detach(uint32_t level, uint32_t index)
+{
+    uint32_t       const slot   = (level * WHEEL_SLOTS) + index;
+    timer_node_t * const p_list = m_wheel[slot];
+
+    m_wheel[slot]       = NULL;
+    m_wheel_map[level] &= ~(0x80000000 >> index);
+
+    for (timer_node_t * p_timer = p_list; p_timer != NULL; p_timer = p_timer->next)
+    {
+        p_timer->slot = WHEEL_SLOT_NONE;
+    }
+
+    return p_list;
+}
+
+
+/**@brief Function for computing the number of ticks until the timing wheel must next be processed.
+ *
+ * @details This is the earliest of the next tick with a timer in level 0, and the next tick at
+ *          which a non-empty slot of a higher level is reached and must be cascaded.
+ *
+ * @return     Number of ticks from the next tick to be processed, or WHEEL_EVENT_NONE if the
+ *             timing wheel is empty.
+ */
+static uint32_t wheel_next_event_get(void)
+{
+    uint32_t distance = WHEEL_EVENT_NONE;
+
+    for (uint32_t level = 0; level < WHEEL_LEVELS; level++)
+    {
+        uint32_t const map   = m_wheel_map[level];
+        uint32_t const shift = level * WHEEL_SLOT_BITS;
+
+        if (map == 0)
+        {
+            continue;
+        }
+
+        // First slot of this level which starts at or after the next tick to be processed.
+        uint32_t const mask    = (1UL << shift) - 1;
+        uint32_t const first   = (m_wheel_pos >> shift) + ((m_wheel_pos & mask) != 0);
+        uint32_t const index   = first & WHEEL_SLOT_MASK;
+        uint32_t const rotated = (index == 0) ? map : ((map << index) | (map >> (WHEEL_SLOTS - index)));
+        uint32_t const ticks   = ((first + __CLZ(rotated)) << shift) - m_wheel_pos;
+
+        if (ticks < distance)
+        {
+            distance = ticks;
+        }
+    }
+
+    return distance;
+}
+
+
+/**@brief Function for computing the number of ticks until the timing wheel must be advanced to
+ *        expire timers.
+ *
+ * @details Timers may expire up to their slack after their deadline. The wheel is advanced at the
+ *          latest tick which is within the slack of every timer whose deadline comes before it, so
+ *          that these timers expire together. The slots of each level are visited in order, up to
+ *          the first slot which starts after that tick.
+ *
+ * @return     Number of ticks from the next tick to be processed, or WHEEL_EVENT_NONE if the
+ *             timing wheel is empty.
+ */
+static uint32_t wheel_wakeup_get(void)
+{
+    uint32_t wakeup = WHEEL_EVENT_NONE;
+
+    for (uint32_t level = 0; level < WHEEL_LEVELS; level++)
+    {
+        uint32_t       map   = m_wheel_map[level];
+        uint32_t const shift = level * WHEEL_SLOT_BITS;
+        uint32_t const mask  = (1UL << shift) - 1;
+        uint32_t const first = (m_wheel_pos >> shift) + ((m_wheel_pos & mask) != 0);
+        uint32_t const index = first & WHEEL_SLOT_MASK;
+
+        while (map != 0)
+        {
+            uint32_t const rotated = (index == 0) ? map : ((map << index) | (map >> (WHEEL_SLOTS - index)));
+            uint32_t const slot    = first + __CLZ(rotated);
+
+            // The timers in this slot and the following ones expire after the wakeup tick.
+            if (((slot << shift) - m_wheel_pos) > wakeup)
+            {
+                break;
+            }
+
+            for (timer_node_t * p_timer = m_wheel[(level * WHEEL_SLOTS) + (slot & WHEEL_SLOT_MASK)];
+                 p_timer != NULL;
+                 p_timer = p_timer->next)
+            {
+                uint32_t ticks = p_timer->ticks_expire - m_wheel_pos;
+
+                if (ticks > (UINT32_MAX / 2))
+                {
+                    // Already expired.
+                    ticks = 0;
+                }
+
+                if (ticks + p_timer->ticks_slack < wakeup)
+                {
+                    wakeup = ticks + p_timer->ticks_slack;
+                }
+            }
+
+            map &= ~(0x80000000 >> (slot & WHEEL_SLOT_MASK));
+        }
+    }
+
+    return wakeup;
+}
+
+
+/**@brief Function for scheduling a check for timeouts by generating a RTC1 interrupt.
+ */
+static void timer_timeouts_check_sched(void)
+{
+    NVIC_SetPendingIRQ(RTC1_IRQn);
+}
+
+
+/**@brief Function for scheduling a timing wheel update by generating a SWI interrupt.
+ */
+static void timer_list_handler_sched(void)
+{
+    NVIC_SetPendingIRQ(SWI_IRQn);
+}
+
+#if APP_TIMER_CONFIG_USE_SCHEDULER
+static void timeout_handler_scheduled_exec(void * p_event_data, uint16_t event_size)
+{
+    APP_ERROR_CHECK_BOOL(event_size == sizeof(app_timer_event_t));
+    app_timer_event_t const * p_timer_event = (app_timer_event_t *)p_event_data;
+
+    p_timer_event->timeout_handler(p_timer_event->p_context);
+}
+#endif
+
+/**@brief Function for executing an application timeout handler, either by calling it directly, or
+ *        by passing an event to the @ref app_scheduler.
+ *
+ * @param[in]  p_timer   Pointer to expired timer.
+ */
+static void timeout_handler_exec(timer_node_t * p_timer)
+{
+#if APP_TIMER_CONFIG_USE_SCHEDULER
+    app_timer_event_t timer_event;
+
+    timer_event.timeout_handler = p_timer->p_timeout_handler;
+    timer_event.p_context       = p_timer->p_context;
+    uint32_t err_code = app_sched_event_put(&timer_event, sizeof(timer_event), timeout_handler_scheduled_exec);
+    APP_ERROR_CHECK(err_code);
+#else
+    p_timer->p_timeout_handler(p_timer->p_context);
+#endif
+}
+
+
+/**@brief Function for processing one tick of the timing wheel.
+ *
+ * @details Cascades the slots of the higher levels which are reached at this tick, then expires the
+ *          timers in the level 0 slot of the tick. Repeating timers are inserted again.
+ *
+ * @param[in]  tick   Tick to process. Must be the next tick to be processed, or a later tick if no
+ *                    timers expire and no slots are reached in between.
+ */
+static void wheel_tick_process(uint32_t tick)
+{
+    timer_node_t * p_list;
+
+    m_wheel_pos = tick;
+
+    for (uint32_t level = 1; level < WHEEL_LEVELS; level++)
+    {
+        uint32_t const shift = level * WHEEL_SLOT_BITS;
+
+        if ((tick & ((1UL << shift) - 1)) != 0)
+        {
+            break;
+        }
+
+        p_list = wheel_slot_detach(level, (tick >> shift) & WHEEL_SLOT_MASK);
+
+        while (p_list != NULL)
+        {
+            timer_node_t * const p_timer = p_list;
+
+            p_list = p_timer->next;
+            wheel_insert(p_timer);
+        }
+    }
+
+    p_list      = wheel_slot_detach(0, tick & WHEEL_SLOT_MASK);
+    m_wheel_pos = tick + 1;
+
+    while (p_list != NULL)
+    {
+        timer_node_t * const p_timer = p_list;
+
+        p_list = p_timer->next;
+
+        // The timer might have been stopped, its stop operation not yet processed.
+        if (!p_timer->is_running)
+        {
+            continue;
+        }
+
+        if (p_timer->ticks_periodic_interval != 0)
+        {
+            p_timer->ticks_expire += p_timer->ticks_periodic_interval;
+            wheel_insert(p_timer);
+        }
+        else
+        {
+            p_timer->is_running = false;
+        }
+
+        timeout_handler_exec(p_timer);
+    }
+}
+
+
+/**@brief Function for processing all ticks of the timing wheel up to the current time.
+ */
+static void wheel_advance(void)
+{
+    // Number of ticks to process, up to and including the current one.
+    uint32_t ticks_left = m_ticks_ext + 1 - m_wheel_pos;
+
+    while (ticks_left != 0)
+    {
+        uint32_t const distance = wheel_next_event_get();
+
+        if (distance >= ticks_left)
+        {
+            m_wheel_pos += ticks_left;
+            break;
+        }
+
+        ticks_left -= (distance + 1);
+        wheel_tick_process(m_wheel_pos + distance);
+    }
+}
+
+
+/**@brief Function for processing the queued timer operations.
+ */
+static void user_ops_process(void)
+{
+    while (m_op_queue.first != m_op_queue.last)
+    {
+        timer_user_op_t * p_user_op = &m_op_queue.user_op_queue[m_op_queue.first];
+        timer_node_t    * p_timer   = p_user_op->p_node;
+
+        m_op_queue.first++;
+        if (m_op_queue.first == m_op_queue.size)
+        {
+            m_op_queue.first = 0;
+        }
+
+        switch (p_user_op->op_type)
+        {
+            case TIMER_USER_OP_TYPE_STOP:
+                wheel_remove(p_timer);
+                p_timer->is_running = false;
+                break;
+
+            case TIMER_USER_OP_TYPE_STOP_ALL:
+                // Empty the timing wheel, and mark all timers as not running.
+                for (uint32_t level = 0; level < WHEEL_LEVELS; level++)
+                {
+                    while (m_wheel_map[level] != 0)
+                    {
+                        timer_node_t * p_list = wheel_slot_detach(level, __CLZ(m_wheel_map[level]));
+
+                        for (; p_list != NULL; p_list = p_list->next)
+                        {
+                            p_list->is_running = false;
+                        }
+                    }
+                }
+                break;
+
+            case TIMER_USER_OP_TYPE_START:
+            {
+                uint32_t ticks_at_start = p_user_op->params.start.ticks_at_start;
+
+                if (p_timer->is_running)
+                {
+                    break;
+                }
+
+                // The RTC counter is cleared when stopped. Operations queued before that count from zero.
+                if (!m_rtc1_running)
+                {
+                    ticks_at_start = 0;
+                }
+
+                // A timer whose stop operation could not be queued might still be in the wheel.
+                wheel_remove(p_timer);
+
+                p_timer->ticks_expire            = m_ticks_ext
+                                                 - ticks_diff_get(m_ticks_latest, ticks_at_start)
+                                                 + p_user_op->params.start.ticks_first_interval;
+                p_timer->ticks_periodic_interval = p_user_op->params.start.ticks_periodic_interval;
+                p_timer->ticks_slack             = p_user_op->params.start.ticks_slack;
+                p_timer->p_context               = p_user_op->params.start.p_context;
+                p_timer->is_running              = true;
+
+                wheel_insert(p_timer);
+            } break;
+
+            default:
+                // No implementation needed.
+                break;
+        }
+    }
+}
+
+
+/**@brief Function for updating the Capture Compare register.
+ */
+static void compare_reg_update(void)
+{
+    uint32_t ticks_to_expire = wheel_wakeup_get();
+
+    if (ticks_to_expire == WHEEL_EVENT_NONE)
+    {
+#if (APP_TIMER_KEEPS_RTC_ACTIVE == 0)
+        // No timers are running, stop RTC
+        rtc1_stop();
+#endif //(APP_TIMER_KEEPS_RTC_ACTIVE == 0)
+        return;
+    }
+
+    if (!m_rtc1_running)
+    {
+        // No timers were already running, start RTC
+        rtc1_start();
+    }
+
+    // Ticks from the last known RTC counter value to the wakeup.
+    ticks_to_expire += (m_wheel_pos - m_ticks_ext);
+    if (ticks_to_expire > (MAX_RTC_COUNTER_VAL / 2))
+    {
+        ticks_to_expire = (MAX_RTC_COUNTER_VAL / 2);
+    }
+
+    uint32_t pre_counter_val = rtc1_counter_get();
+    uint32_t cc              = m_ticks_latest;
+    uint32_t ticks_elapsed   = ticks_diff_get(pre_counter_val, cc) + RTC_COMPARE_OFFSET_MIN;
+
+    cc += (ticks_elapsed < ticks_to_expire) ? ticks_to_expire : ticks_elapsed;
+    cc &= MAX_RTC_COUNTER_VAL;
+
+    rtc1_compare0_set(cc);
+
+    uint32_t post_counter_val = rtc1_counter_get();
+
+    if (
+        (ticks_diff_get(post_counter_val, pre_counter_val) + RTC_COMPARE_OFFSET_MIN)
+        >
+        ticks_diff_get(cc, pre_counter_val)
+       )
+    {
+        // When this happens the COMPARE event may not be triggered by the RTC.
+        // The nRF51 Series User Specification states that if the COUNTER value is N
+        // (i.e post_counter_val = N), writing N or N + 1 to a CC register may not trigger a
+        // COMPARE event. Hence the RTC interrupt is forcefully pended by calling the following
+        // function.
+        rtc1_compare0_set(rtc1_counter_get());  // this should prevent CC to fire again in the background while the code is in RTC-ISR
+        nrf_delay_us(MAX_RTC_TASKS_DELAY);
+        timer_timeouts_check_sched();
+    }
+}
+
+
+/**@brief Function for handling timer operations and timeouts.
+ *
+ * @details Called from both interrupt handlers. Processes the queued operations, expires the
+ *          timers which are due and sets the Capture Compare register for the next event.
+ */
+static void timer_wheel_handler(void)
+{
+#if APP_TIMER_WITH_PROFILER
+    {
+        uint8_t size = m_op_queue.size;
+        uint8_t first = m_op_queue.first;
+        uint8_t last = m_op_queue.last;
+        uint8_t utilization = (first <= last) ? (last - first) : (size + 1 - first + last);
+
+        if (utilization > m_max_user_op_queue_utilization)
+        {
+            m_max_user_op_queue_utilization = utilization;
+        }
+    }
+#endif
+
+    ticks_ext_update();
+    user_ops_process();
+    wheel_advance();
+    compare_reg_update();
+}
+
+
+/**@brief Function for enqueueing a new operations queue entry.
+ *
+ * @param[in]  last_index Index of the next last index to be enqueued.
+ */
+static void user_op_enque(uint8_t last_index)
+{
+    m_op_queue.last = last_index;
+}
+
+
+/**@brief Function for allocating a new operations queue entry.
+ *
+ * @param[out] p_last_index Index of the next last index to be enqueued.
+ *
+ * @return     Pointer to allocated queue entry, or NULL if queue is full.
+ */
+static timer_user_op_t * user_op_alloc( uint8_t * p_last_index)
+{
+    uint8_t           last;
+    timer_user_op_t * p_user_op;
+
+    last = m_op_queue.last + 1;
+    if (last == m_op_queue.size)
+    {
+        // Overflow case.
+        last = 0;
+    }
+    if (last == m_op_queue.first)
+    {
+        // Queue is full.
+        return NULL;
+    }
+
+    *p_last_index = last;
+    p_user_op     = &m_op_queue.user_op_queue[m_op_queue.last];
+
+    return p_user_op;
+}
+
+
+/**@brief Function for scheduling a Timer Start operation.
+ *
+ * @param[in]  timer_id          Id of timer to start.
+ * @param[in]  timeout_initial   Time (in ticks) to first timer expiry.
+ * @param[in]  timeout_periodic  Time (in ticks) between periodic expiries.
+ * @param[in]  slack             Time (in ticks) the timer may expire after each deadline.
+ * @param[in]  p_context         General purpose pointer. Will be passed to the timeout handler when
+ *                               the timer expires.
+ * @return     NRF_SUCCESS on success, otherwise an error code.
+ */
+static uint32_t timer_start_op_schedule(timer_node_t * p_node,
+                                        uint32_t        timeout_initial,
+                                        uint32_t        timeout_periodic,
+                                        uint32_t        slack,
+                                        void *          p_context)
+{
+    uint8_t last_index;
+    uint32_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    timer_user_op_t * p_user_op = user_op_alloc(&last_index);
+    if (p_user_op == NULL)
+    {
+        err_code = NRF_ERROR_NO_MEM;
+    }
+    else
+    {
+        p_user_op->op_type                              = TIMER_USER_OP_TYPE_START;
+        p_user_op->p_node                               = p_node;
+        p_user_op->params.start.ticks_at_start          = rtc1_counter_get();
+        p_user_op->params.start.ticks_first_interval    = timeout_initial;
+        p_user_op->params.start.ticks_periodic_interval = timeout_periodic;
+        p_user_op->params.start.ticks_slack             = slack;
+        p_user_op->params.start.p_context               = p_context;
+
+        user_op_enque(last_index);
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (err_code == NRF_SUCCESS)
+    {
+        timer_list_handler_sched();
+    }
+
+    return err_code;
+}
+
+
+/**@brief Function for scheduling a Timer Stop operation.
+ *
+ * @param[in]  timer_id   Id of timer to stop.
+ * @param[in]  op_type    Type of stop operation
+ *
+ * @return NRF_SUCCESS on successful scheduling a timer stop operation. NRF_ERROR_NO_MEM when there
+ *         is no memory left to schedule the timer stop operation.
+ */
+static uint32_t timer_stop_op_schedule(timer_node_t * p_node,
+                                       timer_user_op_type_t op_type)
+{
+    uint8_t last_index;
+    uint32_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    timer_user_op_t * p_user_op = user_op_alloc(&last_index);
+    if (p_user_op == NULL)
+    {
+        err_code = NRF_ERROR_NO_MEM;
+    }
+    else
+    {
+        p_user_op->op_type  = op_type;
+        p_user_op->p_node = p_node;
+
+        user_op_enque(last_index);
+    }
+    CRITICAL_REGION_EXIT();
+
+    if (err_code == NRF_SUCCESS)
+    {
+        timer_list_handler_sched();
+    }
+
+    return err_code;
+}
+
+/**@brief Function for handling the RTC1 interrupt.
+ *
+ * @details Checks for timeouts, and executes timeout handlers for expired timers.
+ */
+void RTC1_IRQHandler(void)
+{
+    // Clear all events (also unexpected ones)
+    NRF_RTC1->EVENTS_COMPARE[0] = 0;
+    NRF_RTC1->EVENTS_COMPARE[1] = 0;
+    NRF_RTC1->EVENTS_COMPARE[2] = 0;
+    NRF_RTC1->EVENTS_COMPARE[3] = 0;
+    NRF_RTC1->EVENTS_TICK       = 0;
+    NRF_RTC1->EVENTS_OVRFLW     = 0;
+
+#if APP_TIMER_WITH_PROFILER
+    m_wakeup_cnt++;
+#endif
+
+    timer_wheel_handler();
+}
+
+
+/**@brief Function for handling the SWI interrupt.
+ *
+ * @details Performs the queued timer operations.
+ */
+void SWI_IRQHandler(void)
+{
+    timer_wheel_handler();
+}
+
+
+ret_code_t app_timer_init(void)
+{
+    // Stop RTC to prevent any running timers from expiring (in case of reinitialization)
+    rtc1_stop();
+
+    // Initialize operation queue
+    m_op_queue.first           = 0;
+    m_op_queue.last            = 0;
+    m_op_queue.size            = APP_TIMER_CONFIG_OP_QUEUE_SIZE+1;
+
+    memset(m_wheel, 0x00, sizeof(m_wheel));
+    memset(m_wheel_map, 0x00, sizeof(m_wheel_map));
+    m_wheel_pos = 0;
+    m_ticks_ext = 0;
+
+#if APP_TIMER_WITH_PROFILER
+    m_max_user_op_queue_utilization   = 0;
+    m_wakeup_cnt                      = 0;
+#endif
+
+    NVIC_ClearPendingIRQ(SWI_IRQn);
+    NVIC_SetPriority(SWI_IRQn, SWI_IRQ_PRI);
+    NVIC_EnableIRQ(SWI_IRQn);
+
+    rtc1_init(APP_TIMER_CONFIG_RTC_FREQUENCY);
+
+    m_ticks_latest = rtc1_counter_get();
+
+    return NRF_SUCCESS;
+}
+
+
+ret_code_t app_timer_create(app_timer_id_t const *      p_timer_id,
+                            app_timer_mode_t            mode,
+                            app_timer_timeout_handler_t timeout_handler)
+{
+    // Check state and parameters
+    VERIFY_MODULE_INITIALIZED();
+
+    if (timeout_handler == NULL)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (p_timer_id == NULL)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (((timer_node_t*)*p_timer_id)->is_running)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    timer_node_t * p_node     = (timer_node_t *)*p_timer_id;
+    p_node->is_running        = false;
+    p_node->slot              = WHEEL_SLOT_NONE;
+    p_node->mode              = mode;
+    p_node->p_timeout_handler = timeout_handler;
+    return NRF_SUCCESS;
+}
+
+ret_code_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context)
+{
+    return app_timer_start_with_slack(timer_id, timeout_ticks, 0, p_context);
+}
+
+
+ret_code_t app_timer_start_with_slack(app_timer_id_t timer_id,
+                                      uint32_t       timeout_ticks,
+                                      uint32_t       slack_ticks,
+                                      void *         p_context)
+{
+    uint32_t timeout_periodic;
+    timer_node_t * p_node = (timer_node_t*)timer_id;
+
+    // Check state and parameters
+    VERIFY_MODULE_INITIALIZED();
+
+    if (timer_id == 0)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if (timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS)
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (slack_ticks > (MAX_RTC_COUNTER_VAL / 2))
+    {
+        return NRF_ERROR_INVALID_PARAM;
+    }
+    if (p_node->p_timeout_handler == NULL)
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+    if ((p_node->mode == APP_TIMER_MODE_REPEATED) && (slack_ticks >= timeout_ticks))
+    {
+        // Otherwise the next deadline could pass before the current one expires.
+        return NRF_ERROR_INVALID_PARAM;
+    }
+
+    // Schedule timer start operation
+    timeout_periodic = (p_node->mode == APP_TIMER_MODE_REPEATED) ? timeout_ticks : 0;
+
+    return timer_start_op_schedule(p_node,
+                                   timeout_ticks,
+                                   timeout_periodic,
+                                   slack_ticks,
+                                   p_context);
+}
+
+
+ret_code_t app_timer_stop(app_timer_id_t timer_id)
+{
+    timer_node_t * p_node = (timer_node_t*)timer_id;
+    // Check state and parameters
+    VERIFY_MODULE_INITIALIZED();
+
+    if ((timer_id == NULL) || (p_node->p_timeout_handler == NULL))
+    {
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    p_node->is_running = false;
+
+    // Schedule timer stop operation
+    return timer_stop_op_schedule(p_node, TIMER_USER_OP_TYPE_STOP);
+}
+
+
+ret_code_t app_timer_stop_all(void)
+{
+    // Check state
+    VERIFY_MODULE_INITIALIZED();
+
+    return timer_stop_op_schedule(NULL, TIMER_USER_OP_TYPE_STOP_ALL);
+}
+
+
+uint32_t app_timer_cnt_get(void)
+{
+    return rtc1_counter_get();
+}
+
+
+uint32_t app_timer_cnt_diff_compute(uint32_t   ticks_to,
+                                    uint32_t   ticks_from)
+{
+    return ticks_diff_get(ticks_to, ticks_from);
+}
+
+#if APP_TIMER_WITH_PROFILER
+uint8_t app_timer_op_queue_utilization_get(void)
+{
+    return m_max_user_op_queue_utilization;
+}
+
+
+uint32_t app_timer_wakeup_cnt_get(void)
+{
+    return m_wakeup_cnt;
+}
+#endif
+
+void app_timer_pause(void)
+{
+    NRF_RTC1->TASKS_STOP = 1;
+}
+
+void app_timer_resume(void)
+{
+    NRF_RTC1->TASKS_START = 1;
+}
+
+#endif //NRF_MODULE_ENABLED(APP_TIMER)
@@ -0,0 +1,469 @@
+/**
+ * Copyright (c) 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+
+/**@file
+ *
+ * @brief Host benchmark of the app_timer implementations, using a virtual RTC1.
+ *
+ * @details Runs @p timers timers for @p seconds seconds of RTC time, and prints the CPU time spent
+ *          in the timer interrupts and in the API, the number of RTC1 wakeups and the expiry
+ *          accuracy. Without @p timers, the benchmark is run for 10, 100 and 1000 timers.
+ *
+ *          app_timer_bench [seconds] [timers] [seed]
+ *
+ *          Half of the timers are repeated timers, the other half are single-shot timers that are
+ *          restarted from their timeout handler. The timeouts are between 1 ms and 1 s, and every
+ *          timer is started with a slack of an eighth of its timeout. Every 10 ms, a random timer
+ *          is stopped and started again from the main context. A timer that expires before its
+ *          timeout, after its timeout plus slack, or while it is stopped, is counted as an error,
+ *          and the benchmark then returns a nonzero exit code.
+ *
+ *          The implementation is selected with APP_TIMER_SOURCE. The benchmark is built for the
+ *          host from the SDK root, with the sdk_config.h of the application being measured:
+ *
+ *          gcc -O2 -std=gnu99 -DNRF52832_XXAA -DNRF52 -U__unix -U__unix__ -Uunix
+ *              -D__STATIC_INLINE="static inline" -DAPP_TIMER_ENABLED=1
+ *              -DAPP_TIMER_SOURCE=\"app_timer_wheel.c\" -I<directory of sdk_config.h>
+ *              -Icomponents/device -Icomponents/toolchain -Icomponents/toolchain/cmsis/include
+ *              -Icomponents/softdevice/s132/headers -Icomponents/libraries/util
+ *              -Icomponents/drivers_nrf/delay -Icomponents/libraries/timer
+ *              components/libraries/timer/tools/app_timer_bench.c -o app_timer_bench_wheel
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* The device, SoftDevice and platform headers are replaced by the virtual peripherals below. */
+#define NRF_H
+#define NRF_SOC_H__
+#define _NRF_DELAY_H
+#define APP_UTIL_PLATFORM_H__
+
+typedef enum
+{
+    RTC1_IRQn = 17,
+    SWI0_IRQn = 20,
+    SWI1_IRQn = 21,
+} IRQn_Type;
+
+typedef struct
+{
+    volatile uint32_t TASKS_START;
+    volatile uint32_t TASKS_STOP;
+    volatile uint32_t TASKS_CLEAR;
+    volatile uint32_t EVENTS_TICK;
+    volatile uint32_t EVENTS_OVRFLW;
+    volatile uint32_t EVENTS_COMPARE[4];
+    volatile uint32_t INTENSET;
+    volatile uint32_t INTENCLR;
+    volatile uint32_t EVTENSET;
+    volatile uint32_t EVTENCLR;
+    volatile uint32_t COUNTER;
+    volatile uint32_t PRESCALER;
+    volatile uint32_t CC[4];
+} NRF_RTC_Type;
+
+#define RTC_INTENSET_COMPARE0_Msk (1UL << 16)
+#define RTC_EVTEN_COMPARE0_Msk    (1UL << 16)
+
+static NRF_RTC_Type m_rtc;
+
+#define NRF_RTC1 (&m_rtc)
+
+static bool     m_rtc_running;
+static uint32_t m_rtc_inten;
+static uint32_t m_irq_enabled;
+static uint32_t m_irq_pending;
+
+
+/**@brief Function for executing the tasks and the interrupt enable writes of the virtual RTC1. */
+static void rtc_apply(void)
+{
+    if (m_rtc.TASKS_START) { m_rtc.TASKS_START = 0; m_rtc_running = true;  }
+    if (m_rtc.TASKS_STOP)  { m_rtc.TASKS_STOP  = 0; m_rtc_running = false; }
+    if (m_rtc.TASKS_CLEAR) { m_rtc.TASKS_CLEAR = 0; m_rtc.COUNTER = 0;    }
+
+    m_rtc_inten   |= m_rtc.INTENSET;
+    m_rtc_inten   &= ~m_rtc.INTENCLR;
+    m_rtc.INTENSET = 0;
+    m_rtc.INTENCLR = 0;
+    m_rtc.EVTENSET = 0;
+    m_rtc.EVTENCLR = 0;
+}
+
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) { (void)irq; (void)priority; }
+static inline void NVIC_EnableIRQ(IRQn_Type irq)       { m_irq_enabled |=  (1UL << irq); }
+static inline void NVIC_DisableIRQ(IRQn_Type irq)      { m_irq_enabled &= ~(1UL << irq); }
+static inline void NVIC_SetPendingIRQ(IRQn_Type irq)   { m_irq_pending |=  (1UL << irq); }
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irq) { m_irq_pending &= ~(1UL << irq); }
+
+static inline uint32_t __CLZ(uint32_t value)
+{
+    return (value == 0) ? 32 : (uint32_t)__builtin_clz(value);
+}
+
+static inline uint32_t __REV(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+
+static inline void nrf_delay_us(uint32_t us)
+{
+    (void)us;
+    rtc_apply();
+}
+
+/* The interrupts are run one at a time from the benchmark loop, so nothing can preempt. */
+#define CRITICAL_REGION_ENTER() {
+#define CRITICAL_REGION_EXIT()  }
+
+/* Single-shot timers are restarted from their timeout handlers, and many of them can expire in one
+ * interrupt. The operation queue is given its largest size. */
+#define APP_TIMER_CONFIG_OP_QUEUE_SIZE 254
+
+#include "sdk_common.h"
+#include "app_timer.h"
+
+/* The node size in app_timer.h is for 32-bit pointers. The benchmark gives each timer more room. */
+#undef  APP_TIMER_NODE_SIZE
+#define APP_TIMER_NODE_SIZE sizeof(timer_node_t)
+
+#ifndef APP_TIMER_SOURCE
+#define APP_TIMER_SOURCE "app_timer.c"
+#endif
+#include APP_TIMER_SOURCE
+
+#define TIMER_WORDS     32                              //!< Size of the storage of a timer, in words.
+#define TIMERS_MAX      1000                            //!< Maximum number of timers.
+#define TIMEOUT_MIN     APP_TIMER_TICKS(1)              //!< Shortest timeout.
+#define TIMEOUT_MAX     APP_TIMER_TICKS(1000)           //!< Longest timeout.
+#define SLACK_DIV       8                               //!< Slack of a timer, as a fraction of its timeout.
+#define CHURN_TICKS     APP_TIMER_TICKS(10)             //!< Interval between restarts from the main context.
+#define LATE_TICKS      2                               //!< Interrupt latency allowed after the slack.
+
+STATIC_ASSERT(sizeof(timer_node_t) <= TIMER_WORDS * sizeof(uint32_t));
+
+
+typedef struct
+{
+    bool     running;
+    bool     repeated;
+    uint64_t deadline;
+    uint32_t timeout;
+    uint32_t slack;
+} bench_timer_t;
+
+static uint32_t       m_timer_data[TIMERS_MAX][TIMER_WORDS];
+static app_timer_id_t m_timer_id[TIMERS_MAX];
+static bench_timer_t  m_timer[TIMERS_MAX];
+
+static uint64_t m_now;                          //!< Ticks since the start of the benchmark.
+static uint64_t m_cpu_ns;
+static uint32_t m_wakeups;
+static uint32_t m_expiries;
+static uint32_t m_api_calls;
+static uint32_t m_errors;
+static uint64_t m_late_sum;                     //!< Sum of expiry times after the timeout.
+static uint32_t m_late_max;
+
+
+static uint64_t clock_ns(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+
+static void error_report(uint32_t idx, char const * p_what)
+{
+    if (m_errors++ < 10)
+    {
+        printf("  timer %u %s at tick %llu (deadline %llu, slack %u)\n",
+               (unsigned)idx, p_what, (unsigned long long)m_now,
+               (unsigned long long)m_timer[idx].deadline, (unsigned)m_timer[idx].slack);
+    }
+}
+
+
+void app_error_handler_bare(ret_code_t error_code)
+{
+    printf("app_timer error %u at tick %llu\n", (unsigned)error_code, (unsigned long long)m_now);
+    exit(2);
+}
+
+
+/**@brief Function for running the pending interrupts, like the NVIC would. */
+static void irq_run(void)
+{
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        uint32_t const ready = m_irq_pending & m_irq_enabled;
+
+        rtc_apply();
+        if (ready == 0)
+        {
+            return;
+        }
+
+        uint64_t const start = clock_ns();
+        if (ready & (1UL << RTC1_IRQn))
+        {
+            NVIC_ClearPendingIRQ(RTC1_IRQn);
+            m_wakeups++;
+            RTC1_IRQHandler();
+        }
+        else
+        {
+            NVIC_ClearPendingIRQ(SWI_IRQn);
+            SWI_IRQHandler();
+        }
+        m_cpu_ns += clock_ns() - start;
+    }
+
+    printf("Interrupts are pending continuously at tick %llu\n", (unsigned long long)m_now);
+    exit(2);
+}
+
+
+static void timer_start(uint32_t idx)
+{
+    bench_timer_t * p_timer = &m_timer[idx];
+
+    p_timer->timeout  = TIMEOUT_MIN + (uint32_t)rand() % (TIMEOUT_MAX - TIMEOUT_MIN + 1);
+    p_timer->slack    = p_timer->timeout / SLACK_DIV;
+    p_timer->deadline = m_now + p_timer->timeout;
+    p_timer->running  = true;
+
+    ret_code_t const err_code = app_timer_start_with_slack(m_timer_id[idx],
+                                                           p_timer->timeout,
+                                                           p_timer->slack,
+                                                           (void *)(uintptr_t)idx);
+    m_api_calls++;
+
+    if (err_code != NRF_SUCCESS)
+    {
+        printf("app_timer_start_with_slack failed: %u\n", (unsigned)err_code);
+        exit(2);
+    }
+}
+
+
+static void timer_stop(uint32_t idx)
+{
+    ret_code_t const err_code = app_timer_stop(m_timer_id[idx]);
+    m_api_calls++;
+
+    if (err_code != NRF_SUCCESS)
+    {
+        printf("app_timer_stop failed: %u\n", (unsigned)err_code);
+        exit(2);
+    }
+    m_timer[idx].running = false;
+}
+
+
+static void timeout_handler(void * p_context)
+{
+    uint32_t const  idx     = (uint32_t)(uintptr_t)p_context;
+    bench_timer_t * p_timer = &m_timer[idx];
+
+    m_expiries++;
+    if (!p_timer->running)
+    {
+        error_report(idx, "expired while stopped");
+        return;
+    }
+    if (m_now < p_timer->deadline)
+    {
+        error_report(idx, "expired early");
+    }
+    else
+    {
+        uint32_t const late = (uint32_t)(m_now - p_timer->deadline);
+
+        if (late > p_timer->slack + LATE_TICKS)
+        {
+            error_report(idx, "expired late");
+        }
+        m_late_sum += late;
+        m_late_max  = MAX(m_late_max, late);
+    }
+
+    if (p_timer->repeated)
+    {
+        p_timer->deadline += p_timer->timeout;
+    }
+    else
+    {
+        timer_start(idx);
+    }
+}
+
+
+static void bench_run(uint32_t seconds, uint32_t timer_cnt, uint32_t seed)
+{
+    uint64_t const ticks = (uint64_t)seconds * APP_TIMER_TICKS(1000);
+
+    memset(&m_rtc, 0, sizeof(m_rtc));
+    memset(m_timer, 0, sizeof(m_timer));
+    m_rtc_running = false;
+    m_rtc_inten   = 0;
+    m_irq_enabled = 0;
+    m_irq_pending = 0;
+    m_now         = 0;
+    m_cpu_ns      = 0;
+    m_wakeups     = 0;
+    m_expiries    = 0;
+    m_api_calls   = 0;
+    m_errors      = 0;
+    m_late_sum    = 0;
+    m_late_max    = 0;
+    srand(seed);
+
+    APP_ERROR_CHECK(app_timer_init());
+    irq_run();
+
+    for (uint32_t i = 0; i < timer_cnt; i++)
+    {
+        m_timer[i].repeated = (i & 1);
+        m_timer_id[i]       = (app_timer_id_t)m_timer_data[i];
+        APP_ERROR_CHECK(app_timer_create(&m_timer_id[i],
+                                         m_timer[i].repeated ? APP_TIMER_MODE_REPEATED
+                                                             : APP_TIMER_MODE_SINGLE_SHOT,
+                                         timeout_handler));
+        timer_start(i);
+        irq_run();
+    }
+
+    // The CPU time of the setup is not part of the result.
+    m_cpu_ns    = 0;
+    m_api_calls = 0;
+    m_wakeups   = 0;
+    m_expiries  = 0;
+
+    for (m_now = 1; m_now <= ticks; m_now++)
+    {
+        if (m_rtc_running)
+        {
+            m_rtc.COUNTER = (m_rtc.COUNTER + 1) & MAX_RTC_COUNTER_VAL;
+            if (m_rtc.COUNTER == m_rtc.CC[0])
+            {
+                m_rtc.EVENTS_COMPARE[0] = 1;
+                if (m_rtc_inten & RTC_INTENSET_COMPARE0_Msk)
+                {
+                    NVIC_SetPendingIRQ(RTC1_IRQn);
+                }
+            }
+        }
+        irq_run();
+
+        if ((m_now % CHURN_TICKS) == 0)
+        {
+            uint32_t const idx   = (uint32_t)rand() % timer_cnt;
+            uint64_t const start = clock_ns();
+
+            timer_stop(idx);
+            timer_start(idx);
+            m_cpu_ns += clock_ns() - start;
+            irq_run();
+        }
+
+        for (uint32_t i = 0; ((m_now % 1024) == 0) && (i < timer_cnt); i++)
+        {
+            if (m_timer[i].running &&
+                (m_now > m_timer[i].deadline + m_timer[i].slack + LATE_TICKS))
+            {
+                error_report(i, "did not expire");
+                m_timer[i].running = false;
+            }
+        }
+    }
+
+    APP_ERROR_CHECK(app_timer_stop_all());
+    irq_run();
+
+    printf("%-24s %6u %8.2f %8.2f %8.3f %8.1f %8.1f %6u %6u\n",
+           APP_TIMER_SOURCE,
+           (unsigned)timer_cnt,
+           (double)m_cpu_ns / 1000.0 / seconds,
+           (double)m_wakeups / seconds,
+           (double)m_expiries / seconds,
+           (double)m_cpu_ns / MAX(m_expiries + m_api_calls, 1),
+           m_expiries ? (double)m_late_sum / m_expiries : 0.0,
+           (unsigned)m_late_max,
+           (unsigned)m_errors);
+}
+
+
+int main(int argc, char * argv[])
+{
+    uint32_t const seconds      = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 600;
+    uint32_t const timer_cnt    = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0;
+    uint32_t const seed         = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1;
+    uint32_t const counts[]     = {10, 100, 1000};
+    uint32_t       errors       = 0;
+
+    if ((seconds == 0) || (timer_cnt > TIMERS_MAX))
+    {
+        printf("usage: %s [seconds] [timers <= %u] [seed]\n", argv[0], TIMERS_MAX);
+        return 2;
+    }
+
+    printf("%-24s %6s %8s %8s %8s %8s %8s %6s %6s\n",
+           "implementation", "timers", "cpu us/s", "wakeup/s", "expiry/s",
+           "ns/event", "late avg", "late", "errors");
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(counts); i++)
+    {
+        bench_run(seconds, (timer_cnt != 0) ? timer_cnt : counts[i], seed);
+        errors += m_errors;
+        if (timer_cnt != 0)
+        {
+            break;
+        }
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
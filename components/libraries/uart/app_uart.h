@@ -97,7 +97,7 @@ typedef struct
  */
 typedef enum
 {
-    APP_UART_DATA_READY,          /**< An event indicating that UART data has been received. The data is available in the FIFO and can be fetched using @ref app_uart_get. */
+    APP_UART_DATA_READY,          /**< An event indicating that UART data has been received. The data is available in the FIFO and can be fetched using @ref app_uart_get or @ref app_uart_read. The number of bytes available is stored in app_uart_evt_t.data.rx_available field. With EasyDMA and APP_UART_RX_BUFFER_SIZE larger than 1, the event is not generated for every byte: it follows the first byte of a burst, every full RX buffer, and the end of a burst once the line has been idle for one to two APP_UART_RX_IDLE_TIMEOUT_MS periods. A single event can therefore report many bytes. */
     APP_UART_FIFO_ERROR,          /**< An error in the FIFO module used by the app_uart module has occured. The FIFO error code is stored in app_uart_evt_t.data.error_code field. */
     APP_UART_COMMUNICATION_ERROR, /**< An communication error has occured during reception. The error is stored in app_uart_evt_t.data.error_communication field. */
     APP_UART_TX_EMPTY,            /**< An event indicating that UART has completed transmission of all available data in the TX FIFO. */
@@ -117,6 +117,7 @@ typedef struct
         uint32_t error_communication; /**< Field used if evt_type is: APP_UART_COMMUNICATION_ERROR. This field contains the value in the ERRORSRC register for the UART peripheral. The UART_ERRORSRC_x defines from nrf5x_bitfields.h can be used to parse the error code. See also the \nRFXX Series Reference Manual for specification. */
         uint32_t error_code;          /**< Field used if evt_type is: NRF_ERROR_x. Additional status/error code if the error event type is APP_UART_FIFO_ERROR. This error code refer to errors defined in nrf_error.h. */
         uint8_t  value;               /**< Field used if evt_type is: NRF_ERROR_x. Additional status/error code if the error event type is APP_UART_FIFO_ERROR. This error code refer to errors defined in nrf_error.h. */
+        uint32_t rx_available;        /**< Field used if evt_type is: APP_UART_DATA_READY. Number of bytes available in the RX FIFO. */
     } data;
 } app_uart_evt_t;
 
@@ -222,6 +223,21 @@ uint32_t app_uart_init(const app_uart_comm_params_t * p_comm_params,
  */
 uint32_t app_uart_get(uint8_t * p_byte);
 
+/**@brief Function for getting a block of bytes from the UART (Only valid if FIFO is used).
+ *
+ * @details This function will get as many bytes from the RX buffer as are available, up to the
+ *          requested number, in one copy.
+ *
+ * @param[out]   p_data     Memory where the received bytes will be copied.
+ * @param[inout] p_length   Maximum number of bytes to read. Overwritten with the number of bytes
+ *                          that were read.
+ *
+ * @retval NRF_SUCCESS          If at least one byte has been copied.
+ * @retval NRF_ERROR_NULL       If a NULL parameter was passed.
+ * @retval NRF_ERROR_NOT_FOUND  If no byte is available in the RX buffer of the app_uart module.
+ */
+uint32_t app_uart_read(uint8_t * p_data, uint32_t * p_length);
+
 /**@brief Function for putting a byte on the UART.
  *
  * @details This call is non-blocking.
@@ -236,6 +252,25 @@ uint32_t app_uart_get(uint8_t * p_byte);
  */
 uint32_t app_uart_put(uint8_t byte);
 
+/**@brief Function for putting a block of bytes on the UART (Only valid if FIFO is used).
+ *
+ * @details This call is non-blocking. As many bytes as fit are copied to the TX buffer and the
+ *          largest contiguous part of the TX buffer is handed to the UART driver in a single
+ *          transfer. If only part of the data fits, the application should retry with the
+ *          remaining bytes after @ref APP_UART_TX_EMPTY has been received.
+ *
+ * @param[in]    p_data     Bytes to be transmitted on the UART.
+ * @param[inout] p_length   Number of bytes to write. Overwritten with the number of bytes that
+ *                          were put on the TX buffer.
+ *
+ * @retval NRF_SUCCESS        If at least one byte was put on the TX buffer. The number of bytes
+ *                            written might be less than requested.
+ * @retval NRF_ERROR_NULL     If a NULL parameter was passed.
+ * @retval NRF_ERROR_NO_MEM   If no space is available in the TX buffer.
+ * @retval NRF_ERROR_INTERNAL If UART driver reported error.
+ */
+uint32_t app_uart_write(uint8_t const * p_data, uint32_t * p_length);
+
 /**@brief Function for flushing the RX and TX buffers (Only valid if FIFO is used).
  *        This function does nothing if FIFO is not used.
  *
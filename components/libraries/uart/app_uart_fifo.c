@@ -44,6 +44,26 @@
 #include "nrf_drv_uart.h"
 #include "nrf_assert.h"
 
+#ifndef APP_UART_RX_BUFFER_SIZE
+#define APP_UART_RX_BUFFER_SIZE 1
+#endif
+
+#ifndef APP_UART_RX_IDLE_TIMEOUT_MS
+#define APP_UART_RX_IDLE_TIMEOUT_MS 1
+#endif
+
+#if (APP_UART_RX_BUFFER_SIZE < 1) || (APP_UART_RX_BUFFER_SIZE > UINT8_MAX)
+#error "APP_UART_RX_BUFFER_SIZE must be between 1 and 255."
+#endif
+
+// Multi-byte RX transfers need idle line detection, which relies on EasyDMA.
+#if (APP_UART_RX_BUFFER_SIZE > 1) && defined(UARTE_PRESENT)
+#define RX_IDLE_DETECTION 1
+#include "app_timer.h"
+#else
+#define RX_IDLE_DETECTION 0
+#endif
+
 static nrf_drv_uart_t app_uart_inst = NRF_DRV_UART_INSTANCE(APP_UART_DRIVER_INSTANCE);
 
 static __INLINE uint32_t fifo_length(app_fifo_t * const fifo)
@@ -54,71 +74,313 @@ static __INLINE uint32_t fifo_length(app_fifo_t * const fifo)
 
 #define FIFO_LENGTH(F) fifo_length(&F)              /**< Macro to calculate length of a FIFO. */
 
+#define TX_MAX_LENGTH  UINT8_MAX                    /**< Maximum number of bytes in one driver transfer. */
+
+
+/**@brief Received data that is waiting for space in the RX FIFO. */
+typedef struct
+{
+    uint8_t * p_buf;                                          /**< RX buffer holding the data. */
+    uint8_t   offset;                                         /**< First byte not yet moved to the RX FIFO. */
+    uint8_t   length;                                         /**< Number of bytes received into the buffer. */
+} rx_span_t;
 
 static app_uart_event_handler_t   m_event_handler;            /**< Event handler function. */
-static uint8_t tx_buffer[1];
-static uint8_t rx_buffer[1];
-static bool m_rx_ovf;
+static uint8_t m_rx_buf[2][APP_UART_RX_BUFFER_SIZE];          /**< RX buffers alternately handed to the driver. */
+static uint8_t m_rx_length;                                   /**< Length of each RX transfer. */
+static rx_span_t m_rx_held[2];                                /**< Completed RX buffers, in reception order, not yet moved to the RX FIFO. */
+static uint8_t m_rx_held_count;                               /**< Number of valid entries in m_rx_held. */
+static uint32_t m_tx_length;                                  /**< Number of TX FIFO bytes owned by the driver, 0 if idle. */
+
+#if RX_IDLE_DETECTION
+APP_TIMER_DEF(m_rx_idle_timer);                               /**< Timer used to detect an idle RX line. */
+static bool m_rx_idle_timer_active;                           /**< True while the idle timer is running. */
+static bool m_rx_idle_abort;                                  /**< True while a transfer is being ended because the line is idle. */
+static bool m_rx_wake;                                        /**< True if the next transfer started is a one byte transfer that reports the start of reception. */
+#endif
 
 static app_fifo_t                  m_rx_fifo;                               /**< RX FIFO buffer for storing data received on the UART until the application fetches them using app_uart_get(). */
 static app_fifo_t                  m_tx_fifo;                               /**< TX FIFO buffer for storing data to be transmitted on the UART when TXD is ready. Data is put to the buffer on using app_uart_put(). */
 
+/**@brief Start transmission of the largest contiguous span of the TX FIFO.
+ *
+ * @details The span is transmitted directly from the FIFO memory. It is released from the FIFO
+ *          only when the transfer is done, so it cannot be overwritten while in use.
+ *          Must be called with interrupts disabled and no transfer in progress.
+ */
+static uint32_t tx_start(void)
+{
+    uint8_t * p_data;
+    uint32_t  length;
+    uint32_t  err_code;
+
+    if (app_fifo_peek_span(&m_tx_fifo, &p_data, &length) != NRF_SUCCESS)
+    {
+        return NRF_SUCCESS;
+    }
+
+    length = MIN(length, TX_MAX_LENGTH);
+
+    m_tx_length = length;
+    err_code = nrf_drv_uart_tx(&app_uart_inst, p_data, (uint8_t)length);
+    if (err_code != NRF_SUCCESS)
+    {
+        m_tx_length = 0;
+        return NRF_ERROR_INTERNAL;
+    }
+    return NRF_SUCCESS;
+}
+
+
+/**@brief Start transmission unless the driver is already busy with the TX FIFO. */
+static uint32_t tx_kick(void)
+{
+    uint32_t err_code = NRF_SUCCESS;
+
+    CRITICAL_REGION_ENTER();
+    if (m_tx_length == 0)
+    {
+        err_code = tx_start();
+    }
+    CRITICAL_REGION_EXIT();
+
+    return err_code;
+}
+
+
+/**@brief Hand an RX buffer to the driver.
+ *
+ * @details While the line is idle, the first transfer is only one byte long. Its completion
+ *          reports the start of reception, which starts the idle timer, and the driver continues
+ *          in the other buffer without losing data.
+ */
+static uint32_t rx_buf_arm(uint8_t * p_buf)
+{
+    uint8_t length = m_rx_length;
+
+#if RX_IDLE_DETECTION
+    if (m_rx_idle_abort)
+    {
+        // Buffers are handed back in the RX done event that ends the transfer.
+        return NRF_SUCCESS;
+    }
+    if (m_rx_wake)
+    {
+        m_rx_wake = false;
+        length    = 1;
+    }
+#endif
+    return nrf_drv_uart_rx(&app_uart_inst, p_buf, length);
+}
+
+
+/**@brief Check if an RX buffer is waiting for space in the RX FIFO. */
+static bool rx_buf_is_held(uint8_t const * p_buf)
+{
+    for (uint32_t i = 0; i < m_rx_held_count; i++)
+    {
+        if (m_rx_held[i].p_buf == p_buf)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**@brief Hand every RX buffer that is not waiting for the RX FIFO to the driver.
+ *
+ * @details Used when the driver has dropped both buffers, i.e. after an error or an abort.
+ *          The driver uses the first buffer given and keeps the second one as the next buffer.
+ */
+static void rx_buffers_arm(void)
+{
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_rx_buf); i++)
+    {
+        if (!rx_buf_is_held(m_rx_buf[i]))
+        {
+            (void)rx_buf_arm(m_rx_buf[i]);
+        }
+    }
+}
+
+
+/**@brief Move completed RX buffers to the RX FIFO, in one copy each, and hand them back to the
+ *        driver.
+ *
+ * @details A buffer that does not fit in the RX FIFO stays held, and reception continues in the
+ *          other buffer. Held buffers are moved when the application reads from the RX FIFO.
+ *          Must be called from the UART interrupt or with interrupts disabled.
+ *
+ * @return Number of bytes moved to the RX FIFO.
+ */
+static uint32_t rx_held_release(void)
+{
+    uint32_t moved = 0;
+
+    while (m_rx_held_count > 0)
+    {
+        rx_span_t * p_span = &m_rx_held[0];
+        uint32_t    length = p_span->length - p_span->offset;
+
+        if ((length != 0) &&
+            (app_fifo_write(&m_rx_fifo, &p_span->p_buf[p_span->offset], &length) != NRF_SUCCESS))
+        {
+            length = 0;
+        }
+        p_span->offset += length;
+        moved          += length;
+
+        if (p_span->offset != p_span->length)
+        {
+            break;
+        }
+
+        (void)rx_buf_arm(p_span->p_buf);
+
+        m_rx_held[0] = m_rx_held[1];
+        m_rx_held_count--;
+    }
+
+    return moved;
+}
+
+
+#if RX_IDLE_DETECTION
+/**@brief Function for starting the idle timer for one check period.
+ *
+ * @details Earlier activity is discarded so that the period only sees new bytes.
+ *          Must be called from the UART interrupt or with interrupts disabled.
+ */
+static void rx_idle_timer_start(void)
+{
+    (void)nrf_drv_uart_rx_activity_check(&app_uart_inst);
+
+    if (app_timer_start(m_rx_idle_timer, APP_TIMER_TICKS(APP_UART_RX_IDLE_TIMEOUT_MS), NULL)
+        == NRF_SUCCESS)
+    {
+        m_rx_idle_timer_active = true;
+    }
+}
+
+
+/**@brief Function for ending a partially filled RX transfer once the line has been idle for a full
+ *        timer period.
+ *
+ * @details The timer only runs while data is being received. When the line is idle, it is
+ *          stopped and the next transfer is armed as a wake transfer, see @ref rx_buf_arm.
+ */
+static void rx_idle_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    CRITICAL_REGION_ENTER();
+    m_rx_idle_timer_active = false;
+
+    if (nrf_drv_uart_rx_activity_check(&app_uart_inst))
+    {
+        rx_idle_timer_start();
+    }
+    else if (m_rx_held_count < ARRAY_SIZE(m_rx_buf))
+    {
+        // The driver reports the partial buffer when the receiver has stopped, and both buffers
+        // are handed back in the RX done event. If the buffer has just been filled, reception
+        // continues and its RX done event starts the timer again.
+        if (nrf_drv_uart_rx_stop(&app_uart_inst) == NRF_SUCCESS)
+        {
+            m_rx_idle_abort = true;
+        }
+    }
+    else
+    {
+        // No transfer to end, both buffers are waiting for the RX FIFO. Reception restarts
+        // with a wake transfer when they are released.
+        m_rx_wake = true;
+    }
+    CRITICAL_REGION_EXIT();
+}
+#endif
+
+
 static void uart_event_handler(nrf_drv_uart_event_t * p_event, void* p_context)
 {
     app_uart_evt_t app_uart_event;
-    uint32_t err_code;
+    uint32_t       rx_count;
 
     switch (p_event->type)
     {
         case NRF_DRV_UART_EVT_RX_DONE:
-            // Write received byte to FIFO.
-            err_code = app_fifo_put(&m_rx_fifo, p_event->data.rxtx.p_data[0]);
-            if (err_code != NRF_SUCCESS)
+            ASSERT(m_rx_held_count < ARRAY_SIZE(m_rx_held));
+
+            // Queue the buffer behind any earlier ones to keep the byte order.
+            m_rx_held[m_rx_held_count].p_buf  = p_event->data.rxtx.p_data;
+            m_rx_held[m_rx_held_count].offset = 0;
+            m_rx_held[m_rx_held_count].length = p_event->data.rxtx.bytes;
+            m_rx_held_count++;
+
+#if RX_IDLE_DETECTION
+            if (m_rx_idle_abort)
             {
-                app_uart_event.evt_type          = APP_UART_FIFO_ERROR;
-                app_uart_event.data.error_code   = err_code;
-                m_event_handler(&app_uart_event);
+                // The driver has dropped the next buffer as well. The buffer may be full if it
+                // was filled while the receiver was stopping, it ends the transfer all the same.
+                uint8_t * p_next = (p_event->data.rxtx.p_data == m_rx_buf[0]) ? m_rx_buf[1] : m_rx_buf[0];
+
+                m_rx_idle_abort = false;
+                m_rx_wake       = true;
+                if (!rx_buf_is_held(p_next))
+                {
+                    (void)rx_buf_arm(p_next);
+                }
             }
-            // Notify that there are data available.
-            else if (FIFO_LENGTH(m_rx_fifo) != 0)
+            else if (!m_rx_idle_timer_active && (m_rx_length > 1))
             {
-                app_uart_event.evt_type = APP_UART_DATA_READY;
-                m_event_handler(&app_uart_event);
+                // A wake transfer or a full buffer completed, the line is active.
+                rx_idle_timer_start();
             }
+#endif
+            // On overflow in RX FIFO the buffer stays held and reception continues in the
+            // other buffer, if free.
+            rx_count = rx_held_release();
 
-            // Start new RX if size in buffer.
-            if (FIFO_LENGTH(m_rx_fifo) <= m_rx_fifo.buf_size_mask)
-            {
-                (void)nrf_drv_uart_rx(&app_uart_inst, rx_buffer, 1);
-            }
-            else
+            // Notify that there are data available.
+            if (rx_count != 0)
             {
-                // Overflow in RX FIFO.
-                m_rx_ovf = true;
+                app_uart_event.evt_type          = APP_UART_DATA_READY;
+                app_uart_event.data.rx_available = FIFO_LENGTH(m_rx_fifo);
+                m_event_handler(&app_uart_event);
             }
-
             break;
 
         case NRF_DRV_UART_EVT_ERROR:
             app_uart_event.evt_type                 = APP_UART_COMMUNICATION_ERROR;
             app_uart_event.data.error_communication = p_event->data.error.error_mask;
-            (void)nrf_drv_uart_rx(&app_uart_inst, rx_buffer, 1);
+#if RX_IDLE_DETECTION
+            m_rx_idle_abort = false;
+            m_rx_wake       = (m_rx_length > 1) && !m_rx_idle_timer_active;
+#endif
+            rx_buffers_arm();
             m_event_handler(&app_uart_event);
             break;
 
         case NRF_DRV_UART_EVT_TX_DONE:
-            // Get next byte from FIFO.
-            if (app_fifo_get(&m_tx_fifo, tx_buffer) == NRF_SUCCESS)
-            {
-                (void)nrf_drv_uart_tx(&app_uart_inst, tx_buffer, 1);
-            }
-            else
+        {
+            bool tx_empty;
+
+            // Release transmitted span and continue with the next one.
+            CRITICAL_REGION_ENTER();
+            (void)app_fifo_consume(&m_tx_fifo, p_event->data.rxtx.bytes);
+            m_tx_length = 0;
+            (void)tx_start();
+            tx_empty    = (m_tx_length == 0);
+            CRITICAL_REGION_EXIT();
+
+            if (tx_empty)
             {
                 // Last byte from FIFO transmitted, notify the application.
                 app_uart_event.evt_type = APP_UART_TX_EMPTY;
                 m_event_handler(&app_uart_event);
             }
-            break;
+        } break;
 
         default:
             break;
@@ -161,7 +423,12 @@ uint32_t app_uart_init(const app_uart_comm_params_t * p_comm_params,
 
     err_code = nrf_drv_uart_init(&app_uart_inst, &config, uart_event_handler);
     VERIFY_SUCCESS(err_code);
-    m_rx_ovf = false;
+    m_rx_held_count = 0;
+    m_tx_length     = 0;
+    m_rx_length     = 1;
+#if RX_IDLE_DETECTION
+    m_rx_wake       = false;
+#endif
 
     // Turn on receiver if RX pin is connected
     if (p_comm_params->rx_pin_no != UART_PIN_DISCONNECTED)
@@ -172,8 +439,27 @@ uint32_t app_uart_init(const app_uart_comm_params_t * p_comm_params,
         {
             nrf_drv_uart_rx_enable(&app_uart_inst);
         }
+#if RX_IDLE_DETECTION
+        else
+        {
+            m_rx_length            = APP_UART_RX_BUFFER_SIZE;
+            m_rx_idle_timer_active = false;
+            m_rx_idle_abort        = false;
+
+            err_code = app_timer_create(&m_rx_idle_timer,
+                                        APP_TIMER_MODE_SINGLE_SHOT,
+                                        rx_idle_timeout_handler);
+            VERIFY_SUCCESS(err_code);
+
+            // The line is idle, start with a wake transfer.
+            m_rx_wake = true;
+        }
+#endif
+
+        err_code = rx_buf_arm(m_rx_buf[0]);
+        VERIFY_SUCCESS(err_code);
 
-        return nrf_drv_uart_rx(&app_uart_inst, rx_buffer,1);
+        return rx_buf_arm(m_rx_buf[1]);
     }
     else
     {
@@ -199,18 +485,34 @@ uint32_t app_uart_flush(void)
 uint32_t app_uart_get(uint8_t * p_byte)
 {
     ASSERT(p_byte);
-    bool rx_ovf = m_rx_ovf;
 
     ret_code_t err_code =  app_fifo_get(&m_rx_fifo, p_byte);
 
-    // If FIFO was full new request to receive one byte was not scheduled. Must be done here.
-    if (rx_ovf)
+    // If FIFO was full received data is held back. Must be moved here.
+    if (m_rx_held_count != 0)
     {
-        m_rx_ovf = false;
-        uint32_t uart_err_code = nrf_drv_uart_rx(&app_uart_inst, rx_buffer, 1);
+        CRITICAL_REGION_ENTER();
+        (void)rx_held_release();
+        CRITICAL_REGION_EXIT();
+    }
+
+    return err_code;
+}
+
+
+uint32_t app_uart_read(uint8_t * p_data, uint32_t * p_length)
+{
+    VERIFY_PARAM_NOT_NULL(p_data);
+    VERIFY_PARAM_NOT_NULL(p_length);
 
-        // RX resume should never fail.
-        APP_ERROR_CHECK(uart_err_code);
+    ret_code_t err_code = app_fifo_read(&m_rx_fifo, p_data, p_length);
+
+    // If FIFO was full received data is held back. Must be moved here.
+    if (m_rx_held_count != 0)
+    {
+        CRITICAL_REGION_ENTER();
+        (void)rx_held_release();
+        CRITICAL_REGION_EXIT();
     }
 
     return err_code;
@@ -227,17 +529,22 @@ uint32_t app_uart_put(uint8_t byte)
         // (in 'uart_event_handler') when all preceding bytes are transmitted.
         // But if UART is not transmitting anything at the moment, we must start
         // a new transmission here.
-        if (!nrf_drv_uart_tx_in_progress(&app_uart_inst))
-        {
-            // This operation should be almost always successful, since we've
-            // just added a byte to FIFO, but if some bigger delay occurred
-            // (some heavy interrupt handler routine has been executed) since
-            // that time, FIFO might be empty already.
-            if (app_fifo_get(&m_tx_fifo, tx_buffer) == NRF_SUCCESS)
-            {
-                err_code = nrf_drv_uart_tx(&app_uart_inst, tx_buffer, 1);
-            }
-        }
+        err_code = tx_kick();
+    }
+    return err_code;
+}
+
+
+uint32_t app_uart_write(uint8_t const * p_data, uint32_t * p_length)
+{
+    uint32_t err_code;
+
+    VERIFY_PARAM_NOT_NULL(p_data);
+
+    err_code = app_fifo_write(&m_tx_fifo, p_data, p_length);
+    if (err_code == NRF_SUCCESS)
+    {
+        err_code = tx_kick();
     }
     return err_code;
 }
@@ -245,6 +552,12 @@ uint32_t app_uart_put(uint8_t byte)
 
 uint32_t app_uart_close(void)
 {
+#if RX_IDLE_DETECTION
+    if (m_rx_length > 1)
+    {
+        (void)app_timer_stop(m_rx_idle_timer);
+    }
+#endif
     nrf_drv_uart_uninit(&app_uart_inst);
     return NRF_SUCCESS;
 }
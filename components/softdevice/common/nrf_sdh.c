@@ -375,7 +375,9 @@ static void appsh_events_poll(void * p_event_data, uint16_t event_size)
 
 void SD_EVT_IRQHandler(void)
 {
-    ret_code_t ret_code = app_sched_event_put(NULL, 0, appsh_events_poll);
+    // SoftDevice events are polled ahead of any other scheduled event.
+    ret_code_t ret_code = app_sched_event_put_prio(NULL, 0, appsh_events_poll,
+                                                   APP_SCHED_PRIORITY_HIGHEST);
     APP_ERROR_CHECK(ret_code);
 }
 
@@ -63,6 +63,7 @@
 #include "app_timer.h"
 #include "ble_nus.h"
 #include "app_uart.h"
+#include "app_fifo.h"
 #include "app_util_platform.h"
 #include "bsp_btn_ble.h"
 
@@ -93,13 +94,76 @@
 
 #define DEAD_BEEF                       0xDEADBEEF                                  /**< Value used as error code on stack dump, can be used to identify stack location on stack unwind. */
 
-#define UART_TX_BUF_SIZE                256                                         /**< UART TX buffer size. */
+#define UART_TX_BUF_SIZE                1024                                        /**< UART TX buffer size. */
 #define UART_RX_BUF_SIZE                256                                         /**< UART RX buffer size. */
 
+#define DOWNLINK_BUF_SIZE               256                                         /**< NUS to UART pending buffer size, must be a power of two. */
+
+#define UPLINK_QUEUE_SIZE               8                                           /**< Number of MTU sized chunks buffered between UART and NUS. */
+#define UPLINK_IDLE_TIMEOUT             APP_TIMER_TICKS(2)                          /**< UART inter-byte idle time after which a partial chunk is sent (2 ms). */
+#define UPLINK_IDLE_TIMEOUT_MIN         (APP_TIMER_MIN_TIMEOUT_TICKS + 4)           /**< Shortest re-arm of the idle timer, in ticks. */
+
 
 BLE_NUS_DEF(m_nus);                                                                 /**< BLE NUS service instance. */
 NRF_BLE_GATT_DEF(m_gatt);                                                           /**< GATT module instance. */
 BLE_ADVERTISING_DEF(m_advertising);                                                 /**< Advertising module instance. */
+APP_TIMER_DEF(m_uplink_timer);                                                      /**< UART idle timer used to flush partial uplink chunks. */
+
+/**@brief UART to NUS uplink chunk. */
+typedef struct
+{
+    uint16_t length;                                                                /**< Number of valid bytes in the chunk. */
+    uint8_t  data[BLE_NUS_MAX_DATA_LEN];                                            /**< Chunk payload. */
+} uplink_chunk_t;
+
+/**@brief UART to NUS uplink statistics. */
+typedef struct
+{
+    uint32_t bytes;                                                                 /**< Bytes handed to the SoftDevice. */
+    uint32_t packets;                                                               /**< Notifications handed to the SoftDevice. */
+    uint32_t stalls;                                                                /**< Times the SoftDevice ran out of TX buffers. */
+    uint32_t dropped;                                                               /**< Chunks discarded because no peer was subscribed. */
+    uint8_t  queue_max;                                                             /**< High-water mark of committed chunks. */
+} uplink_stats_t;
+
+/**@brief UART to NUS uplink state.
+ *
+ * @details Chunks are filled at index @p wr_idx. A chunk is committed by advancing @p wr_idx
+ *          and sent (and freed) from @p rd_idx. All fields are only modified by
+ *          @ref uplink_process, which serializes itself between interrupt contexts.
+ */
+typedef struct
+{
+    uplink_chunk_t    chunks[UPLINK_QUEUE_SIZE];                                    /**< Chunk ring buffer. */
+    uint8_t           rd_idx;                                                       /**< Oldest committed chunk. */
+    uint8_t           wr_idx;                                                       /**< Chunk being filled from UART. */
+    uint32_t          last_rx_ticks;                                                /**< RTC tick of the last received byte. */
+    bool              timer_armed;                                                  /**< True while the idle timer is running. */
+    volatile bool     busy;                                                         /**< True while @ref uplink_process is executing. */
+    volatile bool     pending;                                                      /**< Set when another run of @ref uplink_process was requested. */
+    volatile bool     reset_request;                                                /**< Set to discard all buffered data on the next run. */
+    uplink_stats_t    stats;                                                        /**< Uplink counters. */
+} uplink_t;
+
+static uplink_t m_uplink;                                                           /**< UART to NUS uplink instance. */
+
+/**@brief NUS to UART downlink state.
+ *
+ * @details Holds data that did not fit in the UART TX FIFO. It is written out when the UART
+ *          reports @ref APP_UART_TX_EMPTY. The pending FIFO is only written from the BLE event
+ *          context and only read with interrupts disabled, so filling it needs no locking.
+ */
+typedef struct
+{
+    app_fifo_t        pending;                                                      /**< Bytes waiting for space in the UART TX FIFO. */
+    uint8_t           pending_buf[DOWNLINK_BUF_SIZE];                               /**< Storage of the pending FIFO. */
+    uint32_t          bytes;                                                        /**< Bytes received from the peer. */
+    uint32_t          dropped;                                                      /**< Bytes discarded because the pending buffer was full. */
+} downlink_t;
+
+STATIC_ASSERT(DOWNLINK_BUF_SIZE > BLE_NUS_MAX_DATA_LEN);
+
+static downlink_t m_downlink;                                                       /**< NUS to UART downlink instance. */
 
 static uint16_t   m_conn_handle          = BLE_CONN_HANDLE_INVALID;                 /**< Handle of the current connection. */
 static uint16_t   m_ble_nus_max_data_len = BLE_GATT_ATT_MTU_DEFAULT - 3;            /**< Maximum length of data (in bytes) that can be transmitted to the peer by the Nordic UART service module. */
@@ -156,6 +220,341 @@ static void gap_params_init(void)
 }
 
 
+/**@brief Function for getting the number of committed uplink chunks. */
+static uint8_t uplink_queue_count(void)
+{
+    return (uint8_t)((m_uplink.wr_idx + UPLINK_QUEUE_SIZE - m_uplink.rd_idx) % UPLINK_QUEUE_SIZE);
+}
+
+
+/**@brief Function for committing the chunk currently being filled.
+ *
+ * @retval true  Chunk committed.
+ * @retval false Chunk is empty or there is no free chunk to continue filling.
+ */
+static bool uplink_chunk_commit(void)
+{
+    uint8_t next = (m_uplink.wr_idx + 1) % UPLINK_QUEUE_SIZE;
+
+    if ((m_uplink.chunks[m_uplink.wr_idx].length == 0) || (next == m_uplink.rd_idx))
+    {
+        return false;
+    }
+
+    m_uplink.wr_idx = next;
+    m_uplink.chunks[next].length = 0;
+
+    uint8_t count = uplink_queue_count();
+    if (count > m_uplink.stats.queue_max)
+    {
+        m_uplink.stats.queue_max = count;
+    }
+    return true;
+}
+
+
+/**@brief Function for moving received UART bytes into the open uplink chunk.
+ *
+ * @details Bytes stay in the app_uart FIFO when all chunks are in use; they are picked up again
+ *          once the SoftDevice has released TX buffers.
+ */
+static void uplink_rx_drain(void)
+{
+    for (;;)
+    {
+        uplink_chunk_t * p_chunk = &m_uplink.chunks[m_uplink.wr_idx];
+
+        if (p_chunk->length >= m_ble_nus_max_data_len)
+        {
+            if (!uplink_chunk_commit())
+            {
+                return;
+            }
+            continue;
+        }
+
+        uint32_t length = m_ble_nus_max_data_len - p_chunk->length;
+
+        if (app_uart_read(&p_chunk->data[p_chunk->length], &length) != NRF_SUCCESS)
+        {
+            return;
+        }
+        p_chunk->length       += length;
+        m_uplink.last_rx_ticks = app_timer_cnt_get();
+    }
+}
+
+
+/**@brief Function for committing a partial chunk once the UART line has been idle long enough,
+ *        or for (re)arming the idle timer otherwise.
+ */
+static void uplink_idle_check(void)
+{
+    uint32_t elapsed;
+    uint32_t err_code;
+
+    if ((m_uplink.chunks[m_uplink.wr_idx].length == 0) || m_uplink.timer_armed)
+    {
+        return;
+    }
+
+    elapsed = app_timer_cnt_diff_compute(app_timer_cnt_get(), m_uplink.last_rx_ticks);
+    if ((elapsed >= UPLINK_IDLE_TIMEOUT) && uplink_chunk_commit())
+    {
+        return;
+    }
+
+    // Either the line is still active or the queue is full. In the latter case the chunk is
+    // committed from the TX complete path.
+    elapsed = (elapsed < UPLINK_IDLE_TIMEOUT) ? (UPLINK_IDLE_TIMEOUT - elapsed) : UPLINK_IDLE_TIMEOUT;
+    elapsed = MAX(elapsed, UPLINK_IDLE_TIMEOUT_MIN);
+
+    err_code = app_timer_start(m_uplink_timer, elapsed, NULL);
+    APP_ERROR_CHECK(err_code);
+    m_uplink.timer_armed = true;
+}
+
+
+/**@brief Function for queuing committed chunks as notifications until the SoftDevice runs out of
+ *        TX buffers.
+ */
+static void uplink_tx_pump(void)
+{
+    uint32_t err_code;
+
+    while (m_uplink.rd_idx != m_uplink.wr_idx)
+    {
+        uplink_chunk_t * p_chunk = &m_uplink.chunks[m_uplink.rd_idx];
+        uint16_t         length  = p_chunk->length;
+
+        err_code = ble_nus_string_send(&m_nus, p_chunk->data, &length);
+        if (err_code == NRF_SUCCESS)
+        {
+            m_uplink.stats.bytes += length;
+            m_uplink.stats.packets++;
+        }
+        else if ((err_code == NRF_ERROR_RESOURCES) || (err_code == NRF_ERROR_BUSY))
+        {
+            // Resumed on BLE_GATTS_EVT_HVN_TX_COMPLETE.
+            m_uplink.stats.stalls++;
+            return;
+        }
+        else if (err_code == NRF_ERROR_INVALID_STATE)
+        {
+            m_uplink.stats.dropped++;
+        }
+        else
+        {
+            APP_ERROR_CHECK(err_code);
+        }
+
+        m_uplink.rd_idx = (m_uplink.rd_idx + 1) % UPLINK_QUEUE_SIZE;
+    }
+}
+
+
+/**@brief Function for running the uplink pipeline.
+ *
+ * @details Called from the UART, idle timer and BLE event handlers. When called while another
+ *          context is already running the pipeline, the request is recorded and the running
+ *          instance makes another pass instead, so that no context ever waits for another.
+ */
+static void uplink_process(void)
+{
+    bool run;
+
+    CRITICAL_REGION_ENTER();
+    run              = !m_uplink.busy;
+    m_uplink.busy    = true;
+    m_uplink.pending = true;
+    CRITICAL_REGION_EXIT();
+
+    if (!run)
+    {
+        return;
+    }
+
+    do
+    {
+        m_uplink.pending = false;
+
+        if (m_uplink.reset_request)
+        {
+            m_uplink.reset_request                  = false;
+            m_uplink.rd_idx                         = m_uplink.wr_idx;
+            m_uplink.chunks[m_uplink.wr_idx].length = 0;
+        }
+
+        uplink_rx_drain();
+        uplink_tx_pump();
+
+        // Sending may have freed a chunk for data still waiting in the UART FIFO.
+        uplink_rx_drain();
+        uplink_idle_check();
+
+        CRITICAL_REGION_ENTER();
+        if (!m_uplink.pending)
+        {
+            m_uplink.busy = false;
+        }
+        CRITICAL_REGION_EXIT();
+    } while (m_uplink.busy);
+}
+
+
+/**@brief Function for handling the uplink idle timer timeout.
+ *
+ * @param[in] p_context Unused.
+ */
+static void uplink_timeout_handler(void * p_context)
+{
+    UNUSED_PARAMETER(p_context);
+
+    m_uplink.timer_armed = false;
+    uplink_process();
+}
+
+
+/**@brief Function for discarding all buffered uplink data and logging and clearing the uplink
+ *        statistics, e.g. on disconnection. */
+static void uplink_reset(void)
+{
+    m_uplink.reset_request = true;
+    uplink_process();
+
+    NRF_LOG_INFO("Uplink: %u bytes, %u packets, %u stalls, %u dropped, queue max %u",
+                 m_uplink.stats.bytes,
+                 m_uplink.stats.packets,
+                 m_uplink.stats.stalls,
+                 m_uplink.stats.dropped,
+                 m_uplink.stats.queue_max);
+
+    CRITICAL_REGION_ENTER();
+    memset(&m_uplink.stats, 0, sizeof(m_uplink.stats));
+    CRITICAL_REGION_EXIT();
+}
+
+
+/**@brief Function for initializing the UART to NUS uplink. */
+static void uplink_init(void)
+{
+    uint32_t err_code;
+
+    memset(&m_uplink, 0, sizeof(m_uplink));
+
+    err_code = app_timer_create(&m_uplink_timer, APP_TIMER_MODE_SINGLE_SHOT, uplink_timeout_handler);
+    APP_ERROR_CHECK(err_code);
+}
+
+
+/**@brief Function for writing pending downlink data to the UART TX FIFO.
+ *
+ * @note Must be called with interrupts disabled.
+ */
+static void downlink_flush(void)
+{
+    uint8_t * p_data;
+    uint32_t  length;
+    uint32_t  written;
+    uint32_t  err_code;
+
+    // The pending data may wrap around the end of the buffer, in which case it takes two writes.
+    while (app_fifo_peek_span(&m_downlink.pending, &p_data, &length) == NRF_SUCCESS)
+    {
+        written  = length;
+        err_code = app_uart_write(p_data, &written);
+        if (err_code == NRF_ERROR_NO_MEM)
+        {
+            break;
+        }
+        APP_ERROR_CHECK(err_code);
+
+        err_code = app_fifo_consume(&m_downlink.pending, written);
+        APP_ERROR_CHECK(err_code);
+
+        if (written < length)
+        {
+            break;
+        }
+    }
+}
+
+
+/**@brief Function for queuing downlink data on the UART without blocking.
+ *
+ * @details Data is written straight to the UART TX FIFO. Whatever does not fit is kept in the
+ *          pending buffer until the UART has drained its FIFO. The peer writes without
+ *          response, so there is no way to hold it off; data that does not fit in the pending
+ *          buffer either is dropped and counted, see @ref downlink_stats_log.
+ *
+ * @param[in] p_data   Data to be sent to UART module.
+ * @param[in] length   Length of the data.
+ */
+static void downlink_write(uint8_t const * p_data, uint16_t length)
+{
+    uint8_t * p_pending;
+    uint32_t  written = 0;
+    uint32_t  count;
+    uint32_t  err_code;
+
+    m_downlink.bytes += length;
+
+    CRITICAL_REGION_ENTER();
+
+    downlink_flush();
+
+    if (app_fifo_peek_span(&m_downlink.pending, &p_pending, &count) == NRF_ERROR_NOT_FOUND)
+    {
+        written  = length;
+        err_code = app_uart_write(p_data, &written);
+        if (err_code == NRF_ERROR_NO_MEM)
+        {
+            written = 0;
+        }
+        else
+        {
+            APP_ERROR_CHECK(err_code);
+        }
+    }
+
+    CRITICAL_REGION_EXIT();
+
+    if (written < length)
+    {
+        count = length - written;
+        (void)app_fifo_write(&m_downlink.pending, &p_data[written], &count);
+        m_downlink.dropped += length - written - count;
+
+        // The UART may have drained while the data was copied.
+        CRITICAL_REGION_ENTER();
+        downlink_flush();
+        CRITICAL_REGION_EXIT();
+    }
+}
+
+
+/**@brief Function for logging and clearing the downlink statistics, e.g. on disconnection. */
+static void downlink_stats_log(void)
+{
+    NRF_LOG_INFO("Downlink: %u bytes, %u dropped", m_downlink.bytes, m_downlink.dropped);
+
+    m_downlink.bytes   = 0;
+    m_downlink.dropped = 0;
+}
+
+
+/**@brief Function for initializing the NUS to UART downlink. */
+static void downlink_init(void)
+{
+    uint32_t err_code;
+
+    memset(&m_downlink, 0, sizeof(m_downlink));
+
+    err_code = app_fifo_init(&m_downlink.pending, m_downlink.pending_buf, sizeof(m_downlink.pending_buf));
+    APP_ERROR_CHECK(err_code);
+}
+
+
 /**@brief Function for handling the data from the Nordic UART Service.
  *
  * @details This function will process the data received from the Nordic UART BLE Service and send
@@ -171,26 +570,14 @@ static void nus_data_handler(ble_nus_evt_t * p_evt)
 
     if (p_evt->type == BLE_NUS_EVT_RX_DATA)
     {
-        uint32_t err_code;
-
         NRF_LOG_DEBUG("Received data from BLE NUS. Writing data on UART.");
         NRF_LOG_HEXDUMP_DEBUG(p_evt->params.rx_data.p_data, p_evt->params.rx_data.length);
 
-        for (uint32_t i = 0; i < p_evt->params.rx_data.length; i++)
-        {
-            do
-            {
-                err_code = app_uart_put(p_evt->params.rx_data.p_data[i]);
-                if ((err_code != NRF_SUCCESS) && (err_code != NRF_ERROR_BUSY))
-                {
-                    NRF_LOG_ERROR("Failed receiving NUS message. Error 0x%x. ", err_code);
-                    APP_ERROR_CHECK(err_code);
-                }
-            } while (err_code == NRF_ERROR_BUSY);
-        }
+        downlink_write(p_evt->params.rx_data.p_data, p_evt->params.rx_data.length);
+
         if (p_evt->params.rx_data.p_data[p_evt->params.rx_data.length-1] == '\r')
         {
-            while (app_uart_put('\n') == NRF_ERROR_BUSY);
+            downlink_write((uint8_t const *)"\n", 1);
         }
     }
 
@@ -337,6 +724,12 @@ static void ble_evt_handler(ble_evt_t const * p_ble_evt, void * p_context)
             err_code = bsp_indication_set(BSP_INDICATE_IDLE);
             APP_ERROR_CHECK(err_code);
             m_conn_handle = BLE_CONN_HANDLE_INVALID;
+            uplink_reset();
+            downlink_stats_log();
+            break;
+
+        case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+            uplink_process();
             break;
 
 #if defined(S132)
@@ -523,40 +916,18 @@ void bsp_event_handler(bsp_event_t event)
 
 /**@brief   Function for handling app_uart events.
  *
- * @details This function will receive a single character from the app_uart module and append it to
- *          a string. The string will be be sent over BLE when the last character received was a
- *          'new line' '\n' (hex 0x0A) or if the string has reached the maximum data length.
+ * @details Received characters are collected into chunks of the maximum data length. A chunk is
+ *          sent over BLE when it is full or when the UART line has been idle for
+ *          @ref UPLINK_IDLE_TIMEOUT. As many chunks are queued as the SoftDevice accepts; the rest
+ *          are sent when @ref BLE_GATTS_EVT_HVN_TX_COMPLETE reports free TX buffers.
  */
 /**@snippet [Handling the data received over UART] */
 void uart_event_handle(app_uart_evt_t * p_event)
 {
-    static uint8_t data_array[BLE_NUS_MAX_DATA_LEN];
-    static uint8_t index = 0;
-    uint32_t       err_code;
-
     switch (p_event->evt_type)
     {
         case APP_UART_DATA_READY:
-            UNUSED_VARIABLE(app_uart_get(&data_array[index]));
-            index++;
-
-            if ((data_array[index - 1] == '\n') || (index >= (m_ble_nus_max_data_len)))
-            {
-                NRF_LOG_DEBUG("Ready to send data over BLE NUS");
-                NRF_LOG_HEXDUMP_DEBUG(data_array, index);
-
-                do
-                {
-                    uint16_t length = (uint16_t)index;
-                    err_code = ble_nus_string_send(&m_nus, data_array, &length);
-                    if ( (err_code != NRF_ERROR_INVALID_STATE) && (err_code != NRF_ERROR_BUSY) )
-                    {
-                        APP_ERROR_CHECK(err_code);
-                    }
-                } while (err_code == NRF_ERROR_BUSY);
-
-                index = 0;
-            }
+            uplink_process();
             break;
 
         case APP_UART_COMMUNICATION_ERROR:
@@ -567,6 +938,12 @@ void uart_event_handle(app_uart_evt_t * p_event)
             APP_ERROR_HANDLER(p_event->data.error_code);
             break;
 
+        case APP_UART_TX_EMPTY:
+            CRITICAL_REGION_ENTER();
+            downlink_flush();
+            CRITICAL_REGION_EXIT();
+            break;
+
         default:
             break;
     }
@@ -680,6 +1057,8 @@ int main(void)
     err_code = app_timer_init();
     APP_ERROR_CHECK(err_code);
 
+    uplink_init();
+    downlink_init();
     uart_init();
     log_init();
 
@@ -2060,6 +2060,14 @@
 #define APP_SCHEDULER_WITH_PROFILER 0
 #endif
 
+// <o> APP_SCHEDULER_PRIORITY_LEVELS - Number of event priority levels  <1-4> 
+// <i> Events of a higher priority are executed before any pending event of a lower priority.
+// <i> Events scheduled with app_sched_event_put() get the lowest priority.
+
+#ifndef APP_SCHEDULER_PRIORITY_LEVELS
+#define APP_SCHEDULER_PRIORITY_LEVELS 2
+#endif
+
 // </e>
 
 // <e> APP_TIMER_ENABLED - app_timer - Application timer functionality
@@ -2162,6 +2170,24 @@
 #define APP_UART_DRIVER_INSTANCE 0
 #endif
 
+// <o> APP_UART_RX_BUFFER_SIZE - Size of each of the two RX transfer buffers <1-255> 
+// <i> With 1, every received byte is a separate transfer. Larger values
+// <i> require EasyDMA; a partially filled buffer is then handed over
+// <i> once the line has been idle for APP_UART_RX_IDLE_TIMEOUT_MS.
+
+#ifndef APP_UART_RX_BUFFER_SIZE
+#define APP_UART_RX_BUFFER_SIZE 64
+#endif
+
+// <o> APP_UART_RX_IDLE_TIMEOUT_MS - RX idle line check period in milliseconds <1-1000> 
+// <i> Uses a single-shot app_timer that only runs while data is being
+// <i> received. A partially filled RX buffer is handed over after
+// <i> between one and two periods without received data.
+
+#ifndef APP_UART_RX_IDLE_TIMEOUT_MS
+#define APP_UART_RX_IDLE_TIMEOUT_MS 1
+#endif
+
 // </e>
 
 // <q> APP_USBD_CLASS_AUDIO_ENABLED  - app_usbd_audio - USB AUDIO class
@@ -2220,19 +2246,43 @@
 #define BUTTON_ENABLED 1
 #endif
 
-// <q> CRC16_ENABLED  - crc16 - CRC16 calculation routines
- 
-
+// <e> CRC16_ENABLED - crc16 - CRC16 calculation routines
+//==========================================================
 #ifndef CRC16_ENABLED
 #define CRC16_ENABLED 0
 #endif
-
-// <q> CRC32_ENABLED  - crc32 - CRC32 calculation routines
+// <o> CRC16_CONFIG_METHOD  - Computation method
  
+// <i> Trades flash used by lookup tables for speed.
+// <0=> Shift and XOR (no table) 
+// <1=> Nibble table (32 bytes) 
+// <2=> Byte table (512 bytes) 
 
+#ifndef CRC16_CONFIG_METHOD
+#define CRC16_CONFIG_METHOD 2
+#endif
+
+// </e>
+
+// <e> CRC32_ENABLED - crc32 - CRC32 calculation routines
+//==========================================================
 #ifndef CRC32_ENABLED
 #define CRC32_ENABLED 0
 #endif
+// <o> CRC32_CONFIG_METHOD  - Computation method
+ 
+// <i> Trades flash used by lookup tables for speed.
+// <0=> Bitwise (no table) 
+// <1=> Nibble table (64 bytes) 
+// <2=> Byte table (1 kB) 
+// <3=> Slicing-by-4 (4 kB) 
+// <4=> Slicing-by-8 (8 kB) 
+
+#ifndef CRC32_CONFIG_METHOD
+#define CRC32_CONFIG_METHOD 2
+#endif
+
+// </e>
 
 // <q> ECC_ENABLED  - ecc - Elliptic Curve Cryptography Library
  
@@ -2284,8 +2334,10 @@
 
 // <i> NRF_FSTORAGE_SD uses the nrf_fstorage_sd backend implementation using the SoftDevice API. Use this if you have a SoftDevice present.
 // <i> NRF_FSTORAGE_NVMC uses the nrf_fstorage_nvmc implementation. Use this setting if you don't use the SoftDevice.
+// <i> NRF_FSTORAGE_RAM uses the nrf_fstorage_ram implementation, which emulates flash in RAM. Use this setting for testing and profiling.
 // <1=> NRF_FSTORAGE_NVMC 
 // <2=> NRF_FSTORAGE_SD 
+// <3=> NRF_FSTORAGE_RAM 
 
 #ifndef FDS_BACKEND
 #define FDS_BACKEND 2
@@ -2307,6 +2359,61 @@
 // </h> 
 //==========================================================
 
+// <h> Index - RAM index settings
+
+//==========================================================
+// <o> FDS_INDEX_SIZE - Number of records in the RAM index. 
+// <i> The index maps file IDs and record keys to records in flash, so that
+// <i> fds_record_find() and related functions do not have to scan every page.
+// <i> Each entry uses 8 bytes of RAM. If the number of valid records exceeds this value,
+// <i> FDS falls back to scanning flash until the index can be rebuilt after garbage collection.
+// <i> Set to 0 to disable the index.
+
+#ifndef FDS_INDEX_SIZE
+#define FDS_INDEX_SIZE 64
+#endif
+
+// </h> 
+//==========================================================
+
+// <h> GC - Garbage collection settings
+
+//==========================================================
+// <o> FDS_GC_SLICE_OPS - Flash operations per garbage collection slice. 
+// <i> Garbage collection lets queued write operations run after this many flash operations
+// <i> (record copies, page erases and page tag writes). Other operations run between pages.
+// <i> Set to 0 to run garbage collection to completion once started.
+
+#ifndef FDS_GC_SLICE_OPS
+#define FDS_GC_SLICE_OPS 4
+#endif
+
+// <o> FDS_GC_AUTO_DIRTY_PERCENT - Dirty flash percentage which triggers garbage collection. <0-100> 
+// <i> Garbage collection is queued after a delete or update operation if deleted records
+// <i> take at least this percentage of the flash used by FDS. Set to 0 to disable.
+
+#ifndef FDS_GC_AUTO_DIRTY_PERCENT
+#define FDS_GC_AUTO_DIRTY_PERCENT 0
+#endif
+
+// </h> 
+//==========================================================
+
+// <h> Batch - Atomic multi-record writes
+
+//==========================================================
+// <o> FDS_BATCH_MAX_RECORDS - Maximum number of records written by fds_batch_write(). 
+// <i> Records in a batch are written back to back on one page and committed together,
+// <i> so that either all or none of them are found after a reset.
+// <i> Each record uses 36 bytes of RAM. Set to 0 to disable batches.
+
+#ifndef FDS_BATCH_MAX_RECORDS
+#define FDS_BATCH_MAX_RECORDS 8
+#endif
+
+// </h> 
+//==========================================================
+
 // <h> CRC - CRC functionality
 
 //==========================================================
@@ -2639,6 +2746,13 @@
 
 // </e>
 
+// <q> NRF_SLAB_ENABLED  - nrf_slab - Size-class slab allocator built on nrf_balloc
+ 
+
+#ifndef NRF_SLAB_ENABLED
+#define NRF_SLAB_ENABLED 0
+#endif
+
 // <e> NRF_CSENSE_ENABLED - nrf_csense - Capacitive sensor module
 //==========================================================
 #ifndef NRF_CSENSE_ENABLED
@@ -2754,9 +2868,58 @@
 #define NRF_FSTORAGE_SD_MAX_WRITE_SIZE 4096
 #endif
 
+// <o> NRF_FSTORAGE_SD_COALESCE_SIZE - Maximum number of bytes of queued writes to merge into a single operation.
+// <i> Writes which are queued one after the other and continue each other in flash are executed by a single flash operation,
+// <i> as long as their total length does not exceed this value. Set to zero to disable.
+// <i> This value must be a multiple of four and must not exceed NRF_FSTORAGE_SD_MAX_WRITE_SIZE.
+// <i> A buffer of this size is allocated in RAM. Keep the value small, so that the merged operation fits in the SoftDevice timeslots.
+
+#ifndef NRF_FSTORAGE_SD_COALESCE_SIZE
+#define NRF_FSTORAGE_SD_COALESCE_SIZE 256
+#endif
+
 // </h> 
 //==========================================================
 
+// <e> NRF_FSTORAGE_RAM_ENABLED - nrf_fstorage_ram - Implementation emulating flash in RAM.
+
+// <i> Emulates flash in a RAM buffer, with a configurable timing model and statistics.
+// <i> Useful to measure the flash usage of modules such as FDS without hardware.
+//==========================================================
+#ifndef NRF_FSTORAGE_RAM_ENABLED
+#define NRF_FSTORAGE_RAM_ENABLED 0
+#endif
+// <o> NRF_FSTORAGE_RAM_SIZE - Size of the emulated flash, in bytes. 
+// <i> This value must be a multiple of the flash page size.
+
+#ifndef NRF_FSTORAGE_RAM_SIZE
+#define NRF_FSTORAGE_RAM_SIZE 16384
+#endif
+
+// <o> NRF_FSTORAGE_RAM_QUEUE_SIZE - Size of the internal queue of operations. 
+#ifndef NRF_FSTORAGE_RAM_QUEUE_SIZE
+#define NRF_FSTORAGE_RAM_QUEUE_SIZE 4
+#endif
+
+// <o> NRF_FSTORAGE_RAM_MAX_WRITE_SIZE - Maximum number of bytes written in a single flash access. 
+// <i> This value must be a multiple of four.
+
+#ifndef NRF_FSTORAGE_RAM_MAX_WRITE_SIZE
+#define NRF_FSTORAGE_RAM_MAX_WRITE_SIZE 4096
+#endif
+
+// <o> NRF_FSTORAGE_RAM_WRITE_TIME_US - Time to write one word, in microseconds. 
+#ifndef NRF_FSTORAGE_RAM_WRITE_TIME_US
+#define NRF_FSTORAGE_RAM_WRITE_TIME_US 41
+#endif
+
+// <o> NRF_FSTORAGE_RAM_ERASE_TIME_US - Time to erase one page, in microseconds. 
+#ifndef NRF_FSTORAGE_RAM_ERASE_TIME_US
+#define NRF_FSTORAGE_RAM_ERASE_TIME_US 85000
+#endif
+
+// </e>
+
 // </e>
 
 // <q> NRF_MEMOBJ_ENABLED  - nrf_memobj - Linked memory allocator module
@@ -2971,6 +3134,16 @@
 #define NRF_CLI_LOG_BACKEND 1
 #endif
 
+// <q> NRF_CLI_RPC_ENABLED  - Enable binary RPC mode for test tools.
+ 
+
+// <i> Adds the rpc command and nrf_cli_rpc_start(). In RPC mode commands are sent in
+// <i> length-prefixed frames and their output and status are returned in frames.
+
+#ifndef NRF_CLI_RPC_ENABLED
+#define NRF_CLI_RPC_ENABLED 0
+#endif
+
 // <q> NRF_CLI_USES_TASK_MANAGER_ENABLED  - Enable CLI to use task_manager
  
 
@@ -3002,6 +3175,26 @@
 #define NRF_LOG_BACKEND_RTT_TEMP_BUFFER_SIZE 64
 #endif
 
+// <o> NRF_LOG_BACKEND_RTT_BLOCK_SIZE - Size of block collecting output of multiple logs. 
+// <i> Processed logs are copied to the block which is written to RTT
+// <i> at once when it is full or when all buffered logs were processed.
+// <i> Larger block reduces number of RTT writes at the cost of RAM.
+
+#ifndef NRF_LOG_BACKEND_RTT_BLOCK_SIZE
+#define NRF_LOG_BACKEND_RTT_BLOCK_SIZE 256
+#endif
+
+// <q> NRF_LOG_BACKEND_RTT_SKIP_IF_FULL  - Drop block if RTT buffer is full
+ 
+
+// <i> If enabled, output which does not fit in the RTT buffer is dropped
+// <i> immediately instead of retrying. Dropped output is counted in
+// <i> the backend statistics.
+
+#ifndef NRF_LOG_BACKEND_RTT_SKIP_IF_FULL
+#define NRF_LOG_BACKEND_RTT_SKIP_IF_FULL 0
+#endif
+
 // </e>
 
 // <h> nrf_log - Logging
@@ -3125,6 +3318,17 @@
 #define NRF_LOG_USES_TIMESTAMP 0
 #endif
 
+// <q> NRF_LOG_BACKEND_SERIAL_BINARY  - Send unformatted log entries over serial backends.
+
+
+// <i> Entries are sent as SLIP frames instead of text and must be decoded on the host
+// <i> with the application ELF file (see experimental_log/tools/nrf_log_decode.py).
+// <i> String arguments must be constant or pushed with NRF_LOG_PUSH.
+
+#ifndef NRF_LOG_BACKEND_SERIAL_BINARY
+#define NRF_LOG_BACKEND_SERIAL_BINARY 0
+#endif
+
 // <q> NRF_LOG_FILTERS_ENABLED  - Enable dynamic filtering of logs.
  
 
@@ -3132,6 +3336,22 @@
 #define NRF_LOG_FILTERS_ENABLED 0
 #endif
 
+// <e> NRF_LOG_RATE_LIMIT_ENABLED - Enable per-module rate limiting of logs.
+
+// <i> Limits are set with nrf_log_module_rate_limit_set or the 'log rate' command.
+// <i> Suppressed and dropped entries are counted per module and reported with a summary entry.
+// <i> Requires the timestamp function passed to NRF_LOG_INIT, also if NRF_LOG_USES_TIMESTAMP is disabled.
+//==========================================================
+#ifndef NRF_LOG_RATE_LIMIT_ENABLED
+#define NRF_LOG_RATE_LIMIT_ENABLED 0
+#endif
+// <o> NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ - Frequency of the timestamp (in Hz).
+#ifndef NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ
+#define NRF_LOG_RATE_LIMIT_TIMESTAMP_FREQ 32768
+#endif
+
+// </e>
+
 // <q> NRF_LOG_CLI_CMDS  - Enable CLI commands for the module.
  
 
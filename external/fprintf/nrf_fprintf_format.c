@@ -69,6 +69,9 @@
 #define NRF_CLI_FORMAT_FLAG_PAD_ZERO       (1u << 1)
 #define NRF_CLI_FORMAT_FLAG_PRINT_SIGN     (1u << 2)
 
+/* Maximum number of digits of a 32-bit value printed in base 10 or 16. */
+#define NRF_CLI_FORMAT_DIGITS_MAX          10u
+
 static void buffer_add(nrf_fprintf_ctx_t * const p_ctx, char c)
 {
     p_ctx->p_io_buffer[p_ctx->io_buffer_cnt++] = c;
@@ -79,156 +82,179 @@ static void buffer_add(nrf_fprintf_ctx_t * const p_ctx, char c)
     }
 }
 
-static void string_print(nrf_fprintf_ctx_t * const p_ctx,
-                         char const *              p_str,
-                         uint32_t                  FieldWidth,
-                         uint32_t                  FormatFlags)
+/* Appends a span of characters. Buffer is flushed at the same positions as if characters were
+ * added one by one. */
+static void buffer_add_n(nrf_fprintf_ctx_t * const p_ctx, char const * p_src, size_t len)
 {
-    uint32_t Width = 0;
-    char c;
-
-    if ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY)
+    while (len > 0)
     {
-        while ((c = *p_str) != '\0')
+        size_t chunk = p_ctx->io_buffer_size - p_ctx->io_buffer_cnt;
+        if (chunk > len)
         {
-            p_str++;
-            Width++;
-            buffer_add(p_ctx, c);
+            chunk = len;
         }
+        memcpy(&p_ctx->p_io_buffer[p_ctx->io_buffer_cnt], p_src, chunk);
+        p_ctx->io_buffer_cnt += chunk;
+        p_src += chunk;
+        len   -= chunk;
 
-        while ((FieldWidth > Width) && (FieldWidth > 0))
+        if (p_ctx->io_buffer_cnt >= p_ctx->io_buffer_size)
         {
-            FieldWidth--;
-            buffer_add(p_ctx, ' ');
+            nrf_fprintf_buffer_flush(p_ctx);
         }
     }
-    else
+}
+
+static void buffer_fill(nrf_fprintf_ctx_t * const p_ctx, char c, size_t len)
+{
+    while (len > 0)
     {
-        if (p_str != 0)
+        size_t chunk = p_ctx->io_buffer_size - p_ctx->io_buffer_cnt;
+        if (chunk > len)
         {
-            Width = strlen(p_str);
+            chunk = len;
         }
+        memset(&p_ctx->p_io_buffer[p_ctx->io_buffer_cnt], c, chunk);
+        p_ctx->io_buffer_cnt += chunk;
+        len -= chunk;
 
-        while ((FieldWidth > Width) && (FieldWidth > 0))
+        if (p_ctx->io_buffer_cnt >= p_ctx->io_buffer_size)
         {
-            FieldWidth--;
-            buffer_add(p_ctx, ' ');
+            nrf_fprintf_buffer_flush(p_ctx);
         }
+    }
+}
 
-        while ((c = *p_str) != '\0')
-        {
-            p_str++;
-            Width++;
-            buffer_add(p_ctx, c);
-        }
+static void string_print(nrf_fprintf_ctx_t * const p_ctx,
+                         char const *              p_str,
+                         uint32_t                  FieldWidth,
+                         uint32_t                  FormatFlags)
+{
+    uint32_t Width = strlen(p_str);
+    uint32_t Pad   = (FieldWidth > Width) ? (FieldWidth - Width) : 0u;
+
+    if ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY)
+    {
+        buffer_add_n(p_ctx, p_str, Width);
+        buffer_fill(p_ctx, ' ', Pad);
+    }
+    else
+    {
+        buffer_fill(p_ctx, ' ', Pad);
+        buffer_add_n(p_ctx, p_str, Width);
     }
 }
 
-static void unsigned_print(nrf_fprintf_ctx_t * const p_ctx,
-                           uint32_t                  v,
-                           uint32_t                  Base,
-                           uint32_t                  NumDigits,
-                           uint32_t                  FieldWidth,
-                           uint32_t                  FormatFlags)
+/**
+ * @brief Function for converting a value to digits.
+ *
+ * Digits are written backwards, ending at p_end. Base 16 is converted with shifts. Base 10 is
+ * converted two digits at a time, division by a constant is compiled to a reciprocal multiply.
+ *
+ * @return Pointer to the most significant digit.
+ */
+static char * digits_get(char * p_end, uint32_t v, uint32_t Base)
 {
     static const char _aV2C[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
                                    'A', 'B', 'C', 'D', 'E', 'F' };
-    uint32_t Div;
-    uint32_t Value;
-    uint32_t Width;
-    char c;
+    static const char _aDec2[200] = {
+        '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+        '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+        '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+        '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+        '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+        '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+        '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+        '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+        '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+        '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9' };
+    char * p = p_end;
 
-    Value = v;
-    //
-    // Get actual field width
-    //
-    Width = 1u;
-    while (Value >= Base)
+    if (Base == 16u)
+    {
+        do
+        {
+            *--p = _aV2C[v & 0xFu];
+            v >>= 4;
+        } while (v);
+        return p;
+    }
+
+    ASSERT(Base == 10u);
+    while (v >= 100u)
     {
-        Value = (Value / Base);
-        Width++;
+        uint32_t idx = (v % 100u) * 2u;
+        v /= 100u;
+        p -= 2;
+        p[0] = _aDec2[idx];
+        p[1] = _aDec2[idx + 1];
     }
-    if (NumDigits > Width)
+    if (v >= 10u)
     {
-        Width = NumDigits;
+        p -= 2;
+        p[0] = _aDec2[v * 2u];
+        p[1] = _aDec2[v * 2u + 1];
     }
+    else
+    {
+        *--p = (char)('0' + v);
+    }
+    return p;
+}
+
+static void digits_print(nrf_fprintf_ctx_t * const p_ctx,
+                         char const *              p_digits,
+                         uint32_t                  Len,
+                         uint32_t                  NumDigits,
+                         uint32_t                  FieldWidth,
+                         uint32_t                  FormatFlags)
+{
+    uint32_t Width = (NumDigits > Len) ? NumDigits : Len;
+    uint32_t Pad   = (FieldWidth > Width) ? (FieldWidth - Width) : 0u;
+
     //
     // Print leading chars if necessary
     //
     if ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == 0u)
     {
-        if (FieldWidth != 0u)
-        {
-            if (((FormatFlags & NRF_CLI_FORMAT_FLAG_PAD_ZERO) == NRF_CLI_FORMAT_FLAG_PAD_ZERO) &&
-                (NumDigits == 0u))
-            {
-                c = '0';
-            }
-            else
-            {
-                c = ' ';
-            }
-            while ((FieldWidth != 0u) && (Width < FieldWidth))
-            {
-                FieldWidth--;
-                buffer_add(p_ctx, c);
-            }
-        }
-    }
-
-    Value = 1;
-    /*
-     * Compute Digit.
-     * Loop until Digit has the value of the highest digit required.
-     * Example: If the output is 345 (Base 10), loop 2 times until Digit is 100.
-     */
-    while (1)
-    {
-        /* User specified a min number of digits to print? => Make sure we loop at least that
-         * often, before checking anything else (> 1 check avoids problems with NumDigits
-         * being signed / unsigned)
-         */
-        if (NumDigits > 1u)
+        if (((FormatFlags & NRF_CLI_FORMAT_FLAG_PAD_ZERO) == NRF_CLI_FORMAT_FLAG_PAD_ZERO) &&
+            (NumDigits == 0u))
         {
-            NumDigits--;
+            buffer_fill(p_ctx, '0', Pad);
         }
         else
         {
-            Div = v / Value;
-            // Is our divider big enough to extract the highest digit from value? => Done
-            if (Div < Base)
-            {
-                break;
-            }
+            buffer_fill(p_ctx, ' ', Pad);
         }
-        Value *= Base;
     }
     //
-    // Output digits
+    // Output digits, zero extended to the requested precision
     //
-    do
-    {
-        Div = v / Value;
-        v -= Div * Value;
-        buffer_add(p_ctx, _aV2C[Div]);
-        Value /= Base;
-    } while (Value);
+    buffer_fill(p_ctx, '0', Width - Len);
+    buffer_add_n(p_ctx, p_digits, Len);
     //
     // Print trailing spaces if necessary
     //
     if ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY)
     {
-        if (FieldWidth != 0u)
-        {
-            while ((FieldWidth != 0u) && (Width < FieldWidth))
-            {
-                FieldWidth--;
-                buffer_add(p_ctx, ' ');
-            }
-        }
+        buffer_fill(p_ctx, ' ', Pad);
     }
 }
 
+static void unsigned_print(nrf_fprintf_ctx_t * const p_ctx,
+                           uint32_t                  v,
+                           uint32_t                  Base,
+                           uint32_t                  NumDigits,
+                           uint32_t                  FieldWidth,
+                           uint32_t                  FormatFlags)
+{
+    char   digits[NRF_CLI_FORMAT_DIGITS_MAX];
+    char * p_end = &digits[NRF_CLI_FORMAT_DIGITS_MAX];
+    char * p     = digits_get(p_end, v, Base);
+
+    digits_print(p_ctx, p, (uint32_t)(p_end - p), NumDigits, FieldWidth, FormatFlags);
+}
+
 static void int_print(nrf_fprintf_ctx_t * const p_ctx,
                       int32_t                   v,
                       uint32_t                  Base,
@@ -236,24 +262,17 @@ static void int_print(nrf_fprintf_ctx_t * const p_ctx,
                       uint32_t                  FieldWidth,
                       uint32_t                  FormatFlags)
 {
+    char     digits[NRF_CLI_FORMAT_DIGITS_MAX];
+    char *   p_end  = &digits[NRF_CLI_FORMAT_DIGITS_MAX];
+    uint32_t Number = (v < 0) ? (0u - (uint32_t)v) : (uint32_t)v;
+    char *   p      = digits_get(p_end, Number, Base);
+    uint32_t Len    = (uint32_t)(p_end - p);
     uint32_t Width;
-    int32_t Number;
-
-    Number = (v < 0) ? -v : v;
 
     //
     // Get actual field width
     //
-    Width = 1u;
-    while (Number >= (int32_t)Base)
-    {
-        Number = (Number / (int32_t)Base);
-        Width++;
-    }
-    if (NumDigits > Width)
-    {
-        Width = NumDigits;
-    }
+    Width = (NumDigits > Len) ? NumDigits : Len;
     if ((FieldWidth > 0u) && ((v < 0) ||
         ((FormatFlags & NRF_CLI_FORMAT_FLAG_PRINT_SIGN) == NRF_CLI_FORMAT_FLAG_PRINT_SIGN)))
     {
@@ -265,13 +284,10 @@ static void int_print(nrf_fprintf_ctx_t * const p_ctx,
     if ((((FormatFlags & NRF_CLI_FORMAT_FLAG_PAD_ZERO) == 0u) || (NumDigits != 0u)) &&
         ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == 0u))
     {
-        if (FieldWidth != 0u)
+        if (Width < FieldWidth)
         {
-            while ((FieldWidth != 0u) && (Width < FieldWidth))
-            {
-                FieldWidth--;
-                buffer_add(p_ctx, ' ');
-            }
+            buffer_fill(p_ctx, ' ', FieldWidth - Width);
+            FieldWidth = Width;
         }
     }
     //
@@ -279,7 +295,6 @@ static void int_print(nrf_fprintf_ctx_t * const p_ctx,
     //
     if (v < 0)
     {
-        v = -v;
         buffer_add(p_ctx, '-');
     }
     else if ((FormatFlags & NRF_CLI_FORMAT_FLAG_PRINT_SIGN) == NRF_CLI_FORMAT_FLAG_PRINT_SIGN)
@@ -296,19 +311,16 @@ static void int_print(nrf_fprintf_ctx_t * const p_ctx,
     if (((FormatFlags & NRF_CLI_FORMAT_FLAG_PAD_ZERO) == NRF_CLI_FORMAT_FLAG_PAD_ZERO) &&
         ((FormatFlags & NRF_CLI_FORMAT_FLAG_LEFT_JUSTIFY) == 0u) && (NumDigits == 0u))
     {
-        if (FieldWidth != 0u)
+        if (Width < FieldWidth)
         {
-            while ((FieldWidth != 0u) && (Width < FieldWidth))
-            {
-                FieldWidth--;
-                buffer_add(p_ctx, '0');
-            }
+            buffer_fill(p_ctx, '0', FieldWidth - Width);
+            FieldWidth = Width;
         }
     }
     //
     // Print number without sign
     //
-    unsigned_print(p_ctx, (uint32_t)v, Base, NumDigits, FieldWidth, FormatFlags);
+    digits_print(p_ctx, p, Len, NumDigits, FieldWidth, FormatFlags);
 }
 
 void nrf_fprintf_fmt(nrf_fprintf_ctx_t * const p_ctx,
@@ -496,7 +508,15 @@ void nrf_fprintf_fmt(nrf_fprintf_ctx_t * const p_ctx,
         }
         else
         {
-            buffer_add(p_ctx, c);
+            //
+            // Copy the whole run of literal characters
+            //
+            char const * p_start = p_fmt - 1;
+            while ((*p_fmt != '\0') && (*p_fmt != '%'))
+            {
+                p_fmt++;
+            }
+            buffer_add_n(p_ctx, p_start, (size_t)(p_fmt - p_start));
         }
     } while (*p_fmt != '\0');
 
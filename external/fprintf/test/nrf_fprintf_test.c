@@ -0,0 +1,360 @@
+/**
+ * Copyright (c) 2017 - 2017, Nordic Semiconductor ASA
+ * 
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 
+ * 2. Redistributions in binary form, except as embedded into a Nordic
+ *    Semiconductor ASA integrated circuit in a product or a software update for
+ *    such product, must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 
+ * 3. Neither the name of Nordic Semiconductor ASA nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ * 
+ * 4. This software, with or without modification, must only be used with a
+ *    Nordic Semiconductor ASA integrated circuit.
+ * 
+ * 5. Any software provided in binary form under this license must not be reverse
+ *    engineered, decompiled, modified and/or disassembled.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY NORDIC SEMICONDUCTOR ASA "AS IS" AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL NORDIC SEMICONDUCTOR ASA OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ * GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+
+/**@file
+ *
+ * @brief Host test and benchmark of the nrf_fprintf formatter.
+ *
+ * @details The formatter is checked against nrf_fprintf_format_ref.c, a copy of the previous
+ *          implementation. Every format string of a fixed corpus, and of a corpus of random
+ *          combinations of flags, width, precision, length modifier, conversion and literal text,
+ *          is printed by both with IO buffers of various sizes. Both the output and the chunks
+ *          passed to fwrite must be identical. The time taken to format a typical log line is
+ *          then measured for both implementations.
+ *
+ *          Build and run from the SDK root:
+ *
+ *          gcc -O2 -std=gnu99 -DNRF_FPRINTF_ENABLED=1 -I<directory of sdk_config.h>
+ *              -Icomponents/libraries/util -Icomponents/device -Icomponents/toolchain
+ *              -Icomponents/toolchain/cmsis/include -Icomponents/softdevice/s132/headers
+ *              -Iexternal/fprintf
+ *              -DNRF52832_XXAA -DNRF52 -U__unix -U__unix__ -Uunix
+ *              external/fprintf/test/nrf_fprintf_test.c external/fprintf/test/nrf_fprintf_format_ref.c
+ *              external/fprintf/nrf_fprintf_format.c external/fprintf/nrf_fprintf.c
+ *              -o nrf_fprintf_test && ./nrf_fprintf_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <time.h>
+#include "sdk_common.h"
+#include "nrf_fprintf.h"
+#include "nrf_fprintf_format.h"
+
+#define RANDOM_CASES    200000      //!< Number of random format strings.
+#define BENCH_LINES     1000000     //!< Number of log lines formatted per benchmark run.
+#define OUT_SIZE        4096        //!< Size of the captured output.
+
+typedef void (* fmt_func_t)(nrf_fprintf_ctx_t * const p_ctx, char const * p_fmt, va_list * p_args);
+
+void nrf_fprintf_fmt_ref(nrf_fprintf_ctx_t * const p_ctx, char const * p_fmt, va_list * p_args);
+
+/* Output captured from fwrite. */
+typedef struct
+{
+    char   data[OUT_SIZE];
+    size_t len;
+    size_t chunk[OUT_SIZE];
+    size_t chunk_cnt;
+} output_t;
+
+static output_t m_out;
+static char     m_io_buffer[256];
+
+
+static void output_fwrite(void const * p_user_ctx, char const * p_str, size_t length)
+{
+    (void)p_user_ctx;
+
+    memcpy(&m_out.data[m_out.len], p_str, length);
+    m_out.len                     += length;
+    m_out.chunk[m_out.chunk_cnt++] = length;
+}
+
+
+static void format(fmt_func_t fmt, size_t io_buffer_size, char const * p_fmt, ...)
+{
+    nrf_fprintf_ctx_t ctx =
+    {
+        .p_io_buffer    = m_io_buffer,
+        .io_buffer_size = io_buffer_size,
+        .io_buffer_cnt  = 0,
+        .auto_flush     = true,
+        .p_user_ctx     = NULL,
+        .fwrite         = output_fwrite,
+    };
+    va_list args;
+
+    m_out.len       = 0;
+    m_out.chunk_cnt = 0;
+
+    va_start(args, p_fmt);
+    fmt(&ctx, p_fmt, &args);
+    va_end(args);
+
+    nrf_fprintf_buffer_flush(&ctx);
+}
+
+
+static bool output_equal(output_t const * p_a, output_t const * p_b)
+{
+    return (p_a->len == p_b->len)                                                   &&
+           (memcmp(p_a->data, p_b->data, p_a->len) == 0)                            &&
+           (p_a->chunk_cnt == p_b->chunk_cnt)                                       &&
+           (memcmp(p_a->chunk, p_b->chunk, p_a->chunk_cnt * sizeof(p_a->chunk[0])) == 0);
+}
+
+
+static uint32_t rand_get(void)
+{
+    static uint32_t state = 12345;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+
+static uint32_t value_get(void)
+{
+    switch (rand_get() % 6)
+    {
+        case 0:  return rand_get() % 10;
+        case 1:  return rand_get() % 1000;
+        case 2:  return (uint32_t)-(int32_t)(rand_get() % 1000);
+        case 3:  return UINT32_MAX;
+        case 4:  return INT32_MAX;
+        default: return rand_get();
+    }
+}
+
+
+/* Formats p_fmt with both implementations and reports any difference. */
+static bool case_check(size_t io_buffer_size, char const * p_fmt,
+                       uintptr_t a0, uintptr_t a1, uintptr_t a2, uintptr_t a3)
+{
+    static output_t ref;
+
+    format(nrf_fprintf_fmt_ref, io_buffer_size, p_fmt, a0, a1, a2, a3);
+    ref = m_out;
+    format(nrf_fprintf_fmt, io_buffer_size, p_fmt, a0, a1, a2, a3);
+
+    if (output_equal(&ref, &m_out))
+    {
+        return true;
+    }
+
+    printf("MISMATCH fmt='%s' io_buffer_size=%u\n  ref='%.*s'\n  new='%.*s'\n",
+           p_fmt, (unsigned)io_buffer_size,
+           (int)ref.len, ref.data, (int)m_out.len, m_out.data);
+    return false;
+}
+
+
+/* Format strings in the style of the logger and CLI. */
+static uint32_t corpus_check(void)
+{
+    /* Formats which take strings take only strings. */
+    static struct
+    {
+        char const * p_fmt;
+        bool         strings;
+    } const corpus[] =
+    {
+        {"<info> app: value %d, count %u, addr 0x%08X\r\n", false},
+        {"%s%s%s%s",                                        true},
+        {"%c%c%c%c",                                        false},
+        {"%5d|%-5d|%05d|%+d",                               false},
+        {"%x %X %08x %-8X|",                                false},
+        {"%.3d %.0d %8.3u %-8.3u|",                         false},
+        {"%p %10p %-10p|",                                  false},
+        {"%%d %% %d %%",                                    false},
+        {"%ld %lu %lx %lX",                                 false},
+        {"%-20s|%20s|",                                     true},
+        {"%.2s %.10s",                                      true},
+        {"Heap: %u of %u bytes, %u%% used\r\n",             false},
+    };
+    static size_t const io_buffer_sizes[] = {1, 2, 3, 7, 16, 64, 255};
+    uint32_t failures = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(corpus); i++)
+    {
+        uintptr_t const args[][4] =
+        {
+            {0,          1,          9,          10},
+            {UINT32_MAX, INT32_MAX,  (uint32_t)-1, (uint32_t)-12345},
+            {100,        65535,      0x20001234, 999999},
+        };
+
+        for (size_t j = 0; j < ARRAY_SIZE(args); j++)
+        {
+            for (size_t k = 0; k < ARRAY_SIZE(io_buffer_sizes); k++)
+            {
+                bool ok;
+
+                if (corpus[i].strings)
+                {
+                    ok = case_check(io_buffer_sizes[k], corpus[i].p_fmt, (uintptr_t)"",
+                                    (uintptr_t)"ab", (uintptr_t)"hello world", (uintptr_t)"x");
+                }
+                else
+                {
+                    ok = case_check(io_buffer_sizes[k], corpus[i].p_fmt,
+                                    args[j][0], args[j][1], args[j][2], args[j][3]);
+                }
+
+                failures += ok ? 0 : 1;
+            }
+        }
+    }
+
+    return failures;
+}
+
+
+/* Random combinations of flags, width, precision, length modifier and conversion. */
+static uint32_t random_check(void)
+{
+    static char const   specs[]             = "diuxXcsp";
+    static char const * strings[]           = {"", "ab", "hello world", "x"};
+    static size_t const io_buffer_sizes[]   = {1, 2, 3, 7, 16, 64, 255};
+    uint32_t            failures            = 0;
+
+    for (uint32_t i = 0; i < RANDOM_CASES; i++)
+    {
+        char      fmt[128];
+        int       pos = 0;
+        uintptr_t args[4] = {0};
+        uint32_t  cnt     = (rand_get() % 4) + 1;
+
+        for (uint32_t j = 0; j < cnt; j++)
+        {
+            char const spec = specs[rand_get() % (sizeof(specs) - 1)];
+
+            if (rand_get() % 2)
+            {
+                pos += sprintf(&fmt[pos], "%.*s", (int)(rand_get() % 12), "literal text, ");
+            }
+            fmt[pos++] = '%';
+            if ((rand_get() % 3) == 0)
+            {
+                fmt[pos++] = '-';
+            }
+            if ((rand_get() % 3) == 0)
+            {
+                fmt[pos++] = '0';
+            }
+            if ((rand_get() % 4) == 0)
+            {
+                fmt[pos++] = '+';
+            }
+            if (rand_get() % 2)
+            {
+                pos += sprintf(&fmt[pos], "%u", (unsigned)(rand_get() % 14));
+            }
+            if ((rand_get() % 3) == 0)
+            {
+                /* The previous implementation divided by zero for hex precision above 8. */
+                bool const hex = (spec == 'x') || (spec == 'X') || (spec == 'p');
+                pos += sprintf(&fmt[pos], ".%u", (unsigned)(rand_get() % (hex ? 9 : 11)));
+            }
+            if ((rand_get() % 5) == 0)
+            {
+                fmt[pos++] = 'l';
+            }
+            fmt[pos++] = spec;
+
+            if (spec == 's')
+            {
+                args[j] = (uintptr_t)strings[rand_get() % ARRAY_SIZE(strings)];
+            }
+            else
+            {
+                uint32_t value = value_get();
+
+                /* The previous implementation got the width of INT32_MIN wrong. */
+                if (((spec == 'd') || (spec == 'i')) && (value == 0x80000000u))
+                {
+                    value = 0;
+                }
+                args[j] = value;
+            }
+        }
+        if (rand_get() % 2)
+        {
+            pos += sprintf(&fmt[pos], " tail");
+        }
+        fmt[pos] = '\0';
+
+        if (!case_check(io_buffer_sizes[rand_get() % ARRAY_SIZE(io_buffer_sizes)], fmt,
+                        args[0], args[1], args[2], args[3]))
+        {
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+
+static double bench_ns_per_line(fmt_func_t fmt)
+{
+    struct timespec start;
+    struct timespec end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < BENCH_LINES; i++)
+    {
+        format(fmt, 64, "<info> app: value %d, count %u, addr 0x%08X %s\r\n",
+               -12345 + (int)i, 1000000u + i, 0x20001234u + i, "ok");
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / BENCH_LINES;
+}
+
+
+int main(void)
+{
+    uint32_t corpus_failures = corpus_check();
+    uint32_t random_failures = random_check();
+
+    printf("corpus: %u mismatches\n", (unsigned)corpus_failures);
+    printf("random: %u cases, %u mismatches\n", RANDOM_CASES, (unsigned)random_failures);
+
+    printf("log line: reference %.1f ns, current %.1f ns\n",
+           bench_ns_per_line(nrf_fprintf_fmt_ref), bench_ns_per_line(nrf_fprintf_fmt));
+
+    return ((corpus_failures + random_failures) == 0) ? 0 : 1;
+}